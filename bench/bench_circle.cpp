@@ -0,0 +1,83 @@
+// Benchmark: table and rotation circle tessellation vs. the cos/sin loops.
+//
+//   g++ -O2 bench/bench_circle.cpp -o bench_circle
+//   ./bench_circle [--check] [circles] [repetitions]
+#include "../gfx/circle.h"
+#include "bench_util.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// -----------------------------------------------------------------
+// Reference: the per-vertex loop used by drawBall, drawFan, etc.
+// -----------------------------------------------------------------
+void tessellateCircleTrig(float cx, float cy, float r, int segments, Point* out) {
+    for (int i = 0; i < segments; i++) {
+        float theta = 2.0f * M_PI * i / segments;
+        out[i] = { (float)(cx + r * cos(theta)), (float)(cy + r * sin(theta)) };
+    }
+}
+
+struct Circle { float cx, cy, r; };
+
+// Time one tessellator over every circle and compare it with the reference.
+template <class F>
+void run(const char* name, const std::vector<Circle>& circles, int segments, int reps,
+    F tessellate, double baseline, std::vector<Point>& out, const std::vector<Point>& expect) {
+    int n = (int)circles.size();
+    double s = bestSeconds(reps, [&]() {
+        for (int k = 0; k < n; k++)
+            tessellate(circles[k].cx, circles[k].cy, circles[k].r, segments, &out[k * segments]);
+    });
+    int mismatches = 0;
+    float maxError = 0;
+    for (size_t i = 0; i < out.size(); i++) {
+        float e = std::max(std::fabs(out[i].x - expect[i].x), std::fabs(out[i].y - expect[i].y));
+        if (e != 0) mismatches++;
+        maxError = std::max(maxError, e);
+    }
+    benchCheck(maxError <= 1e-3f, "%s, %d segments: vertices off by up to %.2g", name, segments,
+        maxError);
+    long vertices = (long)n * segments;
+    printf("  %-18s %7.2f ns/vertex %8.1f Mvert/s  x%-6.2f", name, s * 1e9 / vertices,
+        vertices / s / 1e6, baseline > 0 ? baseline / s : 1.0);
+    if (mismatches)
+        printf(" %d vertices differ, max %.2g", mismatches, maxError);
+    else
+        printf(" identical");
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    int count = benchArg(argc, argv, 1, 20000, 200);
+    int reps = benchArg(argc, argv, 2, 20, 1);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> pos(0.0f, 500.0f), rad(5.0f, 120.0f);
+    std::vector<Circle> circles(count);
+    for (Circle& c : circles)
+        c = { pos(rng), pos(rng), rad(rng) };
+    printf("%d circles, best of %d runs\n", count, reps);
+
+    const int counts[] = { 20, 50, 37, 128 };
+    for (int segments : counts) {
+        std::vector<Point> expect(count * segments), out(count * segments);
+        printf("%d segments\n", segments);
+        double trig = bestSeconds(reps, [&]() {
+            for (int k = 0; k < count; k++)
+                tessellateCircleTrig(circles[k].cx, circles[k].cy, circles[k].r, segments,
+                    &expect[k * segments]);
+        });
+        run("cos/sin loop", circles, segments, reps, tessellateCircleTrig, trig, out, expect);
+        run("tessellateCircle", circles, segments, reps, tessellateCircle, trig, out, expect);
+        run("rotation", circles, segments, reps, tessellateCircleRotation, trig, out, expect);
+    }
+    return 0;
+}
@@ -0,0 +1,144 @@
+// Benchmark: batched SIMD Cohen–Sutherland vs. the per-segment function,
+// for one window and for several windows at once.
+//
+//   g++ -O2 -mavx2 bench/bench_clip_batch.cpp -o bench_clip_batch
+//   ./bench_clip_batch [--check] [segments] [repetitions]
+//
+// Build without -mavx2 to measure the SSE2 path on its own.
+#include "../gfx/clip_batch.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+// Clip window used by the classroom scenes.
+const float boardXmin = 100, boardXmax = 400;
+const float boardYmin = 300, boardYmax = 450;
+
+// -----------------------------------------------------------------
+// Harness
+// -----------------------------------------------------------------
+struct Segments {
+    std::vector<float> x0, y0, x1, y1;
+    std::vector<unsigned char> accept;
+    void resize(int n) {
+        x0.resize(n); y0.resize(n); x1.resize(n); y1.resize(n); accept.resize(n);
+    }
+};
+
+void report(const char* name, int n, double seconds, double baseline) {
+    printf("%-22s %8.2f ns/segment %9.1f Mseg/s  x%.2f\n",
+        name, seconds * 1e9 / n, n / seconds / 1e6, baseline / seconds);
+}
+
+template <class V>
+double runBatch(const char* name, const Segments& in, Segments& out, int reps,
+    const Segments& expect, double baseline) {
+    int n = (int)in.x0.size();
+    double s = bestSeconds(reps, [&]() {
+        cohenSutherlandClipBatchWith<V>(in.x0.data(), in.y0.data(), in.x1.data(), in.y1.data(), n,
+            boardXmin, boardXmax, boardYmin, boardYmax,
+            out.x0.data(), out.y0.data(), out.x1.data(), out.y1.data(), out.accept.data());
+    });
+    int mismatches = 0;
+    for (int i = 0; i < n; i++) {
+        if (out.accept[i] != expect.accept[i]) { mismatches++; continue; }
+        if (expect.accept[i] && (out.x0[i] != expect.x0[i] || out.y0[i] != expect.y0[i] ||
+            out.x1[i] != expect.x1[i] || out.y1[i] != expect.y1[i]))
+            mismatches++;
+    }
+    report(name, n, s, baseline);
+    benchCheck(mismatches == 0, "%s: %d segments differ from the scalar reference", name, mismatches);
+    return s;
+}
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    int n = benchArg(argc, argv, 1, 50000, 2000);
+    int reps = benchArg(argc, argv, 2, 50, 1);
+
+    // Segments scattered over the whole 500x500 window: a mix of trivially
+    // accepted, trivially rejected and partially clipped lines.
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<float> coord(0.0f, 500.0f);
+    Segments in, out, expect;
+    in.resize(n); out.resize(n); expect.resize(n);
+    for (int i = 0; i < n; i++) {
+        in.x0[i] = coord(rng); in.y0[i] = coord(rng);
+        in.x1[i] = coord(rng); in.y1[i] = coord(rng);
+    }
+
+    double scalar = bestSeconds(reps, [&]() {
+        for (int i = 0; i < n; i++) {
+            float x0 = in.x0[i], y0 = in.y0[i], x1 = in.x1[i], y1 = in.y1[i];
+            expect.accept[i] = cohenSutherlandClip(x0, y0, x1, y1,
+                boardXmin, boardXmax, boardYmin, boardYmax);
+            expect.x0[i] = x0; expect.y0[i] = y0; expect.x1[i] = x1; expect.y1[i] = y1;
+        }
+    });
+    int accepted = 0;
+    for (int i = 0; i < n; i++) accepted += expect.accept[i];
+    printf("%d segments, %d accepted, best of %d runs\n", n, accepted, reps);
+    report("cohenSutherlandClip", n, scalar, scalar);
+
+    runBatch<SimdScalar>("batch scalar", in, out, reps, expect, scalar);
+#if defined(GFX_HAVE_SSE)
+    runBatch<SimdSse>("batch SSE2 (4 lanes)", in, out, reps, expect, scalar);
+#endif
+#if defined(GFX_HAVE_AVX2)
+    runBatch<SimdAvx2>("batch AVX2 (8 lanes)", in, out, reps, expect, scalar);
+#endif
+
+    // Multi-panel layout: the same segments clipped against a 2x2 grid of
+    // panels and the board, one window at a time or in a single call.
+    const ClipWindow windows[] = {
+        { 0, 250, 0, 250 }, { 250, 500, 0, 250 }, { 0, 250, 250, 500 }, { 250, 500, 250, 500 },
+        { boardXmin, boardXmax, boardYmin, boardYmax },
+    };
+    const int windowCount = sizeof(windows) / sizeof(windows[0]);
+    int total = n * windowCount;
+    Segments multi, multiExpect;
+    multi.resize(total);
+    multiExpect.resize(total);
+    printf("\n%d windows (2x2 panels and the board), %d clips\n", windowCount, total);
+    double perWindow = bestSeconds(reps, [&]() {
+        for (int w = 0; w < windowCount; w++) {
+            const ClipWindow& c = windows[w];
+            for (int i = 0; i < n; i++) {
+                int k = w * n + i;
+                float x0 = in.x0[i], y0 = in.y0[i], x1 = in.x1[i], y1 = in.y1[i];
+                multiExpect.accept[k] = cohenSutherlandClip(x0, y0, x1, y1,
+                    c.xmin, c.xmax, c.ymin, c.ymax);
+                multiExpect.x0[k] = x0; multiExpect.y0[k] = y0;
+                multiExpect.x1[k] = x1; multiExpect.y1[k] = y1;
+            }
+        }
+    });
+    report("scalar, per window", total, perWindow, perWindow);
+    double batched = bestSeconds(reps, [&]() {
+        for (int w = 0; w < windowCount; w++) {
+            const ClipWindow& c = windows[w];
+            cohenSutherlandClipBatch(in.x0.data(), in.y0.data(), in.x1.data(), in.y1.data(), n,
+                c.xmin, c.xmax, c.ymin, c.ymax, multi.x0.data() + w * n, multi.y0.data() + w * n,
+                multi.x1.data() + w * n, multi.y1.data() + w * n, multi.accept.data() + w * n);
+        }
+    });
+    report("batch, per window", total, batched, perWindow);
+    double oneCall = bestSeconds(reps, [&]() {
+        cohenSutherlandClipWindows(in.x0.data(), in.y0.data(), in.x1.data(), in.y1.data(), n,
+            windows, windowCount, multi.x0.data(), multi.y0.data(), multi.x1.data(),
+            multi.y1.data(), multi.accept.data());
+    });
+    report("batch, all windows", total, oneCall, perWindow);
+    int mismatches = 0;
+    for (int k = 0; k < total; k++) {
+        if (multi.accept[k] != multiExpect.accept[k]) { mismatches++; continue; }
+        if (multi.accept[k] && (multi.x0[k] != multiExpect.x0[k] || multi.y0[k] != multiExpect.y0[k] ||
+            multi.x1[k] != multiExpect.x1[k] || multi.y1[k] != multiExpect.y1[k]))
+            mismatches++;
+    }
+    benchCheck(mismatches == 0, "%d clips differ from the scalar reference", mismatches);
+    return benchExit();
+}
@@ -0,0 +1,171 @@
+// Benchmark: polygon fill of whole scenes, scanline vs. edge functions.
+//
+//   g++ -O2 bench/bench_edgefill.cpp -lglut -o bench_edgefill
+//   ./playground --save-scene playground.gfxs
+//   ./classroom --save-scene classroom.gfxs
+//   ./bench_edgefill [--check] [scale] [repetitions] [scene.gfxs ...]
+//
+// Collects the filled polygons of each scene file (the default is the
+// two files above) at scale times the 500x500 window, then fills them
+// all into a framebuffer once per run with
+//   scanline   fillPolygon, one span per pair of crossings
+//   edge xN    fillPolygonEdgesWith<SimdNative>, tiles of edge functions
+//              with the build's own SIMD (4 lanes with SSE2)
+//   edge x8    fillPolygonEdges, 8 lanes with AVX2 when the CPU has it
+//   aa4, aa8   fillPolygonEdges with 4 and 8 samples per pixel, blended
+//   ms aa4     fillPolygonSamples with 4 samples, multisampled scanlines
+// Both 1-sample edge fills must give exactly the scanline pixels; the aa
+// columns report how many pixels the anti-aliasing changed.
+#include "../gfx/edge_raster.h"
+#include "../gfx/scene_file.h"
+#include "../gfx/soft_backend.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+struct Polygon {
+    int first, count;
+    uint32_t color;
+    PixelRect clip;
+};
+
+// Keeps the polygons the software backend would fill, in window
+// coordinates, split the way its rasterizer splits each primitive.
+class PolygonCollector : public SoftwareBackend {
+public:
+    PolygonCollector(int width, int height) : SoftwareBackend(width, height) {}
+
+    std::vector<Point> points;
+    std::vector<Polygon> polygons;
+
+protected:
+    void emitPrimitive(GLenum mode, const Point* v, int n, uint32_t color, int,
+        const PixelRect& clip) override {
+        switch (mode) {
+        case GL_TRIANGLES:
+            for (int i = 0; i + 2 < n; i += 3) add({ v[i], v[i + 1], v[i + 2] }, color, clip);
+            break;
+        case GL_TRIANGLE_STRIP:
+            for (int i = 0; i + 2 < n; i++) add({ v[i], v[i + 1], v[i + 2] }, color, clip);
+            break;
+        case GL_TRIANGLE_FAN:
+            for (int i = 1; i + 1 < n; i++) add({ v[0], v[i], v[i + 1] }, color, clip);
+            break;
+        case GL_QUADS:
+            for (int i = 0; i + 3 < n; i += 4) add({ v[i], v[i + 1], v[i + 2], v[i + 3] }, color, clip);
+            break;
+        case GL_QUAD_STRIP:
+            for (int i = 0; i + 3 < n; i += 2) add({ v[i], v[i + 1], v[i + 3], v[i + 2] }, color, clip);
+            break;
+        case GL_POLYGON:
+            add(std::vector<Point>(v, v + n), color, clip);
+            break;
+        }
+    }
+
+private:
+    void add(const std::vector<Point>& poly, uint32_t color, const PixelRect& clip) {
+        polygons.push_back({ (int)points.size(), (int)poly.size(), color, clip });
+        points.insert(points.end(), poly.begin(), poly.end());
+    }
+};
+
+// Fill every polygon with each method and print a row of timings.
+void measure(const char* name, const std::vector<Point>& vertices,
+    const std::vector<Polygon>& polygons, int size, int reps) {
+    const Point* points = vertices.data();
+    Framebuffer fb(size, size);
+    auto fillAll = [&](auto fill) {
+        fb.fill(packRGB(255, 255, 255), fb.bounds());
+        for (const Polygon& p : polygons)
+            fill(points + p.first, p.count, p.color, p.clip);
+    };
+    auto scanline = [&](const Point* v, int n, uint32_t c, const PixelRect& clip) {
+        fillPolygon(fb, v, n, c, clip);
+    };
+    auto native = [&](const Point* v, int n, uint32_t c, const PixelRect& clip) {
+        fillPolygonEdgesWith<SimdNative>(fb, v, n, c, clip, 1);
+    };
+    auto edge = [&](int samples) {
+        return [&fb, samples](const Point* v, int n, uint32_t c, const PixelRect& clip) {
+            fillPolygonEdges(fb, v, n, c, clip, samples);
+        };
+    };
+    auto multisample = [&](const Point* v, int n, uint32_t c, const PixelRect& clip) {
+        fillPolygonSamples(fb, v, n, c, clip, 4);
+    };
+    auto changed = [](const Framebuffer& a, const Framebuffer& b) {
+        long k = 0;
+        for (size_t i = 0; i < a.pixels.size(); i++)
+            k += a.pixels[i] != b.pixels[i];
+        return k;
+    };
+
+    double tScan = bestSeconds(reps, [&]() { fillAll(scanline); });
+    Framebuffer reference = fb;
+    double tNative = bestSeconds(reps, [&]() { fillAll(native); });
+    bool same = changed(fb, reference) == 0;
+    double tEdge = bestSeconds(reps, [&]() { fillAll(edge(1)); });
+    same = same && changed(fb, reference) == 0;
+    double tAa4 = bestSeconds(reps, [&]() { fillAll(edge(4)); });
+    long aa4 = changed(fb, reference);
+    double tAa8 = bestSeconds(reps, [&]() { fillAll(edge(8)); });
+    long aa8 = changed(fb, reference);
+    double tSampled = bestSeconds(reps, [&]() { fillAll(multisample); });
+
+    printf("%-16s %8zu %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f %8.2fx %9ld %9ld  %s\n", name,
+        polygons.size(), tScan * 1e3, tNative * 1e3, tEdge * 1e3, tAa4 * 1e3, tAa8 * 1e3,
+        tSampled * 1e3, tScan / tEdge, aa4, aa8, same ? "yes" : "NO");
+    benchCheck(same, "%s: the 1-sample edge fill differs from the scanline fill", name);
+}
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    int scale = std::max(1, benchArg(argc, argv, 1, 1, 1));
+    int reps = benchArg(argc, argv, 2, 20, 1);
+    std::vector<const char*> paths(argv + std::min(argc, 3), argv + argc);
+    if (paths.empty())
+        paths = { "playground.gfxs", "classroom.gfxs" };
+    int size = 500 * scale;
+#if defined(GFX_HAVE_VECTOR8) && !defined(GFX_HAVE_AVX2)
+    int lanes = cpuHasAvx2() ? 8 : SimdNative::WIDTH;
+#else
+    int lanes = SimdNative::WIDTH;
+#endif
+    printf("%dx%d framebuffer, %d lane(s) native, %d for edge x8, best of %d runs\n", size, size,
+        SimdNative::WIDTH, lanes, reps);
+    printf("%-16s %8s %10s %10s %10s %10s %10s %10s %9s %9s %9s  %s\n", "scene", "polygons",
+        "scanline", "edge xN", "edge x8", "aa4", "aa8", "ms aa4", "x8 speed", "aa4 px", "aa8 px",
+        "same");
+
+    for (const char* path : paths) {
+        MappedScene file;
+        if (!file.open(path)) {
+            fprintf(stderr, "%s: %s\n", path, file.error());
+            return 1;
+        }
+        PolygonCollector collector(size, size);
+        gfxUseBackend(&collector);
+        drawSceneFile(file);
+        gfxUseBackend(nullptr);
+        measure(path, collector.points, collector.polygons, size, reps);
+    }
+
+    // Many small triangles, where most pixels lie near an edge.
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos(0.0f, (float)size), offset(-10.0f, 10.0f),
+        shade(0.0f, 1.0f);
+    std::vector<Point> points;
+    std::vector<Polygon> triangles;
+    for (int k = 0; k < 20000; k++) {
+        Point c = { pos(rng), pos(rng) };
+        triangles.push_back({ (int)points.size(), 3,
+            packColor(shade(rng), shade(rng), shade(rng)), { 0, 0, size, size } });
+        for (int i = 0; i < 3; i++)
+            points.push_back({ c.x + offset(rng), c.y + offset(rng) });
+    }
+    measure("20k triangles", points, triangles, size, reps);
+    return benchExit();
+}
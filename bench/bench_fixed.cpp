@@ -0,0 +1,133 @@
+// Benchmark: the float and 16.16 fixed-point geometry paths, from clip to
+// pixels.
+//
+//   g++ -O2 bench/bench_fixed.cpp -o bench_fixed
+//   ./bench_fixed [--check] [polygons] [repetitions]
+//
+// Polygons go through the single-pass Sutherland–Hodgman clipper and the
+// scanline fill; segments through Cohen–Sutherland and Bresenham. The
+// fixed-point geometry is converted once up front, as a scene stored in
+// 16.16 would be. Each fixed image is printed as a hash: it is the same
+// for every compiler, optimization level and -ffast-math setting, while
+// the float images may differ between such builds.
+#include "../gfx/lines.h"
+#include "../gfx/polyclip.h"
+#include "../gfx/softraster.h"
+#include "bench_util.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// FNV-1a over the pixels.
+uint64_t imageHash(const Framebuffer& fb) {
+    uint64_t h = 1469598103934665603ull;
+    for (uint32_t p : fb.pixels) {
+        h ^= p;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+long differingPixels(const Framebuffer& a, const Framebuffer& b) {
+    long n = 0;
+    for (size_t i = 0; i < a.pixels.size(); i++)
+        n += a.pixels[i] != b.pixels[i];
+    return n;
+}
+
+// Clip window of the playground scene.
+const float winXmin = 150, winXmax = 350, winYmin = 150, winYmax = 350;
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    int count = benchArg(argc, argv, 1, 5000, 200);
+    int reps = benchArg(argc, argv, 2, 20, 1);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos(0.0f, 500.0f), rad(10.0f, 120.0f);
+    std::uniform_int_distribution<int> segs(20, 64), shade(1, 255);
+
+    // Circles of 20-64 segments scattered over the window, like drawBall.
+    std::vector<std::vector<Point> > polys(count);
+    std::vector<std::vector<FixedPoint> > fixedPolys(count);
+    std::vector<uint32_t> colors(count);
+    for (int k = 0; k < count; k++) {
+        float cx = pos(rng), cy = pos(rng), r = rad(rng);
+        int n = segs(rng);
+        for (int i = 0; i < n; i++) {
+            float theta = 2.0f * (float)M_PI * i / n;
+            polys[k].push_back({ cx + r * cosf(theta), cy + r * sinf(theta) });
+            fixedPolys[k].push_back(toFixed(polys[k].back()));
+        }
+        colors[k] = packRGB(shade(rng), shade(rng), shade(rng));
+    }
+    // Segments with endpoints anywhere in the window.
+    int lineCount = count * 10;
+    std::vector<Point> ends(2 * lineCount);
+    std::vector<FixedPoint> fixedEnds(2 * lineCount);
+    for (int i = 0; i < 2 * lineCount; i++) {
+        ends[i] = { pos(rng), pos(rng) };
+        fixedEnds[i] = toFixed(ends[i]);
+    }
+    printf("%d polygons, %d segments, clipped to [%g,%g] x [%g,%g], best of %d runs\n", count,
+        lineCount, winXmin, winXmax, winYmin, winYmax, reps);
+
+    const Fixed16 fxXmin = Fixed16::fromFloat(winXmin), fxXmax = Fixed16::fromFloat(winXmax);
+    const Fixed16 fxYmin = Fixed16::fromFloat(winYmin), fxYmax = Fixed16::fromFloat(winYmax);
+    Framebuffer floatImage(500, 500), fixedImage(500, 500);
+    PixelRect clip = floatImage.bounds();
+    Point buffer[512];
+    FixedPoint fixedBuffer[512];
+
+    double floatFill = bestSeconds(reps, [&]() {
+        floatImage.fill(0, clip);
+        for (int k = 0; k < count; k++) {
+            int n = sutherlandHodgmanClipStream(polys[k].data(), (int)polys[k].size(),
+                winXmin, winXmax, winYmin, winYmax, buffer, 512);
+            fillPolygon(floatImage, buffer, n, colors[k], clip);
+        }
+    });
+    double fixedFill = bestSeconds(reps, [&]() {
+        fixedImage.fill(0, clip);
+        for (int k = 0; k < count; k++) {
+            int n = sutherlandHodgmanClipStream(fixedPolys[k].data(), (int)fixedPolys[k].size(),
+                fxXmin, fxXmax, fxYmin, fxYmax, fixedBuffer, 512);
+            fillPolygon(fixedImage, fixedBuffer, n, colors[k], clip);
+        }
+    });
+    printf("polygons: clip + fill\n");
+    printf("  %-18s %8.1f ns/polygon\n", "float", floatFill * 1e9 / count);
+    printf("  %-18s %8.1f ns/polygon  x%.2f\n", "fixed 16.16", fixedFill * 1e9 / count,
+        floatFill / fixedFill);
+    long fillDiffer = differingPixels(floatImage, fixedImage);
+    printf("  %ld pixels differ from float; fixed image hash %016llx\n", fillDiffer,
+        (unsigned long long)imageHash(fixedImage));
+
+    const uint32_t white = packRGB(255, 255, 255);
+    double floatLines = bestSeconds(reps, [&]() {
+        floatImage.fill(0, clip);
+        for (int i = 0; i < lineCount; i++) {
+            Point a = ends[2 * i], b = ends[2 * i + 1];
+            if (cohenSutherlandClip(a.x, a.y, b.x, b.y, winXmin, winXmax, winYmin, winYmax))
+                bresenhamLine(floatImage, (int)std::floor(a.x + 0.5f), (int)std::floor(a.y + 0.5f),
+                    (int)std::floor(b.x + 0.5f), (int)std::floor(b.y + 0.5f), white, clip);
+        }
+    });
+    double fixedLines = bestSeconds(reps, [&]() {
+        fixedImage.fill(0, clip);
+        for (int i = 0; i < lineCount; i++)
+            bresenhamLineClipped(fixedImage, fixedEnds[2 * i], fixedEnds[2 * i + 1],
+                fxXmin, fxXmax, fxYmin, fxYmax, white, clip);
+    });
+    printf("segments: Cohen-Sutherland + Bresenham\n");
+    printf("  %-18s %8.1f ns/segment\n", "float", floatLines * 1e9 / lineCount);
+    printf("  %-18s %8.1f ns/segment  x%.2f\n", "fixed 16.16", fixedLines * 1e9 / lineCount,
+        floatLines / fixedLines);
+    long lineDiffer = differingPixels(floatImage, fixedImage);
+    printf("  %ld pixels differ from float; fixed image hash %016llx\n", lineDiffer,
+        (unsigned long long)imageHash(fixedImage));
+    benchCheck(fillDiffer == 0 && lineDiffer == 0, "the fixed-point images differ from float");
+    return benchExit();
+}
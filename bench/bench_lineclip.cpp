@@ -0,0 +1,99 @@
+// Benchmark: Liang–Barsky vs. Cohen–Sutherland on accept/reject/partial
+// segment mixes.
+//
+//   g++ -O2 bench/bench_lineclip.cpp -o bench_lineclip
+//   ./bench_lineclip [--check] [segments] [repetitions]
+#include "../gfx/clip.h"
+#include "bench_util.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// Clip window used by the classroom scenes.
+const float boardXmin = 100, boardXmax = 400;
+const float boardYmin = 300, boardYmax = 450;
+
+// -----------------------------------------------------------------
+// Harness
+// -----------------------------------------------------------------
+struct Segment { float x0, y0, x1, y1; };
+
+typedef bool (*ClipFn)(float&, float&, float&, float&, float, float, float, float);
+
+// Best-of-reps time to clip every segment; results go to out/accepted.
+double timeClipper(ClipFn clip, const std::vector<Segment>& in, std::vector<Segment>& out,
+    std::vector<unsigned char>& accepted, int reps) {
+    double best = 1e30;
+    int n = (int)in.size();
+    for (int r = 0; r < reps; r++) {
+        Clock::time_point t0 = Clock::now();
+        for (int i = 0; i < n; i++) {
+            Segment s = in[i];
+            accepted[i] = clip(s.x0, s.y0, s.x1, s.y1, boardXmin, boardXmax, boardYmin, boardYmax);
+            out[i] = s;
+        }
+        double s = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (s < best) best = s;
+    }
+    return best;
+}
+
+void benchMix(const char* name, const std::vector<Segment>& in, int reps) {
+    int n = (int)in.size();
+    std::vector<Segment> cs(n), lb(n);
+    std::vector<unsigned char> csAccept(n), lbAccept(n);
+    double csTime = timeClipper(cohenSutherlandClip, in, cs, csAccept, reps);
+    double lbTime = timeClipper(liangBarskyClip, in, lb, lbAccept, reps);
+
+    int accepted = 0, disagree = 0;
+    float maxDiff = 0;
+    for (int i = 0; i < n; i++) {
+        accepted += csAccept[i];
+        if (csAccept[i] != lbAccept[i]) { disagree++; continue; }
+        if (!csAccept[i]) continue;
+        maxDiff = std::max({ maxDiff, std::fabs(cs[i].x0 - lb[i].x0), std::fabs(cs[i].y0 - lb[i].y0),
+            std::fabs(cs[i].x1 - lb[i].x1), std::fabs(cs[i].y1 - lb[i].y1) });
+    }
+    printf("%-18s %5.1f%% accepted  Cohen-Sutherland %6.2f ns  Liang-Barsky %6.2f ns  x%.2f",
+        name, 100.0 * accepted / n, csTime * 1e9 / n, lbTime * 1e9 / n, csTime / lbTime);
+    printf("  (max endpoint diff %.2g", maxDiff);
+    if (disagree)
+        printf(", %d accept decisions differ", disagree);
+    printf(")\n");
+    benchCheck(disagree == 0 && maxDiff <= 1e-3f, "%s: the clippers disagree", name);
+}
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    int n = benchArg(argc, argv, 1, 200000, 2000);
+    int reps = benchArg(argc, argv, 2, 20, 1);
+    printf("%d segments per mix, board %gx%g..%gx%g, best of %d runs, ns/segment\n",
+        n, boardXmin, boardYmin, boardXmax, boardYmax, reps);
+
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> window(0.0f, 500.0f);
+    std::uniform_real_distribution<float> insideX(boardXmin, boardXmax), insideY(boardYmin, boardYmax);
+    std::uniform_real_distribution<float> leftX(0.0f, boardXmin), belowY(0.0f, boardYmin);
+    std::vector<Segment> inside(n), rejected(n), partial(n), mixed(n);
+    for (int i = 0; i < n; i++) {
+        inside[i] = { insideX(rng), insideY(rng), insideX(rng), insideY(rng) };
+        // Both endpoints in the same outside zone (left or below).
+        if (i & 1) rejected[i] = { leftX(rng), window(rng), leftX(rng), window(rng) };
+        else rejected[i] = { window(rng), belowY(rng), window(rng), belowY(rng) };
+        // One endpoint inside, one anywhere outside the board.
+        Segment s = { insideX(rng), insideY(rng), window(rng), window(rng) };
+        while (s.x1 >= boardXmin && s.x1 <= boardXmax && s.y1 >= boardYmin && s.y1 <= boardYmax) {
+            s.x1 = window(rng);
+            s.y1 = window(rng);
+        }
+        partial[i] = s;
+        mixed[i] = { window(rng), window(rng), window(rng), window(rng) };
+    }
+    benchMix("trivial accept", inside, reps);
+    benchMix("trivial reject", rejected, reps);
+    benchMix("partial", partial, reps);
+    benchMix("uniform mix", mixed, reps);
+    return benchExit();
+}
@@ -0,0 +1,119 @@
+// Benchmark: DDA and Bresenham line engines (scalar, SIMD batch, spans).
+//
+//   g++ -O2 -mavx2 bench/bench_lines.cpp -o bench_lines
+//   ./bench_lines [--check] [lines] [repetitions] [size]
+//
+// Build without -mavx2 to measure the SSE2 batch on its own. Throughput
+// is line pixels (steps + 1 per line) per second, clipped or not.
+#include "../gfx/lines.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+struct Lines {
+    std::vector<int> x0, y0, x1, y1;
+    long pixels = 0;
+
+    void add(int a, int b, int c, int d) {
+        x0.push_back(a); y0.push_back(b); x1.push_back(c); y1.push_back(d);
+        pixels += std::max(std::abs(c - a), std::abs(d - b)) + 1;
+    }
+    int size() const { return (int)x0.size(); }
+};
+
+const uint32_t white = packRGB(255, 255, 255);
+
+// Time one engine, then check its image against the scalar reference.
+template <class F>
+double run(const char* name, Framebuffer& fb, const Lines& lines, int reps, double baseline,
+    const Framebuffer* expect, F draw) {
+    double s = bestSeconds(reps, [&]() {
+        fb.fill(0, fb.bounds());
+        draw();
+    });
+    printf("    %-22s %8.1f Mpix/s  x%.2f", name, lines.pixels / s / 1e6,
+        baseline > 0 ? baseline / s : 1.0);
+    printf("\n");
+    if (expect)
+        benchCheck(fb.pixels == expect->pixels, "%s differs from the scalar reference", name);
+    return s;
+}
+
+void benchWorkload(const char* title, const Lines& lines, int reps, int size) {
+    Framebuffer fb(size, size), dda(size, size), bres(size, size);
+    PixelRect clip = fb.bounds();
+    int n = lines.size();
+    const int *x0 = lines.x0.data(), *y0 = lines.y0.data(), *x1 = lines.x1.data(), *y1 = lines.y1.data();
+    printf("%s: %d lines, %.2f Mpix\n", title, n, lines.pixels / 1e6);
+
+    printf("  DDA\n");
+    double scalar = run("scalar", dda, lines, reps, 0, nullptr, [&]() {
+        for (int i = 0; i < n; i++)
+            ddaLine(dda, x0[i], y0[i], x1[i], y1[i], white, clip);
+    });
+#if defined(GFX_HAVE_SSE)
+    run("batch SSE2 (4 lanes)", fb, lines, reps, scalar, &dda, [&]() {
+        ddaLineBatchWith<SimdSse>(fb, x0, y0, x1, y1, n, white, clip);
+    });
+#endif
+#if defined(GFX_HAVE_AVX2)
+    run("batch AVX2 (8 lanes)", fb, lines, reps, scalar, &dda, [&]() {
+        ddaLineBatchWith<SimdAvx2>(fb, x0, y0, x1, y1, n, white, clip);
+    });
+#endif
+
+    printf("  Bresenham\n");
+    scalar = run("scalar", bres, lines, reps, 0, nullptr, [&]() {
+        for (int i = 0; i < n; i++)
+            bresenhamLine(bres, x0[i], y0[i], x1[i], y1[i], white, clip);
+    });
+#if defined(GFX_HAVE_SSE)
+    run("batch SSE2 (4 lanes)", fb, lines, reps, scalar, &bres, [&]() {
+        bresenhamLineBatchWith<SimdSse>(fb, x0, y0, x1, y1, n, white, clip);
+    });
+#endif
+#if defined(GFX_HAVE_AVX2)
+    run("batch AVX2 (8 lanes)", fb, lines, reps, scalar, &bres, [&]() {
+        bresenhamLineBatchWith<SimdAvx2>(fb, x0, y0, x1, y1, n, white, clip);
+    });
+#endif
+    run("spans", fb, lines, reps, scalar, &bres, [&]() {
+        for (int i = 0; i < n; i++)
+            bresenhamLineSpans(fb, x0[i], y0[i], x1[i], y1[i], white, clip);
+    });
+}
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    int count = benchArg(argc, argv, 1, 20000, 300);
+    int reps = benchArg(argc, argv, 2, 10, 1);
+    int size = benchArg(argc, argv, 3, 1000, 300);
+    printf("%dx%d framebuffer, best of %d runs\n", size, size, reps);
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> coord(0, size - 1), offset(-32, 32);
+    Lines random, shortLines, flat, axis;
+    for (int i = 0; i < count; i++) {
+        random.add(coord(rng), coord(rng), coord(rng), coord(rng));
+
+        int x = coord(rng), y = coord(rng);
+        shortLines.add(x, y, x + offset(rng), y + offset(rng));
+
+        // Near-horizontal: |dy| at most |dx| / 8.
+        int ax = coord(rng), bx = coord(rng), ay = coord(rng);
+        int spread = std::abs(bx - ax) / 8;
+        std::uniform_int_distribution<int> rise(-spread, spread);
+        flat.add(ax, ay, bx, std::min(size - 1, std::max(0, ay + rise(rng))));
+
+        int a = coord(rng), b = coord(rng), c = coord(rng);
+        if (i & 1) axis.add(a, c, b, c);
+        else axis.add(c, a, c, b);
+    }
+    benchWorkload("random", random, reps, size);
+    benchWorkload("short (|d| <= 32, partly clipped)", shortLines, reps, size);
+    benchWorkload("near-horizontal", flat, reps, size);
+    benchWorkload("axis-aligned", axis, reps, size);
+    return benchExit();
+}
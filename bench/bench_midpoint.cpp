@@ -0,0 +1,143 @@
+// Benchmark: midpoint span rasterizer vs. tessellated polygons for rings
+// and filled circles.
+//
+//   g++ -O2 bench/bench_midpoint.cpp -o bench_midpoint
+//   ./bench_midpoint [--check] [shapes] [repetitions] [size]
+#include "../gfx/circle.h"
+#include "../gfx/midpoint.h"
+#include "../gfx/softraster.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+struct Shape { int cx, cy, r, thickness; };
+
+const int segments = 64;    // as GlBackend tessellates ellipses
+
+long coverage(const Framebuffer& fb) {
+    long n = 0;
+    for (uint32_t p : fb.pixels) n += p != 0;
+    return n;
+}
+
+void report(const char* name, int n, double seconds, double baseline, long pixels) {
+    printf("  %-26s %8.2f us/shape %8.1f kshapes/s  x%-6.2f %ld pixels set\n", name,
+        seconds * 1e6 / n, n / seconds / 1e3, baseline / seconds, pixels);
+}
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    int count = benchArg(argc, argv, 1, 5000, 50);
+    int reps = benchArg(argc, argv, 2, 5, 1);
+    int size = benchArg(argc, argv, 3, 1000, 1000);
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> pos(0, size - 1), rad(8, 80), width(2, 12);
+    std::vector<Shape> shapes(count);
+    for (Shape& s : shapes) {
+        s.cx = pos(rng); s.cy = pos(rng); s.r = rad(rng);
+        s.thickness = std::min(s.r, width(rng));
+    }
+    Framebuffer fb(size, size);
+    PixelRect clip = fb.bounds();
+    const uint32_t color = packRGB(255, 255, 255);
+    printf("%d shapes on %dx%d, radius 8-80, best of %d runs\n", count, size, size, reps);
+    auto clear = [&]() { fb.fill(0, clip); };
+
+    // Rings, as a quad strip between two tessellated circles (one polygon
+    // per quad, like SoftwareBackend's GL_QUAD_STRIP).
+    printf("rings\n");
+    Point outer[segments], inner[segments];
+    double strip = bestSeconds(reps, [&]() {
+        clear();
+        for (const Shape& s : shapes) {
+            float cx = s.cx + 0.5f, cy = s.cy + 0.5f;
+            tessellateCircle(cx, cy, (float)s.r, segments, outer);
+            tessellateCircle(cx, cy, (float)(s.r - s.thickness), segments, inner);
+            for (int i = 0; i < segments; i++) {
+                int j = (i + 1) % segments;
+                Point quad[4] = { outer[i], outer[j], inner[j], inner[i] };
+                fillPolygon(fb, quad, 4, color, clip);
+            }
+        }
+    });
+    long stripPixels = coverage(fb);
+    report("polygon quad strip", count, strip, strip, stripPixels);
+
+    // Rings as one even-odd polygon: outer loop, bridge, inner loop.
+    Point annulus[2 * segments + 2];
+    double evenOdd = bestSeconds(reps, [&]() {
+        clear();
+        for (const Shape& s : shapes) {
+            float cx = s.cx + 0.5f, cy = s.cy + 0.5f;
+            tessellateCircle(cx, cy, (float)s.r, segments, outer);
+            tessellateCircle(cx, cy, (float)(s.r - s.thickness), segments, inner);
+            int n = 0;
+            for (int i = 0; i <= segments; i++)
+                annulus[n++] = outer[i % segments];
+            for (int i = segments; i >= 0; i--)
+                annulus[n++] = inner[i % segments];
+            fillPolygon(fb, annulus, n, color, clip);
+        }
+    });
+    report("polygon even-odd annulus", count, evenOdd, strip, coverage(fb));
+
+    double ring = bestSeconds(reps, [&]() {
+        clear();
+        for (const Shape& s : shapes)
+            drawMidpointEllipse(fb, s.cx, s.cy, s.r, s.r, ELLIPSE_RING, s.thickness, color,
+                nullptr, clip);
+    });
+    long ringPixels = coverage(fb);
+    report("midpoint ring", count, ring, strip, ringPixels);
+    benchCheck(std::abs(ringPixels - stripPixels) <= stripPixels / 50,
+        "midpoint rings cover %ld pixels, the polygons %ld", ringPixels, stripPixels);
+
+    double patterned = bestSeconds(reps, [&]() {
+        clear();
+        for (const Shape& s : shapes)
+            drawMidpointEllipse(fb, s.cx, s.cy, s.r, s.r, ELLIPSE_RING, s.thickness, color,
+                &PATTERN_CROSSHATCH, clip);
+    });
+    report("midpoint ring, pattern", count, patterned, strip, coverage(fb));
+
+    double ellipse = bestSeconds(reps, [&]() {
+        clear();
+        for (const Shape& s : shapes)
+            drawMidpointEllipse(fb, s.cx, s.cy, s.r, s.r / 2 + 1, ELLIPSE_RING, s.thickness / 2 + 1,
+                color, nullptr, clip);
+    });
+    report("midpoint ellipse ring", count, ellipse, strip, coverage(fb));
+
+    // Filled circles.
+    printf("filled\n");
+    double polygon = bestSeconds(reps, [&]() {
+        clear();
+        for (const Shape& s : shapes) {
+            tessellateCircle(s.cx + 0.5f, s.cy + 0.5f, (float)s.r, segments, outer);
+            fillPolygon(fb, outer, segments, color, clip);
+        }
+    });
+    long polygonPixels = coverage(fb);
+    report("polygon", count, polygon, polygon, polygonPixels);
+
+    double filled = bestSeconds(reps, [&]() {
+        clear();
+        for (const Shape& s : shapes)
+            drawMidpointEllipse(fb, s.cx, s.cy, s.r, s.r, ELLIPSE_FILLED, 1, color, nullptr, clip);
+    });
+    long filledPixels = coverage(fb);
+    report("midpoint", count, filled, polygon, filledPixels);
+    benchCheck(std::abs(filledPixels - polygonPixels) <= polygonPixels / 50,
+        "midpoint circles cover %ld pixels, the polygons %ld", filledPixels, polygonPixels);
+
+    double outline = bestSeconds(reps, [&]() {
+        clear();
+        for (const Shape& s : shapes)
+            drawMidpointEllipse(fb, s.cx, s.cy, s.r, s.r, ELLIPSE_OUTLINE, 1, color, nullptr, clip);
+    });
+    report("midpoint outline", count, outline, polygon, coverage(fb));
+    return benchExit();
+}
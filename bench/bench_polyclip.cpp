@@ -0,0 +1,341 @@
+// Benchmark: single-pass Sutherland–Hodgman vs. the four-stage version,
+// and the templated clippers against the hand-written per-edge functions
+// for float, double and 16.16 fixed-point coordinates.
+//
+//   g++ -O2 bench/bench_polyclip.cpp -o bench_polyclip
+//   ./bench_polyclip [--check] [polygons] [repetitions]
+//
+// Heap allocations are counted by replacing the global operator new.
+#define BENCH_COUNT_ALLOCATIONS
+#include "../gfx/polyclip.h"
+#include "bench_util.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// -----------------------------------------------------------------
+// Reference: the clipping functions as playground.cpp had them, one
+// hand-written function per edge
+// -----------------------------------------------------------------
+namespace hand {
+
+std::vector<Point> clipLeft(const std::vector<Point>& poly, float xMin) {
+    std::vector<Point> result;
+    int n = poly.size();
+    for (int i = 0; i < n; i++) {
+        Point curr = poly[i];
+        Point prev = poly[(i + n - 1) % n];
+        bool currInside = (curr.x >= xMin);
+        bool prevInside = (prev.x >= xMin);
+        if (prevInside && currInside) {
+            result.push_back(curr);
+        }
+        else if (prevInside && !currInside) {
+            float t = (xMin - prev.x) / (curr.x - prev.x);
+            Point inter = { xMin, prev.y + t * (curr.y - prev.y) };
+            result.push_back(inter);
+        }
+        else if (!prevInside && currInside) {
+            float t = (xMin - prev.x) / (curr.x - prev.x);
+            Point inter = { xMin, prev.y + t * (curr.y - prev.y) };
+            result.push_back(inter);
+            result.push_back(curr);
+        }
+    }
+    return result;
+}
+
+std::vector<Point> clipRight(const std::vector<Point>& poly, float xMax) {
+    std::vector<Point> result;
+    int n = poly.size();
+    for (int i = 0; i < n; i++) {
+        Point curr = poly[i];
+        Point prev = poly[(i + n - 1) % n];
+        bool currInside = (curr.x <= xMax);
+        bool prevInside = (prev.x <= xMax);
+        if (prevInside && currInside) {
+            result.push_back(curr);
+        }
+        else if (prevInside && !currInside) {
+            float t = (xMax - prev.x) / (curr.x - prev.x);
+            Point inter = { xMax, prev.y + t * (curr.y - prev.y) };
+            result.push_back(inter);
+        }
+        else if (!prevInside && currInside) {
+            float t = (xMax - prev.x) / (curr.x - prev.x);
+            Point inter = { xMax, prev.y + t * (curr.y - prev.y) };
+            result.push_back(inter);
+            result.push_back(curr);
+        }
+    }
+    return result;
+}
+
+std::vector<Point> clipBottom(const std::vector<Point>& poly, float yMin) {
+    std::vector<Point> result;
+    int n = poly.size();
+    for (int i = 0; i < n; i++) {
+        Point curr = poly[i];
+        Point prev = poly[(i + n - 1) % n];
+        bool currInside = (curr.y >= yMin);
+        bool prevInside = (prev.y >= yMin);
+        if (prevInside && currInside) {
+            result.push_back(curr);
+        }
+        else if (prevInside && !currInside) {
+            float t = (yMin - prev.y) / (curr.y - prev.y);
+            Point inter = { prev.x + t * (curr.x - prev.x), yMin };
+            result.push_back(inter);
+        }
+        else if (!prevInside && currInside) {
+            float t = (yMin - prev.y) / (curr.y - prev.y);
+            Point inter = { prev.x + t * (curr.x - prev.x), yMin };
+            result.push_back(inter);
+            result.push_back(curr);
+        }
+    }
+    return result;
+}
+
+std::vector<Point> clipTop(const std::vector<Point>& poly, float yMax) {
+    std::vector<Point> result;
+    int n = poly.size();
+    for (int i = 0; i < n; i++) {
+        Point curr = poly[i];
+        Point prev = poly[(i + n - 1) % n];
+        bool currInside = (curr.y <= yMax);
+        bool prevInside = (prev.y <= yMax);
+        if (prevInside && currInside) {
+            result.push_back(curr);
+        }
+        else if (prevInside && !currInside) {
+            float t = (yMax - prev.y) / (curr.y - prev.y);
+            Point inter = { prev.x + t * (curr.x - prev.x), yMax };
+            result.push_back(inter);
+        }
+        else if (!prevInside && currInside) {
+            float t = (yMax - prev.y) / (curr.y - prev.y);
+            Point inter = { prev.x + t * (curr.x - prev.x), yMax };
+            result.push_back(inter);
+            result.push_back(curr);
+        }
+    }
+    return result;
+}
+
+std::vector<Point> sutherlandHodgmanClip(const std::vector<Point>& poly,
+    float xMin, float xMax, float yMin, float yMax) {
+    std::vector<Point> output = clipLeft(poly, xMin);
+    output = clipRight(output, xMax);
+    output = clipBottom(output, yMin);
+    output = clipTop(output, yMax);
+    return output;
+}
+
+} // namespace hand
+
+// -----------------------------------------------------------------
+// Harness
+// -----------------------------------------------------------------
+const float winXmin = 150, winXmax = 350, winYmin = 150, winYmax = 350;
+
+typedef BasicPoint<double> PointD;
+
+Point toFloat(PointD p) { return { (float)p.x, (float)p.y }; }
+
+// Largest coordinate difference between the reference output and another
+// point type's, vertex by vertex; polygons whose vertex counts differ are
+// counted in `mismatched` instead.
+template <class P>
+double maxDeviation(const std::vector<Point>& expect, const std::vector<P>& got, int& mismatched) {
+    if (expect.size() != got.size()) {
+        mismatched++;
+        return 0;
+    }
+    double worst = 0;
+    for (size_t i = 0; i < got.size(); i++) {
+        Point q = toFloat(got[i]);
+        worst = std::max(worst, (double)std::max(fabsf(q.x - expect[i].x), fabsf(q.y - expect[i].y)));
+    }
+    return worst;
+}
+
+// True if b is a cyclic rotation of a (the streaming clipper may start the
+// output polygon at a different vertex).
+bool sameCycle(const std::vector<Point>& a, const Point* b, int n) {
+    if ((int)a.size() != n) return false;
+    if (n == 0) return true;
+    for (int start = 0; start < n; start++) {
+        bool match = true;
+        for (int i = 0; i < n && match; i++) {
+            const Point& p = a[i];
+            const Point& q = b[(start + i) % n];
+            match = p.x == q.x && p.y == q.y;
+        }
+        if (match) return true;
+    }
+    return false;
+}
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    int count = benchArg(argc, argv, 1, 5000, 300);
+    int reps = benchArg(argc, argv, 2, 20, 1);
+
+    // Circles of 20-64 segments scattered over the window, like drawBall.
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos(0.0f, 500.0f), rad(10.0f, 120.0f);
+    std::uniform_int_distribution<int> segs(20, 64);
+    std::vector<std::vector<Point> > polys(count);
+    long vertices = 0;
+    for (int k = 0; k < count; k++) {
+        float cx = pos(rng), cy = pos(rng), r = rad(rng);
+        int n = segs(rng);
+        for (int i = 0; i < n; i++) {
+            float theta = 2.0f * (float)M_PI * i / n;
+            polys[k].push_back({ cx + r * cosf(theta), cy + r * sinf(theta) });
+        }
+        vertices += n;
+    }
+    printf("%d polygons, %ld input vertices, best of %d runs\n", count, vertices, reps);
+
+    // Four-stage reference.
+    double refBest = 1e30;
+    long refAllocs = 0, outVertices = 0;
+    for (int r = 0; r < reps; r++) {
+        long a0 = allocations;
+        outVertices = 0;
+        Clock::time_point t0 = Clock::now();
+        for (int k = 0; k < count; k++)
+            outVertices += hand::sutherlandHodgmanClip(polys[k], winXmin, winXmax, winYmin, winYmax).size();
+        double s = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (s < refBest) refBest = s;
+        refAllocs = allocations - a0;
+    }
+
+    // Streaming clipper with one reused PolygonBuffer.
+    PolygonBuffer scratch;
+    double streamBest = 1e30;
+    long streamAllocs = 0, streamVertices = 0;
+    for (int r = 0; r < reps; r++) {
+        long a0 = allocations;
+        streamVertices = 0;
+        Clock::time_point t0 = Clock::now();
+        for (int k = 0; k < count; k++) {
+            sutherlandHodgmanClipStream(polys[k].data(), (int)polys[k].size(),
+                winXmin, winXmax, winYmin, winYmax, scratch);
+            streamVertices += scratch.count;
+        }
+        double s = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (s < streamBest) streamBest = s;
+        streamAllocs = allocations - a0;
+    }
+
+    // Streaming clipper into a fixed stack buffer.
+    Point buffer[512];
+    double fixedBest = 1e30;
+    long fixedAllocs = 0, fixedVertices = 0;
+    for (int r = 0; r < reps; r++) {
+        long a0 = allocations;
+        fixedVertices = 0;
+        Clock::time_point t0 = Clock::now();
+        for (int k = 0; k < count; k++) {
+            fixedVertices += sutherlandHodgmanClipStream(polys[k].data(), (int)polys[k].size(),
+                winXmin, winXmax, winYmin, winYmax, buffer, 512);
+        }
+        double s = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (s < fixedBest) fixedBest = s;
+        fixedAllocs = allocations - a0;
+    }
+
+    int mismatches = 0;
+    for (int k = 0; k < count; k++) {
+        std::vector<Point> expect = hand::sutherlandHodgmanClip(polys[k], winXmin, winXmax, winYmin, winYmax);
+        int n = sutherlandHodgmanClipStream(polys[k].data(), (int)polys[k].size(),
+            winXmin, winXmax, winYmin, winYmax, buffer, 512);
+        if (!sameCycle(expect, buffer, n)) mismatches++;
+    }
+
+    printf("%-24s %8.1f ns/polygon  %6.2f allocs/polygon\n", "four-stage, hand-written",
+        refBest * 1e9 / count, (double)refAllocs / count);
+    printf("%-24s %8.1f ns/polygon  %6.2f allocs/polygon  x%.2f\n", "stream (PolygonBuffer)",
+        streamBest * 1e9 / count, (double)streamAllocs / count, refBest / streamBest);
+    printf("%-24s %8.1f ns/polygon  %6.2f allocs/polygon  x%.2f\n", "stream (stack buffer)",
+        fixedBest * 1e9 / count, (double)fixedAllocs / count, refBest / fixedBest);
+    printf("output vertices: %ld reference, %ld streamed, %ld stack buffer\n",
+        outVertices, streamVertices, fixedVertices);
+    benchCheck(mismatches == 0, "%d polygons differ from the reference", mismatches);
+    benchCheck(fixedAllocs == 0, "the stack-buffer clipper allocated");
+
+    // Templated clippers: clipPolygonEdge specialized per edge and point
+    // type, against the hand-written per-edge functions.
+    std::vector<std::vector<PointD> > polysD(count);
+    std::vector<std::vector<FixedPoint> > polysF(count);
+    for (int k = 0; k < count; k++)
+        for (Point p : polys[k]) {
+            polysD[k].push_back({ p.x, p.y });
+            polysF[k].push_back(toFixed(p));
+        }
+    const Fixed16 fxXmin = Fixed16::fromFloat(winXmin), fxXmax = Fixed16::fromFloat(winXmax);
+    const Fixed16 fxYmin = Fixed16::fromFloat(winYmin), fxYmax = Fixed16::fromFloat(winYmax);
+    long sink = 0;
+    auto row = [&](const char* name, double seconds) {
+        printf("%-24s %8.1f ns/polygon  x%.2f\n", name, seconds * 1e9 / count, refBest / seconds);
+    };
+    printf("templated clippers (speed-up over the hand-written four-stage)\n");
+    row("four-stage, float", bestSeconds(reps, [&]() {
+        for (int k = 0; k < count; k++)
+            sink += sutherlandHodgmanClip(polys[k], winXmin, winXmax, winYmin, winYmax).size();
+    }));
+    row("four-stage, double", bestSeconds(reps, [&]() {
+        for (int k = 0; k < count; k++)
+            sink += sutherlandHodgmanClip(polysD[k], (double)winXmin, (double)winXmax,
+                (double)winYmin, (double)winYmax).size();
+    }));
+    row("four-stage, fixed 16.16", bestSeconds(reps, [&]() {
+        for (int k = 0; k < count; k++)
+            sink += sutherlandHodgmanClip(polysF[k], fxXmin, fxXmax, fxYmin, fxYmax).size();
+    }));
+    PointD bufferD[512];
+    FixedPoint bufferF[512];
+    row("stream, float", bestSeconds(reps, [&]() {
+        for (int k = 0; k < count; k++)
+            sink += sutherlandHodgmanClipStream(polys[k].data(), (int)polys[k].size(),
+                winXmin, winXmax, winYmin, winYmax, buffer, 512);
+    }));
+    row("stream, double", bestSeconds(reps, [&]() {
+        for (int k = 0; k < count; k++)
+            sink += sutherlandHodgmanClipStream(polysD[k].data(), (int)polysD[k].size(),
+                (double)winXmin, (double)winXmax, (double)winYmin, (double)winYmax, bufferD, 512);
+    }));
+    row("stream, fixed 16.16", bestSeconds(reps, [&]() {
+        for (int k = 0; k < count; k++)
+            sink += sutherlandHodgmanClipStream(polysF[k].data(), (int)polysF[k].size(),
+                fxXmin, fxXmax, fxYmin, fxYmax, bufferF, 512);
+    }));
+
+    int differ = 0, mismatchedD = 0, mismatchedF = 0;
+    double deviationD = 0, deviationF = 0;
+    for (int k = 0; k < count; k++) {
+        std::vector<Point> expect = hand::sutherlandHodgmanClip(polys[k], winXmin, winXmax, winYmin, winYmax);
+        std::vector<Point> got = sutherlandHodgmanClip(polys[k], winXmin, winXmax, winYmin, winYmax);
+        if (got.size() != expect.size() || !sameCycle(expect, got.data(), (int)got.size()))
+            differ++;
+        deviationD = std::max(deviationD, maxDeviation(expect,
+            sutherlandHodgmanClip(polysD[k], (double)winXmin, (double)winXmax, (double)winYmin,
+                (double)winYmax), mismatchedD));
+        deviationF = std::max(deviationF, maxDeviation(expect,
+            sutherlandHodgmanClip(polysF[k], fxXmin, fxXmax, fxYmin, fxYmax), mismatchedF));
+    }
+    printf("float template: %s the hand-written output\n", differ ? "** differs from" : "identical to");
+    printf("double: max deviation %.2g px, %d polygons with other vertex counts\n", deviationD, mismatchedD);
+    printf("fixed:  max deviation %.2g px, %d polygons with other vertex counts\n", deviationF, mismatchedF);
+    benchCheck(differ == 0, "the float template differs from the hand-written clipper");
+    benchCheck(deviationD <= 1e-3 && deviationF <= 1e-3, "double or fixed-point vertices off by %.2g px",
+        std::max(deviationD, deviationF));
+    if (sink == 42) printf("\n");
+    return benchExit();
+}
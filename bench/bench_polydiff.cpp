@@ -0,0 +1,127 @@
+// Benchmark: "outside the window" by overdraw vs. by polygon difference.
+//
+//   g++ -O2 bench/bench_polydiff.cpp -o bench_polydiff
+//   ./bench_polydiff [--check] [polygons] [repetitions]
+//
+// Overdraw is how drawBall used to work: fill the whole polygon, clip it
+// to the window and fill the inside part again in the window color.
+// Difference fills only the pieces clipPolygonOutside returns. Both draw
+// over a checkerboard; the reference fills each polygon through four
+// pixel clip rectangles around the window, which only works for a
+// rectangle but has exact coverage.
+#include "../gfx/polyclip.h"
+#include "../gfx/softraster.h"
+#include "bench_util.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+double polygonArea(const Point* poly, int n) {
+    double area = 0;
+    for (int i = 0; i < n; i++) {
+        Point a = poly[i], b = poly[(i + 1) % n];
+        area += (double)a.x * b.y - (double)b.x * a.y;
+    }
+    return fabs(area) * 0.5;
+}
+
+long differingPixels(const Framebuffer& a, const Framebuffer& b) {
+    long n = 0;
+    for (size_t i = 0; i < a.pixels.size(); i++)
+        n += a.pixels[i] != b.pixels[i];
+    return n;
+}
+
+// Clip window of the playground scene.
+const float winXmin = 150, winXmax = 350, winYmin = 150, winYmax = 350;
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    int count = benchArg(argc, argv, 1, 5000, 300);
+    int reps = benchArg(argc, argv, 2, 20, 1);
+
+    // Circles of 20-64 segments scattered over the window, like drawBall.
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos(0.0f, 500.0f), rad(10.0f, 120.0f);
+    std::uniform_int_distribution<int> segs(20, 64), shade(1, 255);
+    std::vector<std::vector<Point> > polys(count);
+    std::vector<uint32_t> colors(count);
+    for (int k = 0; k < count; k++) {
+        float cx = pos(rng), cy = pos(rng), r = rad(rng);
+        int n = segs(rng);
+        for (int i = 0; i < n; i++) {
+            float theta = 2.0f * (float)M_PI * i / n;
+            polys[k].push_back({ cx + r * cosf(theta), cy + r * sinf(theta) });
+        }
+        colors[k] = packRGB(shade(rng), shade(rng), shade(rng));
+    }
+    printf("%d polygons outside [%g,%g] x [%g,%g], best of %d runs\n", count, winXmin, winXmax,
+        winYmin, winYmax, reps);
+
+    Framebuffer background(500, 500);
+    for (int y = 0; y < 500; y++)
+        for (int x = 0; x < 500; x++)
+            background.row(y)[x] = ((x / 10 + y / 10) & 1) ? packRGB(200, 200, 200) : packRGB(240, 240, 240);
+    const uint32_t gray = packColor(0.9f, 0.9f, 0.9f);
+    PixelRect all = background.bounds();
+
+    Framebuffer reference = background;
+    const PixelRect outside[4] = { { 0, 0, 150, 500 }, { 350, 0, 500, 500 },
+        { 150, 0, 350, 150 }, { 150, 350, 350, 500 } };
+    for (int k = 0; k < count; k++)
+        for (const PixelRect& rect : outside)
+            fillPolygon(reference, polys[k].data(), (int)polys[k].size(), colors[k], rect);
+
+    Framebuffer image;
+    Point inside[512];
+    double overdrawArea = 0;
+    double overdraw = bestSeconds(reps, [&]() {
+        image = background;
+        overdrawArea = 0;
+        for (int k = 0; k < count; k++) {
+            int n = (int)polys[k].size();
+            fillPolygon(image, polys[k].data(), n, colors[k], all);
+            int m = sutherlandHodgmanClipStream(polys[k].data(), n, winXmin, winXmax, winYmin, winYmax,
+                inside, 512);
+            fillPolygon(image, inside, m, gray, all);
+            overdrawArea += polygonArea(polys[k].data(), n) + polygonArea(inside, m);
+        }
+    });
+    long overdrawWrong = differingPixels(image, reference);
+
+    PolygonSet pieces;
+    double differenceArea = 0;
+    int pieceCount = 0;
+    double difference = bestSeconds(reps, [&]() {
+        image = background;
+        differenceArea = 0;
+        pieceCount = 0;
+        for (int k = 0; k < count; k++) {
+            clipPolygonOutside(polys[k].data(), (int)polys[k].size(), winXmin, winXmax, winYmin, winYmax,
+                pieces);
+            for (int i = 0; i < pieces.size(); i++) {
+                fillPolygon(image, pieces.polygon(i), pieces.count(i), colors[k], all);
+                differenceArea += polygonArea(pieces.polygon(i), pieces.count(i));
+            }
+            pieceCount += pieces.size();
+        }
+    });
+    long differenceWrong = differingPixels(image, reference);
+
+    double clipOnly = bestSeconds(reps, [&]() {
+        for (int k = 0; k < count; k++)
+            clipPolygonOutside(polys[k].data(), (int)polys[k].size(), winXmin, winXmax, winYmin, winYmax,
+                pieces);
+    });
+
+    printf("%-12s %8.1f ns/polygon  %8.0f px filled/polygon  %7ld px wrong\n", "overdraw",
+        overdraw * 1e9 / count, overdrawArea / count, overdrawWrong);
+    printf("%-12s %8.1f ns/polygon  %8.0f px filled/polygon  %7ld px wrong  x%.2f\n", "difference",
+        difference * 1e9 / count, differenceArea / count, differenceWrong, overdraw / difference);
+    printf("  %.2f pieces/polygon, %.1f ns/polygon to compute them\n", (double)pieceCount / count,
+        clipOnly * 1e9 / count);
+    benchCheck(differenceWrong == 0, "the polygon difference differs from the reference");
+    return benchExit();
+}
@@ -0,0 +1,95 @@
+// Benchmark: load time of large binary scene files.
+//
+//   g++ -O2 bench/bench_scenefile.cpp -lglut -o bench_scenefile
+//   ./bench_scenefile [--check] [million vertices] [repetitions] [path]
+//
+// Writes a generated scene of small triangle batches in a spread of
+// colors and clip boxes, then loads it three ways:
+//   open      MappedScene::open alone: map and check every record, which
+//             pages the whole vertex table in
+//   open+touch open and read one vertex per 4 KB page again
+//   fread     read the file into a Scene's vectors, the copying loader
+//             a text or per-record format would need at best, unchecked
+// The file stays in the page cache between runs, so these are warm-cache
+// times; a cold first open is bounded by the disk instead.
+#include "../gfx/scene_file.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    double millions = benchArg(argc, argv, 1, 4.0, 0.05);
+    int reps = benchArg(argc, argv, 2, 10, 1);
+    const char* path = argc > 3 ? argv[3] : "bench_scenefile.gfxs";
+
+    // Batches of 100 triangles, a new color every batch and a new clip
+    // box every 16, like a large scene recorded from many objects.
+    Scene scene;
+    SceneRecorder recorder(scene);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos(0.0f, 500.0f), shade(0.0f, 1.0f);
+    long target = (long)(millions * 1e6);
+    std::vector<Point> batch(300);
+    for (long k = 0; (long)scene.vertices.size() < target; k++) {
+        recorder.color(shade(rng), shade(rng), shade(rng));
+        if (k % 16 == 0) {
+            recorder.enableScissor(k % 32 == 0);
+            recorder.scissor((int)pos(rng) / 2, (int)pos(rng) / 2, 250, 250);
+        }
+        for (Point& p : batch)
+            p = { pos(rng), pos(rng) };
+        recorder.drawPrimitive(GL_TRIANGLES, batch.data(), (int)batch.size());
+    }
+    if (!writeSceneFile(scene, path)) {
+        fprintf(stderr, "could not write %s\n", path);
+        return 1;
+    }
+
+    MappedScene file;
+    if (!file.open(path)) {
+        fprintf(stderr, "%s: %s\n", path, file.error());
+        return 1;
+    }
+    printf("%s: %zu nodes, %zu vertices, %.1f MB, best of %d runs\n", path, file.nodeCount(),
+        file.vertexCount(), file.bytes() / 1048576.0, reps);
+    benchCheck(file.nodeCount() == scene.nodes.size() && file.vertexCount() == scene.vertices.size() &&
+        memcmp(file.vertices(), scene.vertices.data(), scene.vertices.size() * sizeof(Point)) == 0,
+        "the file does not hold the scene written");
+    file.close();
+
+    double open = bestSeconds(reps, [&]() { file.open(path); });
+    float sum = 0;
+    double touch = bestSeconds(reps, [&]() {
+        file.open(path);
+        const Point* v = file.vertices();
+        float s = 0;
+        for (size_t i = 0; i < file.vertexCount(); i += 4096 / sizeof(Point))
+            s += v[i].x;
+        sum = s;
+    });
+    Scene copy;
+    double copied = bestSeconds(reps, [&]() {
+        FILE* f = fopen(path, "rb");
+        SceneFileHeader h;
+        if (!f || fread(&h, sizeof h, 1, f) != 1) exit(1);
+        std::vector<SceneFileNode> nodes(h.nodes.count);
+        copy.vertices.resize(h.vertices.count);
+        fseek(f, (long)h.nodes.offset, SEEK_SET);
+        size_t n = fread(nodes.data(), sizeof(SceneFileNode), nodes.size(), f);
+        fseek(f, (long)h.vertices.offset, SEEK_SET);
+        n += fread(copy.vertices.data(), sizeof(Point), copy.vertices.size(), f);
+        fclose(f);
+        if (n != nodes.size() + copy.vertices.size()) exit(1);
+    });
+    printf("  %-10s %9.3f ms\n", "open", open * 1e3);
+    printf("  %-10s %9.3f ms  (checksum %.0f)\n", "open+touch", touch * 1e3, sum);
+    printf("  %-10s %9.3f ms\n", "fread", copied * 1e3);
+    benchCheck(copy.vertices.size() == scene.vertices.size() && memcmp(copy.vertices.data(),
+        scene.vertices.data(), scene.vertices.size() * sizeof(Point)) == 0,
+        "the vertices read back differ from the scene written");
+    remove(path);
+    return benchExit();
+}
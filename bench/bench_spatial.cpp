@@ -0,0 +1,133 @@
+// Benchmark: clipping a large scene with and without a BoxTree.
+//
+//   g++ -O2 bench/bench_spatial.cpp -o bench_spatial
+//   ./bench_spatial [--check] [objects] [repetitions]
+//
+// The scene is a 5000 x 5000 world of circles, each both a 32-segment
+// outline and a filled 32-gon, clipped to windows covering from 1% to
+// all of the world. "all" clips every segment with Cohen–Sutherland and
+// every polygon with Sutherland–Hodgman; "indexed" queries a BoxTree
+// built once over the segments and one over the polygons, passes the
+// primitives wholly inside through and clips only those crossing the
+// window edge. Both must produce the same segments and polygon areas.
+#include "../gfx/circle.h"
+#include "../gfx/clip.h"
+#include "../gfx/polyclip.h"
+#include "../gfx/spatial.h"
+#include "bench_util.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+double polygonArea(const Point* poly, int n) {
+    double area = 0;
+    for (int i = 0; i < n; i++) {
+        Point a = poly[i], b = poly[(i + 1) % n];
+        area += (double)a.x * b.y - (double)b.x * a.y;
+    }
+    return fabs(area) * 0.5;
+}
+
+struct Segment {
+    float x0, y0, x1, y1;
+    bool operator<(const Segment& o) const {
+        return x0 != o.x0 ? x0 < o.x0 : y0 != o.y0 ? y0 < o.y0 : x1 != o.x1 ? x1 < o.x1 : y1 < o.y1;
+    }
+    bool operator==(const Segment& o) const {
+        return x0 == o.x0 && y0 == o.y0 && x1 == o.x1 && y1 == o.y1;
+    }
+};
+
+struct Result {
+    std::vector<Segment> segments;
+    double area = 0;
+    long clips = 0;
+};
+
+const int SIDES = 32;
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    int count = benchArg(argc, argv, 1, 20000, 500);
+    int reps = benchArg(argc, argv, 2, 10, 1);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos(0.0f, 5000.0f), rad(5.0f, 40.0f);
+    std::vector<Point> polys(count * SIDES);
+    for (int k = 0; k < count; k++)
+        tessellateCircle(pos(rng), pos(rng), rad(rng), SIDES, &polys[k * SIDES]);
+    std::vector<Segment> segments(count * SIDES);
+    std::vector<ClipWindow> segmentBoxes(segments.size()), polygonBoxes(count);
+    for (int k = 0; k < count; k++) {
+        const Point* p = &polys[k * SIDES];
+        polygonBoxes[k] = boundsOf(p, SIDES);
+        for (int i = 0; i < SIDES; i++) {
+            Point a = p[i], b = p[(i + 1) % SIDES];
+            segments[k * SIDES + i] = { a.x, a.y, b.x, b.y };
+            segmentBoxes[k * SIDES + i] = segmentBounds(a, b);
+        }
+    }
+    BoxTree segmentTree, polygonTree;
+    double build = bestSeconds(1, [&]() {
+        segmentTree.build(segmentBoxes.data(), (int)segmentBoxes.size());
+        polygonTree.build(polygonBoxes.data(), count);
+    });
+    printf("%d circles: %zu segments and %d polygons of %d sides, trees built in %.1f ms, best of %d runs\n",
+        count, segments.size(), count, SIDES, build * 1e3, reps);
+    printf("%-7s %7s %12s %12s %9s %12s %12s %9s  %s\n", "window", "visible", "all ms",
+        "indexed ms", "speedup", "all clips", "idx clips", "clip work", "same");
+
+    Point buffer[2 * SIDES + 8];
+    std::vector<int> inside, crossing;
+    for (float fraction : { 0.01f, 0.05f, 0.25f, 1.0f }) {
+        float side = 5000.0f * std::sqrt(fraction), lo = 2500.0f - side / 2, hi = 2500.0f + side / 2;
+        ClipWindow window = { lo, hi, lo, hi };
+
+        auto clipSegment = [&](const Segment& s, Result& r) {
+            float x0 = s.x0, y0 = s.y0, x1 = s.x1, y1 = s.y1;
+            r.clips++;
+            if (cohenSutherlandClip(x0, y0, x1, y1, window.xmin, window.xmax, window.ymin, window.ymax))
+                r.segments.push_back({ x0, y0, x1, y1 });
+        };
+        auto clipPolygon = [&](int k, Result& r) {
+            r.clips++;
+            int n = sutherlandHodgmanClipStream(&polys[k * SIDES], SIDES, window.xmin, window.xmax,
+                window.ymin, window.ymax, buffer, 2 * SIDES + 8);
+            r.area += polygonArea(buffer, n);
+        };
+
+        Result all, indexed;
+        double allTime = bestSeconds(reps, [&]() {
+            all = Result();
+            for (const Segment& s : segments)
+                clipSegment(s, all);
+            for (int k = 0; k < count; k++)
+                clipPolygon(k, all);
+        });
+        double indexedTime = bestSeconds(reps, [&]() {
+            indexed = Result();
+            segmentTree.query(window, inside, crossing);
+            for (int i : inside)
+                indexed.segments.push_back(segments[i]);
+            for (int i : crossing)
+                clipSegment(segments[i], indexed);
+            polygonTree.query(window, inside, crossing);
+            for (int k : inside)
+                indexed.area += polygonArea(&polys[k * SIDES], SIDES);
+            for (int k : crossing)
+                clipPolygon(k, indexed);
+        });
+        std::sort(all.segments.begin(), all.segments.end());
+        std::sort(indexed.segments.begin(), indexed.segments.end());
+        bool same = all.segments == indexed.segments &&
+            fabs(all.area - indexed.area) <= 1e-9 * std::max(1.0, all.area);
+        printf("%6.0f%% %6zuk %12.3f %12.3f %8.1fx %12ld %12ld %8.2f%%  %s\n", fraction * 100,
+            all.segments.size() / 1000, allTime * 1e3, indexedTime * 1e3, allTime / indexedTime,
+            all.clips, indexed.clips, 100.0 * indexed.clips / all.clips, same ? "yes" : "NO");
+        benchCheck(same, "%.0f%% window: the indexed clip differs", fraction * 100);
+    }
+    return benchExit();
+}
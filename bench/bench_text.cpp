@@ -0,0 +1,146 @@
+// Benchmark: clipped captions drawn character by character, through the
+// glyph atlas with layouts made once, and as one batch of triangles
+// clipped geometrically (to the board and to a convex octagon).
+//
+//   g++ -O2 bench/bench_text.cpp -o bench_text
+//   ./bench_text [--check] [captions] [repetitions]
+//
+// Captions are scattered over the window and clipped to the classroom
+// board, so most glyphs are culled and some are cut by its edge.
+#include "../gfx/soft_backend.h"
+#include "bench_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// Clip window used by the classroom scenes.
+const int boardX = 100, boardY = 300, boardW = 300, boardH = 150;
+
+struct Caption {
+    std::string text;
+    float x, y;
+};
+
+void report(const char* name, int n, double seconds, double baseline, bool same) {
+    printf("%-28s %8.2f us/caption  x%.2f\n", name, seconds * 1e6 / n, baseline / seconds);
+    benchCheck(same, "%s differs from the per-character image", name);
+}
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    int count = benchArg(argc, argv, 1, 2000, 100);
+    int reps = benchArg(argc, argv, 2, 20, 1);
+
+    std::mt19937 rng(11);
+    // Pens on whole pixels, where bitmaps and geometry cover the same pixels.
+    std::uniform_int_distribution<int> posX(0, 480), posY(0, 480);
+    std::uniform_int_distribution<int> length(20, 80), letter(32, 126);
+    std::vector<Caption> captions(count);
+    long characters = 0;
+    for (Caption& c : captions) {
+        int n = length(rng);
+        for (int i = 0; i < n; i++)
+            c.text += (char)letter(rng);
+        c.x = (float)posX(rng);
+        c.y = (float)posY(rng);
+        characters += n;
+    }
+    printf("%d captions, %ld characters, best of %d runs\n", count, characters, reps);
+
+    SoftwareBackend backend(500, 500);
+    backend.scissor(boardX, boardY, boardW, boardH);
+    backend.enableScissor(true);
+    Framebuffer& fb = backend.framebuffer();
+    auto frame = [&](auto draw) {
+        return bestSeconds(reps, [&]() {
+            fb.fill(0, fb.bounds());
+            draw();
+        });
+    };
+
+    // As drawClippedText used to: strlen on every iteration, one
+    // bitmapCharacter per character.
+    double perChar = frame([&]() {
+        for (const Caption& c : captions) {
+            const char* text = c.text.c_str();
+            backend.rasterPos(c.x, c.y);
+            for (int i = 0; i < (int)strlen(text); i++)
+                backend.bitmapCharacter(nullptr, text[i]);
+        }
+    });
+    std::vector<uint32_t> expect = fb.pixels;
+    report("per character", count, perChar, perChar, true);
+
+    std::vector<TextLayout> layouts;
+    for (const Caption& c : captions)
+        layouts.push_back(layoutText(c.text.c_str()));
+    double atlas = frame([&]() {
+        for (int i = 0; i < count; i++)
+            backend.drawText(captions[i].x, captions[i].y, layouts[i]);
+    });
+    report("atlas, layout once", count, atlas, perChar, fb.pixels == expect);
+
+    double relayout = frame([&]() {
+        for (const Caption& c : captions) {
+            TextLayout layout = layoutText(c.text.c_str());
+            backend.drawText(c.x, c.y, layout);
+        }
+    });
+    report("atlas, layout every frame", count, relayout, perChar, fb.pixels == expect);
+
+    // The whole page as one GL_TRIANGLES draw, clipped without the scissor.
+    backend.enableScissor(false);
+    ConvexRegion board = makeRectRegion(boardX, boardX + boardW, boardY, boardY + boardH);
+    TextMesh mesh;
+    auto buildMesh = [&](const ConvexRegion& region) {
+        mesh.clear();
+        for (int i = 0; i < count; i++)
+            appendTextGeometry(mesh, layouts[i], captions[i].x, captions[i].y, region);
+    };
+    double build = bestSeconds(reps, [&]() { buildMesh(board); });
+    report("geometry, build mesh", count, build, perChar, true);
+    double geometry = frame([&]() {
+        buildMesh(board);
+        backend.drawPrimitive(GL_TRIANGLES, mesh.triangles.data(), (int)mesh.triangles.size());
+    });
+    report("geometry, build and draw", count, geometry, perChar, fb.pixels == expect);
+    printf("  %d triangles in one draw\n", (int)mesh.triangles.size() / 3);
+
+    // An octagon inscribed in the board: edges that a scissor cannot express.
+    const float cut = 40;
+    Point octagon[8] = {
+        { boardX + cut, boardY }, { boardX + boardW - cut, boardY },
+        { boardX + boardW, boardY + cut }, { boardX + boardW, boardY + boardH - cut },
+        { boardX + boardW - cut, boardY + boardH }, { boardX + cut, boardY + boardH },
+        { boardX, boardY + boardH - cut }, { boardX, boardY + cut },
+    };
+    ConvexRegion octagonRegion = makeConvexRegion(octagon, 8);
+    double octagonTime = frame([&]() {
+        buildMesh(octagonRegion);
+        backend.drawPrimitive(GL_TRIANGLES, mesh.triangles.data(), (int)mesh.triangles.size());
+    });
+    report("geometry, octagon", count, octagonTime, perChar, true);
+    printf("  %d triangles in one draw\n", (int)mesh.triangles.size() / 3);
+
+    // Without the scissor nothing is culled: the cost of the run fill alone.
+    double unclippedChar = frame([&]() {
+        for (const Caption& c : captions) {
+            const char* text = c.text.c_str();
+            backend.rasterPos(c.x, c.y);
+            for (int i = 0; i < (int)strlen(text); i++)
+                backend.bitmapCharacter(nullptr, text[i]);
+        }
+    });
+    expect = fb.pixels;
+    printf("unclipped\n");
+    report("per character", count, unclippedChar, unclippedChar, true);
+    double unclippedAtlas = frame([&]() {
+        for (int i = 0; i < count; i++)
+            backend.drawText(captions[i].x, captions[i].y, layouts[i]);
+    });
+    report("atlas, layout once", count, unclippedAtlas, unclippedChar, fb.pixels == expect);
+    return benchExit();
+}
@@ -0,0 +1,173 @@
+// Benchmark: triangulating concave polygons, monotone sweep vs. ear
+// clipping.
+//
+//   g++ -O2 bench/bench_triangulate.cpp -o bench_triangulate
+//   ./bench_triangulate [--check] [max vertices] [repetitions]
+//
+// Star polygons (random radius per vertex) and combs of 1k to 100k
+// vertices. The Triangulator's time per vertex should grow only with
+// log n; the ear clipper below, which scans every vertex for each ear,
+// grows with n and is only run up to 10k vertices. Every triangulation
+// is checked: the triangles must cover the polygon's area, and filling
+// them must give the same pixels as the even-odd scanline fill, apart
+// from pixels whose centers lie on a shared diagonal. Reusing one
+// Triangulator must not allocate after the first polygon.
+#define BENCH_COUNT_ALLOCATIONS
+#include "../gfx/softraster.h"
+#include "../gfx/triangulate.h"
+#include "bench_util.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+double signedArea(const Point* poly, int n) {
+    double area = 0;
+    for (int i = 0; i < n; i++) {
+        Point a = poly[i], b = poly[(i + 1) % n];
+        area += (double)a.x * b.y - (double)b.x * a.y;
+    }
+    return area * 0.5;
+}
+
+// O(n^2) ear clipping on a counterclockwise polygon: cut off the first
+// convex vertex whose triangle contains no other vertex.
+int earClip(const std::vector<Point>& poly, std::vector<int>& tris) {
+    std::vector<int> ring(poly.size());
+    for (size_t i = 0; i < ring.size(); i++) ring[i] = (int)i;
+    if (signedArea(poly.data(), (int)poly.size()) < 0) std::reverse(ring.begin(), ring.end());
+    auto cross = [&](int a, int b, int c) {
+        Point p = poly[a], q = poly[b], r = poly[c];
+        return ((double)q.x - p.x) * ((double)r.y - q.y) - ((double)q.y - p.y) * ((double)r.x - q.x);
+    };
+    tris.clear();
+    size_t i = 0;
+    int stall = 0;
+    while (ring.size() > 3 && stall < (int)ring.size()) {
+        size_t n = ring.size();
+        int a = ring[(i + n - 1) % n], b = ring[i % n], c = ring[(i + 1) % n];
+        bool ear = cross(a, b, c) > 0;
+        for (size_t k = 0; ear && k < n; k++) {
+            int v = ring[k];
+            if (v == a || v == b || v == c) continue;
+            ear = !(cross(a, b, v) >= 0 && cross(b, c, v) >= 0 && cross(c, a, v) >= 0);
+        }
+        if (ear) {
+            tris.push_back(a);
+            tris.push_back(b);
+            tris.push_back(c);
+            ring.erase(ring.begin() + i % n);
+            stall = 0;
+        }
+        else {
+            i++;
+            stall++;
+        }
+    }
+    if (ring.size() == 3) {
+        tris.push_back(ring[0]);
+        tris.push_back(ring[1]);
+        tris.push_back(ring[2]);
+    }
+    return (int)tris.size() / 3;
+}
+
+std::vector<Point> star(int n, std::mt19937& rng) {
+    std::uniform_real_distribution<float> rad(20.0f, 240.0f);
+    std::vector<Point> poly(n);
+    for (int i = 0; i < n; i++) {
+        float theta = 2.0f * (float)M_PI * i / n, r = rad(rng);
+        poly[i] = { 250.0f + r * cosf(theta), 250.0f + r * sinf(theta) };
+    }
+    return poly;
+}
+
+// Teeth hanging from a bar: about n / 4 split and merge vertices.
+std::vector<Point> comb(int n) {
+    int teeth = std::max(1, (n - 2) / 4);
+    float width = 480.0f / teeth;
+    std::vector<Point> poly;
+    poly.push_back({ 10.0f, 490.0f });
+    for (int i = 0; i < teeth; i++) {
+        float x = 10.0f + i * width;
+        poly.push_back({ x, 10.0f });
+        poly.push_back({ x + width * 0.5f, 10.0f });
+        poly.push_back({ x + width * 0.5f, 400.0f });
+        poly.push_back({ x + width, 400.0f });
+    }
+    poly.back().x = 490.0f;
+    poly.push_back({ 490.0f, 490.0f });
+    return poly;
+}
+
+// Area mismatch and differing pixels of a triangulation.
+void check(const std::vector<Point>& poly, const std::vector<int>& tris, double& areaError, long& pixels) {
+    double area = fabs(signedArea(poly.data(), (int)poly.size())), sum = 0;
+    Framebuffer even(500, 500), triangles(500, 500);
+    PixelRect clip = even.bounds();
+    fillPolygon(even, poly.data(), (int)poly.size(), 0xffffffffu, clip);
+    for (size_t i = 0; i < tris.size(); i += 3) {
+        Point t[3] = { poly[tris[i]], poly[tris[i + 1]], poly[tris[i + 2]] };
+        sum += signedArea(t, 3);
+        fillPolygon(triangles, t, 3, 0xffffffffu, clip);
+    }
+    areaError = fabs(sum - area) / area;
+    pixels = 0;
+    for (size_t i = 0; i < even.pixels.size(); i++)
+        pixels += even.pixels[i] != triangles.pixels[i];
+}
+
+int main(int argc, char** argv) {
+    parseBenchCheck(argc, argv);
+    int maxVertices = benchArg(argc, argv, 1, 100000, 1000);
+    int reps = benchArg(argc, argv, 2, 5, 1);
+    std::mt19937 rng(7);
+    Triangulator triangulator;
+    std::vector<int> earTris;
+    printf("best of %d runs\n", reps);
+    printf("%-6s %8s %10s %11s %11s %10s %8s\n", "shape", "vertices", "triangles", "sweep ns/v",
+        "ear ns/v", "area err", "px diff");
+
+    for (int shape = 0; shape < 2; shape++)
+        for (int n = 1000; n <= maxVertices; n *= 10) {
+            std::vector<Point> poly = shape == 0 ? star(n, rng) : comb(n);
+            int count = (int)poly.size(), triangles = 0;
+            double sweep = bestSeconds(reps, [&]() { triangles = triangulator.triangulate(poly.data(), count); });
+            double areaError;
+            long pixels;
+            check(poly, triangulator.indices(), areaError, pixels);
+            char ear[32] = "-";
+            if (n <= 10000) {
+                double t = bestSeconds(1, [&]() { earClip(poly, earTris); });
+                snprintf(ear, sizeof ear, "%.1f", t * 1e9 / count);
+            }
+            printf("%-6s %8d %10d %11.1f %11s %10.1e %8ld\n", shape == 0 ? "star" : "comb", count,
+                triangles, sweep * 1e9 / count, ear, areaError, pixels);
+            benchCheck(areaError <= 1e-6, "%d-vertex %s: the triangles miss %.1e of the area", count,
+                shape == 0 ? "star" : "comb", areaError);
+        }
+
+    // Reuse: many small concave polygons, as a scene would draw per frame.
+    std::vector<std::vector<Point> > small;
+    for (int k = 0; k < 1000; k++) small.push_back(star(8 + k % 57, rng));
+    std::vector<Point> batch;
+    long before = allocations;
+    for (const std::vector<Point>& poly : small) {
+        batch.clear();
+        triangulator.appendTriangles(poly.data(), (int)poly.size(), batch);
+    }
+    long warm = allocations - before;
+    before = allocations;
+    double perPolygon = bestSeconds(reps, [&]() {
+        for (const std::vector<Point>& poly : small) {
+            batch.clear();
+            triangulator.appendTriangles(poly.data(), (int)poly.size(), batch);
+        }
+    });
+    long reused = allocations - before;
+    printf("1000 stars of 8-64 vertices: %.1f ns/polygon, %ld allocations the first time, %ld after\n",
+        perPolygon * 1e9 / small.size(), warm, reused);
+    benchCheck(reused == 0, "a reused Triangulator allocated");
+    return benchExit();
+}
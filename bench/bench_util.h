@@ -0,0 +1,93 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Harness shared by the benchmarks: best-of-N timing, counting of heap
+// allocations and the --check mode ctest runs.
+//
+//   ./bench_x --check [arguments]
+//
+// With --check first, the sizes and repetitions not given default to a
+// small problem run once, and the exit status is 1 when any result the
+// benchmark verifies (benchCheck) was wrong, so the timing code doubles
+// as a correctness test of what it times.
+//
+// A benchmark that defines BENCH_COUNT_ALLOCATIONS before including this
+// header replaces the global operator new, and `allocations` counts
+// every heap allocation of the program.
+// ---------------------------------------------------------------------
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+typedef std::chrono::steady_clock Clock;
+
+template <class F>
+double bestSeconds(int reps, F run) {
+    double best = 1e30;
+    for (int r = 0; r < reps; r++) {
+        Clock::time_point t0 = Clock::now();
+        run();
+        double s = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (s < best) best = s;
+    }
+    return best;
+}
+
+inline bool checkMode = false;
+inline int checkFailures = 0;
+
+// Remove a leading --check from the arguments and remember it.
+inline void parseBenchCheck(int& argc, char**& argv) {
+    if (argc > 1 && strcmp(argv[1], "--check") == 0) {
+        checkMode = true;
+        argv[1] = argv[0];
+        argv++;
+        argc--;
+    }
+}
+
+// Positional argument i: as given, else the default for the mode.
+inline int benchArg(int argc, char** argv, int i, int normal, int check) {
+    return argc > i ? atoi(argv[i]) : checkMode ? check : normal;
+}
+
+inline double benchArg(int argc, char** argv, int i, double normal, double check) {
+    return argc > i ? atof(argv[i]) : checkMode ? check : normal;
+}
+
+// A result that must hold; prints the message, printf-style, when not.
+inline bool benchCheck(bool ok, const char* format, ...) {
+    if (ok) return true;
+    checkFailures++;
+    va_list args;
+    va_start(args, format);
+    printf("** ");
+    vprintf(format, args);
+    printf("\n");
+    va_end(args);
+    return false;
+}
+
+// Exit status of main: 1 when a check failed.
+inline int benchExit() {
+    if (checkFailures)
+        printf("** %d check(s) failed\n", checkFailures);
+    else if (checkMode)
+        printf("all checks passed\n");
+    return checkFailures ? 1 : 0;
+}
+
+#ifdef BENCH_COUNT_ALLOCATIONS
+inline long allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+#endif
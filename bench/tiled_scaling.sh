@@ -0,0 +1,32 @@
+#!/bin/sh
+# Thread scaling of the tiled software rasterizer.
+#
+#   bench/tiled_scaling.sh [size] [frames] [max threads]
+#
+# Renders each scene headless at size x size with 1..N threads, prints the
+# frame time and checks every image against the single-threaded untiled
+# render. Expects the demo binaries (playground, classroom, textclip) in
+# the current directory or in $BIN.
+SIZE=${1:-4000}
+FRAMES=${2:-20}
+MAX=${3:-$(nproc)}
+BIN=${BIN:-.}
+OUT=${TMPDIR:-/tmp}/tiled_scaling.$$
+mkdir -p "$OUT"
+status=0
+
+for scene in playground classroom textclip; do
+    "$BIN/$scene" --headless "$OUT/$scene-ref.ppm" --size ${SIZE}x${SIZE} --untiled --repeat "$FRAMES" || exit 1
+    t=1
+    while [ "$t" -le "$MAX" ]; do
+        "$BIN/$scene" --headless "$OUT/$scene-$t.ppm" --size ${SIZE}x${SIZE} --threads "$t" --repeat "$FRAMES" || exit 1
+        if ! cmp -s "$OUT/$scene-ref.ppm" "$OUT/$scene-$t.ppm"; then
+            echo "  ** $scene with $t thread(s) differs from the untiled render"
+            status=1
+        fi
+        t=$((t + 1))
+    done
+done
+
+rm -rf "$OUT"
+exit $status
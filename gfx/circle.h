@@ -0,0 +1,101 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Circle tessellation without per-vertex trigonometry.
+// The segment counts the scenes use (20, 30, 40, 50) come from unit-circle
+// tables built at compile time; any other count steps a rotation
+// recurrence. Neither path calls libm.
+//
+// Table angles are rounded to float before taking cos/sin, exactly as the
+// original "float theta = 2.0f * M_PI * i / segments" loops did, and the
+// vertex is formed in double, so tabulated circles reproduce those loops'
+// vertices bit for bit.
+// ---------------------------------------------------------------------
+#include "geom.h"
+
+namespace circle_detail {
+
+constexpr double PI = 3.14159265358979323846;
+// pi/2 split in two so that the quadrant reduction keeps full precision.
+constexpr double HALF_PI_HI = 1.5707963267948966;
+constexpr double HALF_PI_LO = 6.123233995736766e-17;
+
+// Taylor series on |x| <= pi/4 in nested form, smallest term first.
+constexpr double sinSeries(double x) {
+    double x2 = x * x, t = 1;
+    for (int k = 11; k >= 1; k--)
+        t = 1 - x2 / ((2 * k) * (2 * k + 1)) * t;
+    return x * t;
+}
+constexpr double cosSeries(double x) {
+    double x2 = x * x, t = 1;
+    for (int k = 11; k >= 1; k--)
+        t = 1 - x2 / ((2 * k - 1) * (2 * k)) * t;
+    return t;
+}
+
+// cos and sin of x in [0, 2*pi], reduced to the nearest quadrant.
+constexpr void sinCos(double x, double& c, double& s) {
+    int q = (int)(x / HALF_PI_HI + 0.5);
+    double r = (x - q * HALF_PI_HI) - q * HALF_PI_LO;
+    double sr = sinSeries(r), cr = cosSeries(r);
+    switch (q & 3) {
+    case 0: c = cr; s = sr; break;
+    case 1: c = -sr; s = cr; break;
+    case 2: c = -cr; s = -sr; break;
+    default: c = sr; s = -cr; break;
+    }
+}
+
+} // namespace circle_detail
+
+template<int N>
+struct UnitCircle {
+    double cosTable[N];
+    double sinTable[N];
+
+    constexpr UnitCircle() : cosTable(), sinTable() {
+        for (int i = 0; i < N; i++) {
+            float theta = (float)(2.0f * circle_detail::PI * i / N);
+            circle_detail::sinCos(theta, cosTable[i], sinTable[i]);
+        }
+    }
+};
+
+template<int N>
+inline constexpr UnitCircle<N> UNIT_CIRCLE{};
+
+template<int N>
+inline void tessellateCircleTable(float cx, float cy, float r, Point* out) {
+    const UnitCircle<N>& t = UNIT_CIRCLE<N>;
+    for (int i = 0; i < N; i++)
+        out[i] = { (float)(cx + r * t.cosTable[i]), (float)(cy + r * t.sinTable[i]) };
+}
+
+// Steps (cos, sin) by a fixed rotation per vertex. Accumulating in double
+// keeps the drift far below float precision for any practical count.
+inline void tessellateCircleRotation(float cx, float cy, float r, int segments, Point* out) {
+    double cd, sd;
+    circle_detail::sinCos(2.0 * circle_detail::PI / segments, cd, sd);
+    double c = 1.0, s = 0.0;
+    for (int i = 0; i < segments; i++) {
+        out[i] = { (float)(cx + r * c), (float)(cy + r * s) };
+        double next = c * cd - s * sd;
+        s = s * cd + c * sd;
+        c = next;
+    }
+}
+
+// Write the 'segments' vertices of a circle, counter-clockwise from angle 0,
+// to out (which must hold at least 'segments' points).
+inline void tessellateCircle(float cx, float cy, float r, int segments, Point* out) {
+    switch (segments) {
+    case 20: tessellateCircleTable<20>(cx, cy, r, out); break;
+    case 30: tessellateCircleTable<30>(cx, cy, r, out); break;
+    case 40: tessellateCircleTable<40>(cx, cy, r, out); break;
+    case 50: tessellateCircleTable<50>(cx, cy, r, out); break;
+    default:
+        if (segments > 0)
+            tessellateCircleRotation(cx, cy, r, segments, out);
+        break;
+    }
+}
@@ -0,0 +1,141 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Line clipping against an axis-aligned rectangle.
+// Both clippers take the window as arguments and keep no other state, so
+// they work for any rectangle and from any thread. Points on the window
+// edge count as inside, and the two can be swapped freely.
+// Cohen–Sutherland also runs on 16.16 fixed-point coordinates (Fixed16),
+// where it is exact integer arithmetic and clips identically everywhere.
+// ---------------------------------------------------------------------
+#include "fixed.h"
+#include <algorithm>
+
+// Clip rectangle [xmin, xmax] x [ymin, ymax], e.g. one panel of a layout.
+struct ClipWindow {
+    float xmin, xmax, ymin, ymax;
+};
+
+// Cohen–Sutherland region codes
+const int INSIDE = 0; // 0000
+const int LEFT = 1; // 0001
+const int RIGHT = 2; // 0010
+const int BOTTOM = 4; // 0100
+const int TOP = 8; // 1000
+
+// Compute the region code for a point (x, y)
+template <class T>
+inline int computeOutCode(T x, T y, T xmin, T xmax, T ymin, T ymax) {
+    int code = INSIDE;
+    if (x < xmin) code |= LEFT;
+    else if (x > xmax) code |= RIGHT;
+    if (y < ymin) code |= BOTTOM;
+    else if (y > ymax) code |= TOP;
+    return code;
+}
+
+// a0 + (a1 - a0) * num / den: the other coordinate where a segment
+// meets a window edge.
+inline float edgeCrossing(float a0, float a1, float num, float den) {
+    return a0 + (a1 - a0) * num / den;
+}
+
+inline Fixed16 edgeCrossing(Fixed16 a0, Fixed16 a1, Fixed16 num, Fixed16 den) {
+    return a0 + mulDiv(a1 - a0, num, den);
+}
+
+// Cohen–Sutherland line clipping algorithm, for float or Fixed16.
+// Modifies (x0,y0)-(x1,y1) if the line is partially inside the clip rectangle.
+template <class T>
+inline bool cohenSutherlandClip(T& x0, T& y0, T& x1, T& y1, T xmin, T xmax, T ymin, T ymax) {
+    int code0 = computeOutCode(x0, y0, xmin, xmax, ymin, ymax);
+    int code1 = computeOutCode(x1, y1, xmin, xmax, ymin, ymax);
+
+    while (true) {
+        if ((code0 | code1) == 0) {
+            // Both endpoints inside: accept the line.
+            return true;
+        }
+        if (code0 & code1) {
+            // Both endpoints share an outside zone (trivial reject).
+            return false;
+        }
+        // At least one endpoint is outside: move it onto the edge it
+        // crosses, testing edges in the order top, bottom, right, left.
+        int outCode = code0 ? code0 : code1;
+        T x, y;
+        if (outCode & TOP) {
+            x = edgeCrossing(x0, x1, ymax - y0, y1 - y0);
+            y = ymax;
+        }
+        else if (outCode & BOTTOM) {
+            x = edgeCrossing(x0, x1, ymin - y0, y1 - y0);
+            y = ymin;
+        }
+        else if (outCode & RIGHT) {
+            y = edgeCrossing(y0, y1, xmax - x0, x1 - x0);
+            x = xmax;
+        }
+        else {
+            y = edgeCrossing(y0, y1, xmin - x0, x1 - x0);
+            x = xmin;
+        }
+        if (outCode == code0) {
+            x0 = x; y0 = y;
+            code0 = computeOutCode(x0, y0, xmin, xmax, ymin, ymax);
+        }
+        else {
+            x1 = x; y1 = y;
+            code1 = computeOutCode(x1, y1, xmin, xmax, ymin, ymax);
+        }
+    }
+}
+
+// Liang–Barsky: clip the parametric segment P(t) = P0 + t (P1 - P0),
+// t in [0, 1], by intersecting it with the x and y slabs of the window.
+// Each slab narrows [t0, t1] with one reciprocal and min/max instead of
+// the outcode loop. Segments entirely inside, or entirely beyond one
+// edge, are settled by min/max tests before any division.
+// Modifies (x0,y0)-(x1,y1) and returns true if any part lies inside.
+inline bool liangBarskyClip(float& x0, float& y0, float& x1, float& y1,
+    float xmin, float xmax, float ymin, float ymax) {
+    bool inside = (std::min(x0, x1) >= xmin) & (std::max(x0, x1) <= xmax) &
+        (std::min(y0, y1) >= ymin) & (std::max(y0, y1) <= ymax);
+    if (inside) return true;
+    bool outside = (std::max(x0, x1) < xmin) | (std::min(x0, x1) > xmax) |
+        (std::max(y0, y1) < ymin) | (std::min(y0, y1) > ymax);
+    if (outside) return false;
+
+    float dx = x1 - x0, dy = y1 - y0;
+    float t0 = 0.0f, t1 = 1.0f;
+    if (dx != 0.0f) {
+        float inv = 1.0f / dx;
+        float ta = (xmin - x0) * inv, tb = (xmax - x0) * inv;
+        t0 = std::max(t0, std::min(ta, tb));
+        t1 = std::min(t1, std::max(ta, tb));
+    }
+    else if (x0 < xmin || x0 > xmax) {
+        return false;   // vertical and outside
+    }
+    if (dy != 0.0f) {
+        float inv = 1.0f / dy;
+        float ta = (ymin - y0) * inv, tb = (ymax - y0) * inv;
+        t0 = std::max(t0, std::min(ta, tb));
+        t1 = std::min(t1, std::max(ta, tb));
+    }
+    else if (y0 < ymin || y0 > ymax) {
+        return false;   // horizontal and outside
+    }
+    if (t0 > t1) return false;
+
+    // Endpoints that were not clipped keep their exact values.
+    float nx0 = x0 + t0 * dx, ny0 = y0 + t0 * dy;
+    if (t1 < 1.0f) {
+        x1 = x0 + t1 * dx;
+        y1 = y0 + t1 * dy;
+    }
+    if (t0 > 0.0f) {
+        x0 = nx0;
+        y0 = ny0;
+    }
+    return true;
+}
@@ -0,0 +1,175 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Batched Cohen–Sutherland line clipping over structure-of-arrays input.
+// Segments are processed SimdNative::WIDTH at a time (8 with AVX2, 4 with
+// SSE2); the leftover tail goes through the same kernel with one lane.
+// Each lane follows exactly the steps of the scalar algorithm (same edge
+// priority TOP, BOTTOM, RIGHT, LEFT and the same intersection formulas),
+// so results match a scalar cohenSutherlandClip bit for bit.
+// cohenSutherlandClipWindows clips one batch against several windows
+// (e.g. the panels of a layout) in a single pass over the input.
+// ---------------------------------------------------------------------
+#include "clip.h"
+#include "simd.h"
+#include <cstddef>
+
+// Clip one group of V::WIDTH segments. Outcode bits are kept as four lane
+// masks per endpoint instead of an integer code.
+template <class V>
+inline void cohenSutherlandClipLanes(const float* x0, const float* y0,
+    const float* x1, const float* y1,
+    float xmin, float xmax, float ymin, float ymax,
+    float* outX0, float* outY0, float* outX1, float* outY1,
+    unsigned char* accept)
+{
+    typedef typename V::F F;
+    typedef typename V::M M;
+    const F vxmin = V::set1(xmin), vxmax = V::set1(xmax);
+    const F vymin = V::set1(ymin), vymax = V::set1(ymax);
+
+    F X0 = V::load(x0), Y0 = V::load(y0);
+    F X1 = V::load(x1), Y1 = V::load(y1);
+    M left0 = V::lt(X0, vxmin), right0 = V::gt(X0, vxmax);
+    M bottom0 = V::lt(Y0, vymin), top0 = V::gt(Y0, vymax);
+    M left1 = V::lt(X1, vxmin), right1 = V::gt(X1, vxmax);
+    M bottom1 = V::lt(Y1, vymin), top1 = V::gt(Y1, vymax);
+
+    M accepted = V::maskFalse();
+    M active = V::maskTrue();
+    while (true) {
+        M out0 = V::maskOr(V::maskOr(left0, right0), V::maskOr(bottom0, top0));
+        M out1 = V::maskOr(V::maskOr(left1, right1), V::maskOr(bottom1, top1));
+        // Both endpoints inside: accept.
+        M inside = V::maskAndNot(V::maskTrue(), V::maskOr(out0, out1));
+        // Both endpoints share an outside zone: trivial reject.
+        M shared = V::maskOr(
+            V::maskOr(V::maskAnd(left0, left1), V::maskAnd(right0, right1)),
+            V::maskOr(V::maskAnd(bottom0, bottom1), V::maskAnd(top0, top1)));
+        accepted = V::maskOr(accepted, V::maskAnd(active, inside));
+        active = V::maskAndNot(active, V::maskOr(inside, shared));
+        if (!V::any(active))
+            break;
+
+        // Pick the outside endpoint (endpoint 0 first, as in the scalar code).
+        M top = V::selectMask(out0, top0, top1);
+        M bottom = V::selectMask(out0, bottom0, bottom1);
+        M right = V::selectMask(out0, right0, right1);
+        M horizontalEdge = V::maskOr(top, bottom);
+        F yEdge = V::select(top, vymax, vymin);
+        F xEdge = V::select(right, vxmax, vxmin);
+        F dx = V::sub(X1, X0), dy = V::sub(Y1, Y0);
+        // x = x0 + (x1 - x0) * (yEdge - y0) / (y1 - y0)
+        F xOnY = V::add(X0, V::div(V::mul(dx, V::sub(yEdge, Y0)), dy));
+        // y = y0 + (y1 - y0) * (xEdge - x0) / (x1 - x0)
+        F yOnX = V::add(Y0, V::div(V::mul(dy, V::sub(xEdge, X0)), dx));
+        F x = V::select(horizontalEdge, xOnY, xEdge);
+        F y = V::select(horizontalEdge, yEdge, yOnX);
+
+        M update0 = V::maskAnd(active, out0);
+        M update1 = V::maskAndNot(active, out0);
+        X0 = V::select(update0, x, X0);
+        Y0 = V::select(update0, y, Y0);
+        X1 = V::select(update1, x, X1);
+        Y1 = V::select(update1, y, Y1);
+        left0 = V::lt(X0, vxmin); right0 = V::gt(X0, vxmax);
+        bottom0 = V::lt(Y0, vymin); top0 = V::gt(Y0, vymax);
+        left1 = V::lt(X1, vxmin); right1 = V::gt(X1, vxmax);
+        bottom1 = V::lt(Y1, vymin); top1 = V::gt(Y1, vymax);
+    }
+
+    V::store(outX0, X0);
+    V::store(outY0, Y0);
+    V::store(outX1, X1);
+    V::store(outY1, Y1);
+    int bits = V::bits(accepted);
+    for (int lane = 0; lane < V::WIDTH; lane++)
+        accept[lane] = (unsigned char)((bits >> lane) & 1);
+}
+
+// Clip n segments (x0[i],y0[i])-(x1[i],y1[i]) against the rectangle
+// [xmin,xmax] x [ymin,ymax]. Clipped endpoints are written to the out
+// arrays, which may alias the inputs. accept[i] is set to 1 when part of
+// segment i is visible and 0 otherwise; endpoints of rejected segments are
+// left partially clipped and should be ignored. Returns the accepted count.
+template <class V>
+inline int cohenSutherlandClipBatchWith(const float* x0, const float* y0,
+    const float* x1, const float* y1, int n,
+    float xmin, float xmax, float ymin, float ymax,
+    float* outX0, float* outY0, float* outX1, float* outY1,
+    unsigned char* accept)
+{
+    int i = 0;
+    for (; i + V::WIDTH <= n; i += V::WIDTH) {
+        cohenSutherlandClipLanes<V>(x0 + i, y0 + i, x1 + i, y1 + i,
+            xmin, xmax, ymin, ymax,
+            outX0 + i, outY0 + i, outX1 + i, outY1 + i, accept + i);
+    }
+    for (; i < n; i++) {
+        cohenSutherlandClipLanes<SimdScalar>(x0 + i, y0 + i, x1 + i, y1 + i,
+            xmin, xmax, ymin, ymax,
+            outX0 + i, outY0 + i, outX1 + i, outY1 + i, accept + i);
+    }
+    int count = 0;
+    for (int k = 0; k < n; k++)
+        count += accept[k];
+    return count;
+}
+
+// Batched clip using the widest SIMD width enabled at compile time.
+inline int cohenSutherlandClipBatch(const float* x0, const float* y0,
+    const float* x1, const float* y1, int n,
+    float xmin, float xmax, float ymin, float ymax,
+    float* outX0, float* outY0, float* outX1, float* outY1,
+    unsigned char* accept)
+{
+    return cohenSutherlandClipBatchWith<SimdNative>(x0, y0, x1, y1, n,
+        xmin, xmax, ymin, ymax, outX0, outY0, outX1, outY1, accept);
+}
+
+// Clip the same n segments against each of windowCount windows. Results
+// for window w are written at offset w * n of the out and accept arrays,
+// which hold windowCount * n entries each and must not alias the inputs.
+// Each group of segments is clipped against every window while it is
+// still in cache. Returns the accepted count over all windows.
+template <class V>
+inline int cohenSutherlandClipWindowsWith(const float* x0, const float* y0,
+    const float* x1, const float* y1, int n,
+    const ClipWindow* windows, int windowCount,
+    float* outX0, float* outY0, float* outX1, float* outY1,
+    unsigned char* accept)
+{
+    int i = 0;
+    for (; i + V::WIDTH <= n; i += V::WIDTH) {
+        for (int w = 0; w < windowCount; w++) {
+            const ClipWindow& c = windows[w];
+            size_t o = (size_t)w * n + i;
+            cohenSutherlandClipLanes<V>(x0 + i, y0 + i, x1 + i, y1 + i,
+                c.xmin, c.xmax, c.ymin, c.ymax,
+                outX0 + o, outY0 + o, outX1 + o, outY1 + o, accept + o);
+        }
+    }
+    for (; i < n; i++) {
+        for (int w = 0; w < windowCount; w++) {
+            const ClipWindow& c = windows[w];
+            size_t o = (size_t)w * n + i;
+            cohenSutherlandClipLanes<SimdScalar>(x0 + i, y0 + i, x1 + i, y1 + i,
+                c.xmin, c.xmax, c.ymin, c.ymax,
+                outX0 + o, outY0 + o, outX1 + o, outY1 + o, accept + o);
+        }
+    }
+    int count = 0;
+    for (size_t k = 0; k < (size_t)windowCount * n; k++)
+        count += accept[k];
+    return count;
+}
+
+// Multi-window clip using the widest SIMD width enabled at compile time.
+inline int cohenSutherlandClipWindows(const float* x0, const float* y0,
+    const float* x1, const float* y1, int n,
+    const ClipWindow* windows, int windowCount,
+    float* outX0, float* outY0, float* outX1, float* outY1,
+    unsigned char* accept)
+{
+    return cohenSutherlandClipWindowsWith<SimdNative>(x0, y0, x1, y1, n,
+        windows, windowCount, outX0, outY0, outX1, outY1, accept);
+}
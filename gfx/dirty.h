@@ -0,0 +1,147 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Dirty-rectangle incremental redraw.
+// A frame is a stack of layers: recorded scenes that never change and
+// animated objects, each drawn by a function. Every frame each object is
+// recorded again and compared with its previous recording; when it
+// changed, the pixels its old and new drawing can touch are added to the
+// dirty region. Only the dirty rectangles are then cleared and redrawn,
+// each by replaying every layer with the backend limited to the
+// rectangle, which skips the scene nodes that cannot reach it. The
+// software rasterizers set pixels independently of the clip rectangle,
+// so the result is exactly a full redraw; the cost follows the changed
+// area, and a frame in which nothing changed draws nothing.
+// The first frame, and any frame after invalidate(), is drawn whole, as
+// is every frame on a backend that cannot limit drawing (GL).
+// ---------------------------------------------------------------------
+#include "render.h"
+#include "scene.h"
+#include <vector>
+
+// Union of pixel rectangles, kept as a few disjoint-ish rectangles:
+// overlapping or touching rectangles are merged, and past maxRects the
+// whole region collapses into its bounding rectangle.
+class DirtyRegion {
+public:
+    explicit DirtyRegion(int maxRects = 8) : maxRects(maxRects) {}
+
+    void clear() { list.clear(); }
+    bool empty() const { return list.empty(); }
+    const std::vector<PixelRect>& rects() const { return list; }
+
+    void add(PixelRect r) {
+        if (r.empty()) return;
+        for (size_t i = 0; i < list.size();) {
+            const PixelRect& e = list[i];
+            if (r.x0 <= e.x1 && e.x0 <= r.x1 && r.y0 <= e.y1 && e.y0 <= r.y1) {
+                r = unite(r, e);
+                list.erase(list.begin() + i);
+                i = 0;
+            }
+            else {
+                i++;
+            }
+        }
+        list.push_back(r);
+        if ((int)list.size() > maxRects) {
+            for (size_t i = 1; i < list.size(); i++)
+                list[0] = unite(list[0], list[i]);
+            list.resize(1);
+        }
+    }
+
+    long area() const {
+        long a = 0;
+        for (const PixelRect& r : list)
+            a += (long)(r.x1 - r.x0) * (r.y1 - r.y0);
+        return a;
+    }
+
+private:
+    static PixelRect unite(const PixelRect& a, const PixelRect& b) {
+        return { std::min(a.x0, b.x0), std::min(a.y0, b.y0), std::max(a.x1, b.x1), std::max(a.y1, b.y1) };
+    }
+
+    int maxRects;
+    std::vector<PixelRect> list;
+};
+
+class IncrementalRedraw {
+public:
+    // Layers are drawn bottom first, in the order they are added.
+    void addScene(const Scene* scene) { layers.push_back({ scene, nullptr, {}, {} }); }
+    void addObject(void (*draw)()) { layers.push_back({ nullptr, draw, {}, {} }); }
+
+    // Redraw everything next frame, e.g. after a static scene changed.
+    void invalidate() { whole = true; }
+
+    // Draw the frame on the current backend.
+    void draw() {
+        RenderBackend* backend = gfx.backend;
+        dirty.clear();
+        // Each object starts in the state the layers below it leave.
+        const SceneState* state = nullptr;
+        for (Layer& layer : layers) {
+            if (!layer.draw) {
+                state = &layer.scene->endState;
+                continue;
+            }
+            recordScene(layer.next, layer.draw, state);
+            if (!sameDrawing(layer.next, layer.current)) {
+                addBounds(layer.current);
+                addBounds(layer.next);
+            }
+            std::swap(layer.current, layer.next);
+            state = &layer.current.endState;
+        }
+        if (whole || !backend->setDamage(&FULL)) {
+            backend->setDamage(nullptr);
+            redrawArea = -1;
+            replay();
+            whole = false;
+            return;
+        }
+        redrawArea = dirty.area();
+        long clipCalls = clipCallCount;
+        for (const PixelRect& r : dirty.rects()) {
+            backend->setDamage(&r);
+            replay();
+        }
+        backend->setDamage(nullptr);
+        // A layer drawn into several rectangles counts its clip calls once.
+        clipCallCount = clipCalls;
+        if (!dirty.rects().empty())
+            for (const Layer& layer : layers)
+                clipCallCount += (layer.draw ? layer.current : *layer.scene).clipCalls;
+    }
+
+    // Pixels redrawn by the last frame, or -1 when it was drawn whole.
+    long lastRedrawArea() const { return redrawArea; }
+
+private:
+    struct Layer {
+        const Scene* scene;     // static layer
+        void (*draw)();         // animated object
+        Scene current, next;    // its recordings this frame and the one before
+    };
+
+    // Pixels the drawing of scene can touch.
+    void addBounds(const Scene& scene) {
+        for (const SceneNode& node : scene.nodes)
+            if (node.op != SCENE_CLEAR)
+                dirty.add(gfx.backend->pixelBounds(node.bounds, node.state.lineWidth));
+    }
+
+    void replay() {
+        gfxClear(GL_COLOR_BUFFER_BIT);
+        for (const Layer& layer : layers)
+            drawScene(layer.draw ? layer.current : *layer.scene);
+    }
+
+    static constexpr PixelRect FULL = { -0x40000000, -0x40000000, 0x40000000, 0x40000000 };
+
+    std::vector<Layer> layers;
+    DirtyRegion dirty;
+    bool whole = true;
+    long redrawArea = -1;
+};
@@ -0,0 +1,442 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Edge-function polygon fill, with 1, 4 or 8 samples per pixel.
+// A convex polygon is the set of points on the inner side of all its
+// edges, where each edge function E(x, y) = A x + B y + C is >= 0. The
+// fill walks the polygon's bounding box in blocks of 64x64 pixels and,
+// in the blocks an edge crosses, in tiles of 8x8, with the edges in the
+// lanes of a vector: E at the corner plus each edge's least and greatest
+// value over the samples rejects a block or tile outside one edge and
+// accepts one inside all of them, which is filled without looking at a
+// sample. Along a row of tiles E steps by 8 A, and since the polygon is
+// convex the row ends at the first rejected tile after an accepted one.
+// Only the edges whose y-range meets a row of blocks or tiles can fail a
+// sample in it (the others hold every point between the two edges a
+// horizontal line crosses), so each row tests only those.
+// In the remaining tiles only the edges they straddle are evaluated, a
+// row of 8 pixels at a time: E steps by A from pixel to pixel, so a tile
+// row is one multiply-add and compare per edge and sample.
+// Eight lanes are AVX2. A default x86-64 build compiles the tile kernel
+// twice, with SimdVector8 for AVX2 and with SimdNative (two SSE2 halves
+// per row), and picks one when it runs; -DGFX_NATIVE=ON on an AVX2
+// machine compiles only SimdNative, which is then AVX2 itself.
+// Samples exactly on an edge follow fillPolygon: they are inside when
+// the polygon lies at larger x, or for a horizontal edge at larger y, so
+// of two polygons sharing an edge only one covers them. With one sample
+// at the pixel center the pixels are fillPolygon's, except where a
+// sample lies within rounding of an edge.
+// With 4 or 8 samples the color is blended by the fraction covered, as
+// in gfx/multisample.h, which also fills the polygons that are not
+// convex (fillPolygon does with one sample).
+// ---------------------------------------------------------------------
+#include "framebuffer.h"
+#include "geom.h"
+#include "multisample.h"
+#include "simd.h"
+#include "softraster.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// The edges of a convex polygon as edge functions
+//   E(x, y) = a (x - x0) + b (y - y0),
+// oriented so that a sample is inside where E >= threshold: 0 for the
+// edges that keep their ties, the smallest positive float (E > 0) for the
+// others. ymin and ymax bound each edge in y.
+struct EdgeFunctions {
+    std::vector<float> a, b, threshold, ymin, ymax;
+    std::vector<double> x0, y0;
+
+    int count() const { return (int)a.size(); }
+};
+
+// Sets up edges for pts and returns true, or returns false when the
+// polygon is not convex, has no area or has coordinates that are not
+// finite. Repeated vertices and collinear edges are allowed.
+inline bool convexEdgeFunctions(const Point* pts, int n, EdgeFunctions& edges) {
+    edges.a.clear();
+    edges.b.clear();
+    edges.threshold.clear();
+    edges.ymin.clear();
+    edges.ymax.clear();
+    edges.x0.clear();
+    edges.y0.clear();
+    double area = 0;
+    for (int i = 0; i < n; i++) {
+        Point p = pts[i], q = pts[i + 1 < n ? i + 1 : 0];
+        double dx = (double)q.x - p.x, dy = (double)q.y - p.y;
+        area += (double)p.x * q.y - (double)q.x * p.y;
+        if (dx == 0 && dy == 0) continue;
+        // a and b hold the edge direction until the orientation is known.
+        edges.a.push_back((float)dx);
+        edges.b.push_back((float)dy);
+        edges.ymin.push_back(std::min(p.y, q.y));
+        edges.ymax.push_back(std::max(p.y, q.y));
+        edges.x0.push_back(p.x);
+        edges.y0.push_back(p.y);
+    }
+    int m = edges.count();
+    if (m < 3 || !std::isfinite(area) || area == 0) return false;
+
+    // Convex: every turn goes the way of the area (or straight on, but
+    // not back), and the direction's x and y change sign twice around
+    // the polygon, which rules out stars that turn one way throughout.
+    int xTurns = 0, yTurns = 0;
+    for (int i = 0; i < m; i++) {
+        int j = i + 1 < m ? i + 1 : 0;
+        double cross = (double)edges.a[i] * edges.b[j] - (double)edges.b[i] * edges.a[j];
+        double dot = (double)edges.a[i] * edges.a[j] + (double)edges.b[i] * edges.b[j];
+        if (cross == 0 ? dot < 0 : (cross > 0) != (area > 0)) return false;
+    }
+    for (int k = 0; k < 2; k++) {
+        const std::vector<float>& d = k == 0 ? edges.a : edges.b;
+        int last = 0, first = 0, changes = 0;
+        for (int i = 0; i < m; i++) {
+            int sign = (d[i] > 0) - (d[i] < 0);
+            if (sign == 0) continue;
+            if (first == 0) first = sign;
+            else if (sign != last) changes++;
+            last = sign;
+        }
+        changes += last != first;
+        (k == 0 ? xTurns : yTurns) = changes;
+    }
+    if (xTurns > 2 || yTurns > 2) return false;
+
+    // The inside is to the left of each edge of a counterclockwise
+    // polygon: a = -dy, b = dx.
+    double orient = area > 0 ? 1.0 : -1.0;
+    for (int i = 0; i < m; i++) {
+        float dx = edges.a[i], dy = edges.b[i];
+        float a = (float)(-dy * orient), b = (float)(dx * orient);
+        edges.a[i] = a;
+        edges.b[i] = b;
+        edges.threshold.push_back(a > 0 || (a == 0 && b > 0) ? 0.0f :
+            std::numeric_limits<float>::denorm_min());
+    }
+    return true;
+}
+
+// The least and greatest sample offsets of a pattern, in x and in y.
+struct SampleExtent {
+    float x0, x1, y0, y1;
+};
+
+inline SampleExtent sampleExtent(const SamplePattern& pattern) {
+    SampleExtent r = { pattern.dx[0], pattern.dx[0], pattern.dy[0], pattern.dy[0] };
+    for (int s = 1; s < pattern.count; s++) {
+        r.x0 = std::min(r.x0, pattern.dx[s]);
+        r.x1 = std::max(r.x1, pattern.dx[s]);
+        r.y0 = std::min(r.y0, pattern.dy[s]);
+        r.y1 = std::max(r.y1, pattern.dy[s]);
+    }
+    return r;
+}
+
+// The edges that can fail a sample in one row of blocks or tiles, padded
+// to a multiple of 8 with edges every sample passes. low and high are
+// each edge's least and greatest value over the samples of a block or
+// tile relative to E at its corner; lowCut and highCut are the same for
+// the last one of the row, which the box may cut short.
+struct EdgeSet {
+    int count = 0, padded = 0;
+    std::vector<float> a, b, threshold, low, high, lowCut, highCut;
+    std::vector<double> x0, y0;
+};
+
+// Select the edges for the rows [y, y + rows) of blocks or tiles width
+// pixels wide, the last one cutWidth wide: those whose y-range meets the
+// rows' samples.
+inline void selectEdges(const EdgeFunctions& edges, int y, int rows, int width, int cutWidth,
+    const SampleExtent& extent, EdgeSet& set) {
+    const int m = edges.count();
+    for (std::vector<float>* v : { &set.a, &set.b, &set.threshold, &set.low, &set.high,
+             &set.lowCut, &set.highCut })
+        v->resize(m + 8);
+    set.x0.resize(m + 8);
+    set.y0.resize(m + 8);
+    const float bottom = y + extent.y0, top = y + (rows - 1) + extent.y1;
+    const float x1 = extent.x1 + (width - 1), cutX1 = extent.x1 + (cutWidth - 1);
+    const float y1 = extent.y1 + (rows - 1);
+    int k = 0;
+    for (int e = 0; e < m; e++) {
+        if (edges.ymax[e] < bottom || edges.ymin[e] > top) continue;
+        float a = edges.a[e], b = edges.b[e];
+        float lowY = b * (b > 0 ? extent.y0 : y1), highY = b * (b > 0 ? y1 : extent.y0);
+        set.a[k] = a;
+        set.b[k] = b;
+        set.threshold[k] = edges.threshold[e];
+        set.low[k] = a * (a > 0 ? extent.x0 : x1) + lowY;
+        set.high[k] = a * (a > 0 ? x1 : extent.x0) + highY;
+        set.lowCut[k] = a * (a > 0 ? extent.x0 : cutX1) + lowY;
+        set.highCut[k] = a * (a > 0 ? cutX1 : extent.x0) + highY;
+        set.x0[k] = edges.x0[e];
+        set.y0[k] = edges.y0[e];
+        k++;
+    }
+    set.count = k;
+    set.padded = (k + 7) / 8 * 8;
+    for (int e = k; e < set.padded; e++) {
+        set.a[e] = set.b[e] = 0;
+        set.threshold[e] = -std::numeric_limits<float>::infinity();
+        set.low[e] = set.high[e] = set.lowCut[e] = set.highCut[e] = 0;
+        set.x0[e] = set.y0[e] = 0;
+    }
+}
+
+// E of each edge of set at the pixel corner (x, y), in double so that it
+// stays exact far from the edge's first vertex.
+inline void edgeCorners(const EdgeSet& set, int x, int y, float* cornerE) {
+    for (int e = 0; e < set.padded; e++)
+        cornerE[e] = (float)(set.a[e] * ((double)x - set.x0[e]) + set.b[e] * ((double)y - set.y0[e]));
+}
+
+// Classify the block or tile whose corner E is cornerE, cut short or
+// not: -1 when it is outside an edge, 1 when inside all, else 0.
+template <class S>
+__attribute__((always_inline)) inline int classifyEdges(const EdgeSet& set,
+    const float* cornerE, bool cut) {
+    const float* lowest = cut ? set.lowCut.data() : set.low.data();
+    const float* highest = cut ? set.highCut.data() : set.high.data();
+    typename S::M outside = S::maskFalse(), inside = S::maskTrue();
+    for (int g = 0; g < set.padded; g += S::WIDTH) {
+        typename S::F e = S::load(&cornerE[g]), t = S::load(&set.threshold[g]);
+        outside = S::maskOr(outside, S::lt(S::add(e, S::load(&highest[g])), t));
+        inside = S::maskAnd(inside, S::ge(S::add(e, S::load(&lowest[g])), t));
+    }
+    if (S::any(outside)) return -1;
+    return S::bits(inside) == (1 << S::WIDTH) - 1 ? 1 : 0;
+}
+
+// The edges of set that do not hold all the samples of the tile.
+template <class S>
+__attribute__((always_inline)) inline int straddledEdges(const EdgeSet& set,
+    const float* cornerE, bool cut, int* straddled) {
+    const float* lowest = cut ? set.lowCut.data() : set.low.data();
+    int k = 0;
+    for (int g = 0; g < set.count; g += S::WIDTH) {
+        typename S::F e = S::load(&cornerE[g]);
+        int in = S::bits(S::ge(S::add(e, S::load(&lowest[g])), S::load(&set.threshold[g])));
+        for (int i = 0; i < S::WIDTH && g + i < set.count; i++)
+            if (!((in >> i) & 1)) straddled[k++] = g + i;
+    }
+    return k;
+}
+
+// Fill the samples of the tile of width x rows pixels at (x, y) that
+// are inside the straddled edges of set. E at its corner is cornerE; E
+// steps by a from lane to lane, and sampleX holds the x offsets of each
+// sample at each lane.
+template <class S>
+__attribute__((always_inline)) inline void fillEdgeTile(Framebuffer& fb, int x, int y,
+    int width, int rows, const EdgeSet& set, const float* cornerE, const int* straddled,
+    int k, const SamplePattern& pattern, const float* sampleX, uint32_t color) {
+    const int W = S::WIDTH, T = 8, samples = pattern.count;
+    const typename S::F one = S::set1(1.0f), zero = S::set1(0.0f);
+    float colorBits, coverage[8];
+    memcpy(&colorBits, &color, sizeof colorBits);
+    for (int j = 0; j < rows; j++) {
+        uint32_t* pixels = fb.row(y + j) + x;
+        for (int c = 0; c < width; c += W) {
+            typename S::F cov = zero;
+            typename S::M in = S::maskTrue();
+            for (int s = 0; s < samples; s++) {
+                in = S::maskTrue();
+                typename S::F lanes = S::load(&sampleX[s * T + c]);
+                for (int i = 0; i < k; i++) {
+                    int e = straddled[i];
+                    float rowE = cornerE[e] + set.b[e] * (j + pattern.dy[s]);
+                    typename S::F v = S::add(S::set1(rowE), S::mul(S::set1(set.a[e]), lanes));
+                    in = S::maskAnd(in, S::ge(v, S::set1(set.threshold[e])));
+                }
+                if (samples > 1)
+                    cov = S::add(cov, S::select(in, one, zero));
+            }
+            if (samples == 1 && c + W <= width) {
+                // All lanes in the tile: select between the pixels' bits
+                // and the color's, as floats (load and store copy bytes).
+                float* lanes = reinterpret_cast<float*>(pixels + c);
+                S::store(lanes, S::select(in, S::set1(colorBits), S::load(lanes)));
+            }
+            else if (samples == 1) {
+                int bits = S::bits(in);
+                for (int i = c; i < width; i++, bits >>= 1)
+                    if (bits & 1) pixels[i] = color;
+            }
+            else {
+                S::store(coverage, cov);
+                for (int i = c; i < std::min(width, c + W); i++) {
+                    int covered = (int)coverage[i - c];
+                    if (covered > 0)
+                        pixels[i] = blendCoverage(pixels[i], color, covered, samples);
+                }
+            }
+        }
+    }
+}
+
+// Fill box, the pixels of the polygon's bounding box inside the clip
+// rectangle, in blocks of 64x64 pixels and, in the blocks that straddle
+// an edge, tiles of 8x8. Always inlined, so that with SimdVector8 it is
+// compiled for the AVX2 function calling it (see gfx/simd.h).
+template <class S>
+__attribute__((always_inline)) inline void fillEdgeTiles(Framebuffer& fb,
+    const EdgeFunctions& edges, uint32_t color, const PixelRect& box,
+    const SamplePattern& pattern) {
+    const int W = S::WIDTH, T = 8, B = 64, samples = pattern.count;
+    const SampleExtent extent = sampleExtent(pattern);
+    const int blockCut = (box.x1 - box.x0 - 1) % B + 1, tileCut = (box.x1 - box.x0 - 1) % T + 1;
+    thread_local EdgeSet blockSet, tileSets[B / T];
+    thread_local std::vector<float> cornerE;
+    thread_local std::vector<int> straddled;
+    cornerE.resize(edges.count() + 8);
+    straddled.resize(edges.count());
+    float sampleX[8 * 8];
+    for (int s = 0; s < samples; s++)
+        for (int i = 0; i < T; i++)
+            sampleX[s * T + i] = i + pattern.dx[s];
+    const typename S::F tileStep = S::set1((float)T);
+    auto fillRect = [&](int x0, int y0, int x1, int y1) {
+        for (int y = y0; y < y1; y++)
+            std::fill(fb.row(y) + x0, fb.row(y) + x1, color);
+    };
+
+    for (int by = box.y0; by < box.y1; by += B) {
+        const int blockRows = std::min(B, box.y1 - by);
+        selectEdges(edges, by, blockRows, B, blockCut, extent, blockSet);
+        if (blockSet.count == 0) continue;
+        bool tileSetsReady = false;
+        int blockRun = -1;
+        for (int bx = box.x0; bx < box.x1; bx += B) {
+            const int blockWidth = std::min(B, box.x1 - bx);
+            // Runs of accepted blocks are filled at once, like tiles.
+            edgeCorners(blockSet, bx, by, cornerE.data());
+            int block = classifyEdges<S>(blockSet, cornerE.data(), blockWidth < B);
+            if (block > 0) {
+                if (blockRun < 0) blockRun = bx;
+                continue;
+            }
+            if (blockRun >= 0) {
+                fillRect(blockRun, by, bx, by + blockRows);
+                blockRun = -1;
+            }
+            if (block < 0) continue;
+            if (!tileSetsReady) {
+                for (int ty = by; ty < by + blockRows; ty += T)
+                    selectEdges(edges, ty, std::min(T, box.y1 - ty), T, tileCut, extent,
+                        tileSets[(ty - by) / T]);
+                tileSetsReady = true;
+            }
+
+            // Tile rows of the block: a run of accepted tiles is filled
+            // at once, and since the polygon is convex, a rejected tile
+            // after one that was not ends the row.
+            for (int ty = by; ty < by + blockRows; ty += T) {
+                const EdgeSet& set = tileSets[(ty - by) / T];
+                if (set.count == 0) continue;
+                const int rows = std::min(T, box.y1 - ty);
+                edgeCorners(set, bx, ty, cornerE.data());
+                int run = -1, tx = bx;
+                bool entered = false;
+                for (; tx < bx + blockWidth; tx += T) {
+                    const int width = std::min(T, box.x1 - tx);
+                    int tile = classifyEdges<S>(set, cornerE.data(), width < T);
+                    if (tile < 0) {
+                        if (entered) break;
+                    }
+                    else if (tile > 0) {
+                        entered = true;
+                        if (run < 0) run = tx;
+                    }
+                    else {
+                        entered = true;
+                        if (run >= 0) {
+                            fillRect(run, ty, tx, ty + rows);
+                            run = -1;
+                        }
+                        // Only the edges the tile straddles can fail a sample.
+                        int k = straddledEdges<S>(set, cornerE.data(), width < T, straddled.data());
+                        fillEdgeTile<S>(fb, tx, ty, width, rows, set, cornerE.data(),
+                            straddled.data(), k, pattern, sampleX, color);
+                    }
+                    for (int g = 0; g < set.padded; g += W)
+                        S::store(&cornerE[g], S::add(S::load(&cornerE[g]), S::mul(S::load(&set.a[g]), tileStep)));
+                }
+                if (run >= 0)
+                    fillRect(run, ty, std::min(tx, bx + blockWidth), ty + rows);
+            }
+        }
+        if (blockRun >= 0)
+            fillRect(blockRun, by, box.x1, by + blockRows);
+    }
+}
+
+#if defined(GFX_HAVE_VECTOR8) && !defined(GFX_HAVE_AVX2)
+__attribute__((target("avx2"))) inline void fillEdgeTilesAvx2(Framebuffer& fb,
+    const EdgeFunctions& edges, uint32_t color, const PixelRect& box,
+    const SamplePattern& pattern) {
+    fillEdgeTiles<SimdVector8>(fb, edges, color, box, pattern);
+}
+#endif
+
+// Sets up the edges of a convex polygon and box, the pixels in clip any
+// of whose samples lie in its bounding box. False when the polygon is
+// not convex, and the caller fills it another way.
+inline bool prepareEdgeFill(const Point* pts, int n, const PixelRect& clip,
+    const SamplePattern& pattern, EdgeFunctions& edges, PixelRect& box) {
+    if (n < 3 || !convexEdgeFunctions(pts, n, edges)) return false;
+    float xmin = pts[0].x, xmax = pts[0].x, ymin = pts[0].y, ymax = pts[0].y;
+    for (int i = 1; i < n; i++) {
+        xmin = std::min(xmin, pts[i].x);
+        xmax = std::max(xmax, pts[i].x);
+        ymin = std::min(ymin, pts[i].y);
+        ymax = std::max(ymax, pts[i].y);
+    }
+    SampleExtent extent = sampleExtent(pattern);
+    box.x0 = (int)std::max((float)clip.x0, std::ceil(xmin - extent.x1));
+    box.x1 = (int)std::min((float)clip.x1, std::floor(xmax - extent.x0) + 1);
+    box.y0 = (int)std::max((float)clip.y0, std::ceil(ymin - extent.y1));
+    box.y1 = (int)std::min((float)clip.y1, std::floor(ymax - extent.y0) + 1);
+    return true;
+}
+
+// The fill of the polygons prepareEdgeFill turns down.
+inline void fillPolygonNotConvex(Framebuffer& fb, const Point* pts, int n, uint32_t color,
+    const PixelRect& clip, int samples) {
+    if (samples > 1) fillPolygonSamples(fb, pts, n, color, clip, samples);
+    else fillPolygon(fb, pts, n, color, clip);
+}
+
+// Fill with S lanes; samples is 1, 4 or 8.
+template <class S>
+void fillPolygonEdgesWith(Framebuffer& fb, const Point* pts, int n, uint32_t color,
+    const PixelRect& clip, int samples = 1) {
+    thread_local EdgeFunctions edges;
+    const SamplePattern& pattern = samplePattern(samples);
+    PixelRect box;
+    if (!prepareEdgeFill(pts, n, clip, pattern, edges, box))
+        fillPolygonNotConvex(fb, pts, n, color, clip, samples);
+    else if (!box.empty())
+        fillEdgeTiles<S>(fb, edges, color, box, pattern);
+}
+
+// Fill with AVX2 when the CPU has it, else the widest SIMD the build
+// enables; samples is 1, 4 or 8.
+inline void fillPolygonEdges(Framebuffer& fb, const Point* pts, int n, uint32_t color,
+    const PixelRect& clip, int samples = 1) {
+#if defined(GFX_HAVE_VECTOR8) && !defined(GFX_HAVE_AVX2)
+    if (cpuHasAvx2()) {
+        thread_local EdgeFunctions edges;
+        const SamplePattern& pattern = samplePattern(samples);
+        PixelRect box;
+        if (!prepareEdgeFill(pts, n, clip, pattern, edges, box))
+            fillPolygonNotConvex(fb, pts, n, color, clip, samples);
+        else if (!box.empty())
+            fillEdgeTilesAvx2(fb, edges, color, box, pattern);
+        return;
+    }
+#endif
+    fillPolygonEdgesWith<SimdNative>(fb, pts, n, color, clip, samples);
+}
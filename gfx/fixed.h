@@ -0,0 +1,55 @@
+#pragma once
+// ---------------------------------------------------------------------
+// 16.16 fixed-point coordinates.
+// A Fixed16 is an int32 counting 1/65536 pixel, so it covers +-32767
+// pixels. Addition, subtraction and comparison are exact integer
+// operations; mulDiv scales through a 64-bit intermediate and rounds to
+// nearest, so every result is the same on every compiler and target.
+// ---------------------------------------------------------------------
+#include "geom.h"
+#include <cmath>
+#include <cstdint>
+
+struct Fixed16 {
+    int32_t raw;
+
+    static const int FRAC_BITS = 16;
+    static const int32_t ONE = 1 << FRAC_BITS;
+    static const int32_t HALF = ONE / 2;
+
+    static Fixed16 fromRaw(int32_t raw) { Fixed16 f; f.raw = raw; return f; }
+    static Fixed16 fromInt(int v) { return fromRaw(v * ONE); }
+    // Nearest representable value (ties to even).
+    static Fixed16 fromFloat(float v) { return fromRaw((int32_t)lrintf(v * (float)ONE)); }
+
+    float toFloat() const { return raw * (1.0f / ONE); }
+    int floor() const { return raw >> FRAC_BITS; }
+    int ceil() const { return -((-raw) >> FRAC_BITS); }
+    int round() const { return (raw + HALF) >> FRAC_BITS; }
+};
+
+inline Fixed16 operator+(Fixed16 a, Fixed16 b) { return Fixed16::fromRaw(a.raw + b.raw); }
+inline Fixed16 operator-(Fixed16 a, Fixed16 b) { return Fixed16::fromRaw(a.raw - b.raw); }
+inline Fixed16 operator-(Fixed16 a) { return Fixed16::fromRaw(-a.raw); }
+inline bool operator==(Fixed16 a, Fixed16 b) { return a.raw == b.raw; }
+inline bool operator!=(Fixed16 a, Fixed16 b) { return a.raw != b.raw; }
+inline bool operator<(Fixed16 a, Fixed16 b) { return a.raw < b.raw; }
+inline bool operator<=(Fixed16 a, Fixed16 b) { return a.raw <= b.raw; }
+inline bool operator>(Fixed16 a, Fixed16 b) { return a.raw > b.raw; }
+inline bool operator>=(Fixed16 a, Fixed16 b) { return a.raw >= b.raw; }
+
+// a * b / c, rounded to nearest (halves away from zero). c must not be 0.
+inline Fixed16 mulDiv(Fixed16 a, Fixed16 b, Fixed16 c) {
+    int64_t n = (int64_t)a.raw * b.raw;
+    int64_t d = c.raw;
+    if (d < 0) {
+        n = -n;
+        d = -d;
+    }
+    return Fixed16::fromRaw((int32_t)((n >= 0 ? n + d / 2 : n - d / 2) / d));
+}
+
+typedef BasicPoint<Fixed16> FixedPoint;
+
+inline FixedPoint toFixed(Point p) { return { Fixed16::fromFloat(p.x), Fixed16::fromFloat(p.y) }; }
+inline Point toFloat(FixedPoint p) { return { p.x.toFloat(), p.y.toFloat() }; }
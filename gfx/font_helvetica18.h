@@ -0,0 +1,455 @@
+// Glyph bitmaps for GLUT_BITMAP_HELVETICA_18, characters 32-126.
+// Extracted from freeglut's copy of the X11 font
+// -adobe-helvetica-medium-r-normal--18-180-75-75-p-98-iso8859-1
+// (Copyright 1984-1989 Adobe Systems Incorporated, distributed with the X
+// Window System under its permissive license).
+// Each glyph is its advance width followed by 23 rows of ((width + 7) / 8)
+// bytes, bottom row first, most significant bit leftmost.
+#pragma once
+
+const int HELVETICA18_HEIGHT = 23;
+const float HELVETICA18_XORIG = 0.0f;
+const float HELVETICA18_YORIG = 5.0f;
+const int HELVETICA18_FIRST = 32;
+const int HELVETICA18_LAST = 126;
+
+const unsigned char HELVETICA18_DATA[] = {
+    // ' '
+    0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '!'
+    0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x00, 0x00, 0x20, 0x20,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00,
+    // '"'
+    0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x90, 0x90, 0xd8, 0xd8, 0xd8, 0x00, 0x00, 0x00, 0x00,
+    // '#'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x24,
+    0x00, 0x24, 0x00, 0x24, 0x00, 0xff, 0x80, 0xff, 0x80, 0x12, 0x00, 0x12,
+    0x00, 0x12, 0x00, 0x7f, 0xc0, 0x7f, 0xc0, 0x09, 0x00, 0x09, 0x00, 0x09,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '$'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x1f,
+    0x00, 0x3f, 0x80, 0x75, 0xc0, 0x64, 0xc0, 0x04, 0xc0, 0x07, 0x80, 0x1f,
+    0x00, 0x3c, 0x00, 0x74, 0x00, 0x64, 0x00, 0x65, 0x80, 0x3f, 0x80, 0x1f,
+    0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '%'
+    0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c,
+    0x3c, 0x0c, 0x7e, 0x06, 0x66, 0x06, 0x66, 0x03, 0x7e, 0x03, 0x3c, 0x01,
+    0x80, 0x3d, 0x80, 0x7e, 0xc0, 0x66, 0xc0, 0x66, 0x60, 0x7e, 0x60, 0x3c,
+    0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '&'
+    0x0d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e,
+    0x38, 0x3f, 0x70, 0x73, 0xe0, 0x61, 0xc0, 0x61, 0xe0, 0x63, 0x60, 0x77,
+    0x60, 0x3e, 0x00, 0x1e, 0x00, 0x33, 0x00, 0x33, 0x00, 0x3f, 0x00, 0x1e,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '\''
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x40, 0x20, 0x20, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    // '('
+    0x06, 0x00, 0x08, 0x18, 0x30, 0x30, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x30, 0x30, 0x18, 0x08, 0x00, 0x00, 0x00, 0x00,
+    // ')'
+    0x06, 0x00, 0x40, 0x60, 0x30, 0x30, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18,
+    0x18, 0x18, 0x18, 0x18, 0x30, 0x30, 0x60, 0x40, 0x00, 0x00, 0x00, 0x00,
+    // '*'
+    0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x44, 0x38, 0x38, 0x7c, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00,
+    // '+'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c,
+    0x00, 0x0c, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x7f, 0x80, 0x7f, 0x80, 0x0c,
+    0x00, 0x0c, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // ','
+    0x05, 0x00, 0x00, 0x40, 0x20, 0x20, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '-'
+    0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0x80, 0x7f, 0x80, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '.'
+    0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '/'
+    0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0xc0, 0x40, 0x40, 0x60, 0x60,
+    0x20, 0x20, 0x30, 0x30, 0x10, 0x10, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00,
+    // '0'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e,
+    0x00, 0x3f, 0x00, 0x33, 0x00, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61,
+    0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x33, 0x00, 0x3f, 0x00, 0x1e,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '1'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06,
+    0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06,
+    0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x3e, 0x00, 0x3e, 0x00, 0x06,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '2'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f,
+    0x80, 0x7f, 0x80, 0x60, 0x00, 0x70, 0x00, 0x38, 0x00, 0x1c, 0x00, 0x0e,
+    0x00, 0x07, 0x00, 0x03, 0x80, 0x01, 0x80, 0x61, 0x80, 0x7f, 0x00, 0x1e,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '3'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e,
+    0x00, 0x3f, 0x00, 0x63, 0x80, 0x61, 0x80, 0x01, 0x80, 0x03, 0x80, 0x0f,
+    0x00, 0x0e, 0x00, 0x03, 0x00, 0x61, 0x80, 0x61, 0x80, 0x3f, 0x00, 0x1e,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '4'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x80, 0x01, 0x80, 0x01, 0x80, 0x7f, 0xc0, 0x7f, 0xc0, 0x61, 0x80, 0x31,
+    0x80, 0x19, 0x80, 0x19, 0x80, 0x0d, 0x80, 0x07, 0x80, 0x03, 0x80, 0x01,
+    0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '5'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3e,
+    0x00, 0x7f, 0x00, 0x63, 0x80, 0x61, 0x80, 0x01, 0x80, 0x01, 0x80, 0x63,
+    0x80, 0x7f, 0x00, 0x7e, 0x00, 0x60, 0x00, 0x60, 0x00, 0x7f, 0x00, 0x7f,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '6'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e,
+    0x00, 0x3f, 0x00, 0x71, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x7f,
+    0x00, 0x6e, 0x00, 0x60, 0x00, 0x60, 0x00, 0x31, 0x80, 0x3f, 0x80, 0x1e,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '7'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30,
+    0x00, 0x30, 0x00, 0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0x0c, 0x00, 0x0c,
+    0x00, 0x06, 0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0x80, 0x7f, 0x80, 0x7f,
+    0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '8'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e,
+    0x00, 0x3f, 0x00, 0x73, 0x80, 0x61, 0x80, 0x61, 0x80, 0x33, 0x00, 0x3f,
+    0x00, 0x33, 0x00, 0x61, 0x80, 0x61, 0x80, 0x73, 0x80, 0x3f, 0x00, 0x1e,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '9'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3e,
+    0x00, 0x7f, 0x00, 0x63, 0x00, 0x01, 0x80, 0x01, 0x80, 0x1d, 0x80, 0x3f,
+    0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x63, 0x80, 0x3f, 0x00, 0x1e,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // ':'
+    0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // ';'
+    0x05, 0x00, 0x00, 0x40, 0x20, 0x20, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '<'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x80, 0x07, 0x80, 0x1e, 0x00, 0x38, 0x00, 0x60, 0x00, 0x38, 0x00, 0x1e,
+    0x00, 0x07, 0x80, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '='
+    0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x3f, 0x80, 0x3f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x3f,
+    0x80, 0x3f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '>'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+    0x00, 0x78, 0x00, 0x1e, 0x00, 0x07, 0x00, 0x01, 0x80, 0x07, 0x00, 0x1e,
+    0x00, 0x78, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '?'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18,
+    0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x18, 0x00, 0x18,
+    0x00, 0x1c, 0x00, 0x0e, 0x00, 0x07, 0x00, 0x63, 0x00, 0x63, 0x00, 0x7f,
+    0x00, 0x3e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '@'
+    0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xf0, 0x00, 0x0f, 0xf8,
+    0x00, 0x1c, 0x00, 0x00, 0x38, 0x00, 0x00, 0x33, 0xb8, 0x00, 0x67, 0xfc,
+    0x00, 0x66, 0x66, 0x00, 0x66, 0x33, 0x00, 0x66, 0x33, 0x00, 0x66, 0x31,
+    0x80, 0x63, 0x19, 0x80, 0x33, 0xb9, 0x80, 0x31, 0xd9, 0x80, 0x18, 0x03,
+    0x00, 0x0e, 0x07, 0x00, 0x07, 0xfe, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'A'
+    0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0,
+    0x30, 0xc0, 0x30, 0x60, 0x60, 0x60, 0x60, 0x7f, 0xe0, 0x3f, 0xc0, 0x30,
+    0xc0, 0x30, 0xc0, 0x19, 0x80, 0x19, 0x80, 0x0f, 0x00, 0x0f, 0x00, 0x06,
+    0x00, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'B'
+    0x0d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f,
+    0xc0, 0x7f, 0xe0, 0x60, 0x70, 0x60, 0x30, 0x60, 0x30, 0x60, 0x70, 0x7f,
+    0xe0, 0x7f, 0xc0, 0x60, 0xc0, 0x60, 0x60, 0x60, 0x60, 0x60, 0xe0, 0x7f,
+    0xc0, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'C'
+    0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07,
+    0xc0, 0x1f, 0xf0, 0x38, 0x38, 0x30, 0x18, 0x70, 0x00, 0x60, 0x00, 0x60,
+    0x00, 0x60, 0x00, 0x60, 0x00, 0x70, 0x00, 0x30, 0x18, 0x38, 0x38, 0x1f,
+    0xf0, 0x07, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'D'
+    0x0d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f,
+    0x80, 0x7f, 0xc0, 0x60, 0xe0, 0x60, 0x60, 0x60, 0x30, 0x60, 0x30, 0x60,
+    0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x60, 0x60, 0xe0, 0x7f,
+    0xc0, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'E'
+    0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f,
+    0xc0, 0x7f, 0xc0, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x7f,
+    0x80, 0x7f, 0x80, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x7f,
+    0xc0, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'F'
+    0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+    0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x7f,
+    0x80, 0x7f, 0x80, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x7f,
+    0xc0, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'G'
+    0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07,
+    0xd8, 0x1f, 0xf8, 0x38, 0x38, 0x30, 0x18, 0x70, 0x18, 0x60, 0xf8, 0x60,
+    0xf8, 0x60, 0x00, 0x60, 0x00, 0x70, 0x18, 0x30, 0x18, 0x38, 0x38, 0x1f,
+    0xf0, 0x07, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'H'
+    0x0d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+    0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x7f,
+    0xf0, 0x7f, 0xf0, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60,
+    0x30, 0x60, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'I'
+    0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00,
+    // 'J'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e,
+    0x00, 0x3f, 0x00, 0x73, 0x80, 0x61, 0x80, 0x61, 0x80, 0x01, 0x80, 0x01,
+    0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01, 0x80, 0x01,
+    0x80, 0x01, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'K'
+    0x0d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+    0x38, 0x60, 0x70, 0x60, 0xe0, 0x61, 0xc0, 0x63, 0x80, 0x67, 0x00, 0x7e,
+    0x00, 0x7c, 0x00, 0x6e, 0x00, 0x67, 0x00, 0x63, 0x80, 0x61, 0xc0, 0x60,
+    0xe0, 0x60, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'L'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f,
+    0x80, 0x7f, 0x80, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60,
+    0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60,
+    0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'M'
+    0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61,
+    0x86, 0x61, 0x86, 0x63, 0xc6, 0x62, 0x46, 0x66, 0x66, 0x66, 0x66, 0x6c,
+    0x36, 0x6c, 0x36, 0x78, 0x1e, 0x78, 0x1e, 0x70, 0x0e, 0x70, 0x0e, 0x60,
+    0x06, 0x60, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'N'
+    0x0d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+    0x30, 0x60, 0x70, 0x60, 0xf0, 0x60, 0xf0, 0x61, 0xb0, 0x63, 0x30, 0x63,
+    0x30, 0x66, 0x30, 0x66, 0x30, 0x6c, 0x30, 0x78, 0x30, 0x78, 0x30, 0x70,
+    0x30, 0x60, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'O'
+    0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07,
+    0xc0, 0x1f, 0xf0, 0x38, 0x38, 0x30, 0x18, 0x70, 0x1c, 0x60, 0x0c, 0x60,
+    0x0c, 0x60, 0x0c, 0x60, 0x0c, 0x70, 0x1c, 0x30, 0x18, 0x38, 0x38, 0x1f,
+    0xf0, 0x07, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'P'
+    0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+    0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x7f,
+    0x80, 0x7f, 0xc0, 0x60, 0xe0, 0x60, 0x60, 0x60, 0x60, 0x60, 0xe0, 0x7f,
+    0xc0, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'Q'
+    0x0f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x07,
+    0xd8, 0x1f, 0xf0, 0x38, 0x78, 0x30, 0xd8, 0x70, 0xdc, 0x60, 0x0c, 0x60,
+    0x0c, 0x60, 0x0c, 0x60, 0x0c, 0x70, 0x1c, 0x30, 0x18, 0x38, 0x38, 0x1f,
+    0xf0, 0x07, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'R'
+    0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0xc0, 0x60, 0xc0, 0x7f,
+    0x80, 0x7f, 0xc0, 0x60, 0xe0, 0x60, 0x60, 0x60, 0x60, 0x60, 0xe0, 0x7f,
+    0xc0, 0x7f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'S'
+    0x0d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f,
+    0x80, 0x3f, 0xe0, 0x70, 0x70, 0x60, 0x30, 0x00, 0x30, 0x00, 0x70, 0x01,
+    0xe0, 0x0f, 0x80, 0x3e, 0x00, 0x70, 0x00, 0x60, 0x30, 0x70, 0x70, 0x3f,
+    0xe0, 0x0f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'T'
+    0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06,
+    0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06,
+    0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x06, 0x00, 0x7f,
+    0xe0, 0x7f, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'U'
+    0x0d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f,
+    0x80, 0x3f, 0xe0, 0x30, 0x60, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60,
+    0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60, 0x30, 0x60,
+    0x30, 0x60, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'V'
+    0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+    0x00, 0x07, 0x80, 0x07, 0x80, 0x0c, 0xc0, 0x0c, 0xc0, 0x0c, 0xc0, 0x18,
+    0x60, 0x18, 0x60, 0x18, 0x60, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x60,
+    0x18, 0x60, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'W'
+    0x12, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0c, 0x0c, 0x00, 0x0c, 0x0c, 0x00, 0x0e, 0x1c,
+    0x00, 0x1a, 0x16, 0x00, 0x1b, 0x36, 0x00, 0x1b, 0x36, 0x00, 0x33, 0x33,
+    0x00, 0x33, 0x33, 0x00, 0x31, 0x23, 0x00, 0x31, 0xe3, 0x00, 0x61, 0xe1,
+    0x80, 0x60, 0xc1, 0x80, 0x60, 0xc1, 0x80, 0x60, 0xc1, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'X'
+    0x0d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+    0x30, 0x70, 0x70, 0x30, 0x60, 0x38, 0xe0, 0x18, 0xc0, 0x0d, 0x80, 0x07,
+    0x00, 0x07, 0x00, 0x0d, 0x80, 0x18, 0xc0, 0x38, 0xe0, 0x30, 0x60, 0x70,
+    0x70, 0x60, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'Y'
+    0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+    0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x00, 0x07,
+    0x80, 0x0c, 0xc0, 0x18, 0x60, 0x18, 0x60, 0x30, 0x30, 0x30, 0x30, 0x60,
+    0x18, 0x60, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'Z'
+    0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f,
+    0xe0, 0x7f, 0xe0, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0c, 0x00, 0x0e,
+    0x00, 0x06, 0x00, 0x03, 0x00, 0x01, 0x80, 0x00, 0xc0, 0x00, 0x60, 0x7f,
+    0xe0, 0x7f, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '['
+    0x05, 0x00, 0x78, 0x78, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x78, 0x78, 0x00, 0x00, 0x00, 0x00,
+    // '\\'
+    0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x10, 0x10, 0x30, 0x30,
+    0x20, 0x20, 0x60, 0x60, 0x40, 0x40, 0xc0, 0xc0, 0x00, 0x00, 0x00, 0x00,
+    // ']'
+    0x05, 0x00, 0xf0, 0xf0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xf0, 0xf0, 0x00, 0x00, 0x00, 0x00,
+    // '^'
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x41, 0x00, 0x63, 0x00, 0x36, 0x00, 0x1c, 0x00, 0x08,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '_'
+    0x0a, 0x00, 0x00, 0xff, 0xc0, 0xff, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '`'
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x60, 0x60, 0x40, 0x40, 0x20, 0x00, 0x00, 0x00, 0x00,
+    // 'a'
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3b,
+    0x00, 0x77, 0x00, 0x63, 0x00, 0x63, 0x00, 0x73, 0x00, 0x3f, 0x00, 0x07,
+    0x00, 0x63, 0x00, 0x77, 0x00, 0x3e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'b'
+    0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6f,
+    0x00, 0x7f, 0x80, 0x71, 0x80, 0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60,
+    0xc0, 0x71, 0x80, 0x7f, 0x80, 0x6f, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60,
+    0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'c'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f,
+    0x00, 0x3f, 0x80, 0x31, 0x80, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60,
+    0x00, 0x31, 0x80, 0x3f, 0x80, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'd'
+    0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e,
+    0xc0, 0x3f, 0xc0, 0x31, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60,
+    0xc0, 0x31, 0xc0, 0x3f, 0xc0, 0x1e, 0xc0, 0x00, 0xc0, 0x00, 0xc0, 0x00,
+    0xc0, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'e'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1e,
+    0x00, 0x3f, 0x80, 0x71, 0x80, 0x60, 0x00, 0x60, 0x00, 0x7f, 0x80, 0x61,
+    0x80, 0x61, 0x80, 0x3f, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'f'
+    0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0xfc, 0xfc, 0x30, 0x30, 0x3c, 0x1c, 0x00, 0x00, 0x00, 0x00,
+    // 'g'
+    0x0b, 0x00, 0x00, 0x0e, 0x00, 0x3f, 0x80, 0x31, 0x80, 0x00, 0xc0, 0x1e,
+    0xc0, 0x3f, 0xc0, 0x31, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60,
+    0xc0, 0x30, 0xc0, 0x3f, 0xc0, 0x1e, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'h'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61,
+    0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61,
+    0x80, 0x71, 0x80, 0x6f, 0x80, 0x67, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60,
+    0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'i'
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    // 'j'
+    0x04, 0x00, 0xc0, 0xe0, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    // 'k'
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63,
+    0x80, 0x63, 0x00, 0x67, 0x00, 0x66, 0x00, 0x6c, 0x00, 0x7c, 0x00, 0x78,
+    0x00, 0x6c, 0x00, 0x66, 0x00, 0x63, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60,
+    0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'l'
+    0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    // 'm'
+    0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x63,
+    0x18, 0x63, 0x18, 0x63, 0x18, 0x63, 0x18, 0x63, 0x18, 0x63, 0x18, 0x63,
+    0x18, 0x73, 0x98, 0x6f, 0x78, 0x66, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'n'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61,
+    0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61,
+    0x80, 0x71, 0x80, 0x6f, 0x80, 0x67, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'o'
+    0x0b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1f,
+    0x00, 0x3f, 0x80, 0x31, 0x80, 0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60,
+    0xc0, 0x31, 0x80, 0x3f, 0x80, 0x1f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'p'
+    0x0b, 0x00, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x60, 0x00, 0x6f,
+    0x00, 0x7f, 0x80, 0x71, 0x80, 0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60,
+    0xc0, 0x71, 0x80, 0x7f, 0x80, 0x6f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'q'
+    0x0b, 0x00, 0x00, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0xc0, 0x00, 0xc0, 0x1e,
+    0xc0, 0x3f, 0xc0, 0x31, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60, 0xc0, 0x60,
+    0xc0, 0x31, 0xc0, 0x3f, 0xc0, 0x1e, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'r'
+    0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x70, 0x6c, 0x6c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 's'
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c,
+    0x00, 0x7e, 0x00, 0x63, 0x00, 0x03, 0x00, 0x1f, 0x00, 0x7e, 0x00, 0x60,
+    0x00, 0x63, 0x00, 0x3f, 0x00, 0x1e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 't'
+    0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x38, 0x30, 0x30, 0x30, 0x30,
+    0x30, 0x30, 0xfc, 0xfc, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'u'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x39,
+    0x80, 0x7d, 0x80, 0x63, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x61,
+    0x80, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'v'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c,
+    0x00, 0x0c, 0x00, 0x1e, 0x00, 0x12, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33,
+    0x00, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'w'
+    0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0c,
+    0xc0, 0x0c, 0xc0, 0x1c, 0xe0, 0x14, 0xa0, 0x34, 0xb0, 0x33, 0x30, 0x33,
+    0x30, 0x63, 0x18, 0x63, 0x18, 0x63, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'x'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x61,
+    0x80, 0x73, 0x80, 0x33, 0x00, 0x1e, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x1e,
+    0x00, 0x33, 0x00, 0x73, 0x80, 0x61, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'y'
+    0x0a, 0x00, 0x00, 0x38, 0x00, 0x38, 0x00, 0x0c, 0x00, 0x0c, 0x00, 0x0c,
+    0x00, 0x0c, 0x00, 0x1e, 0x00, 0x12, 0x00, 0x33, 0x00, 0x33, 0x00, 0x33,
+    0x00, 0x61, 0x80, 0x61, 0x80, 0x61, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // 'z'
+    0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f,
+    0x00, 0x7f, 0x00, 0x60, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0c, 0x00, 0x06,
+    0x00, 0x03, 0x00, 0x7f, 0x00, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    // '{'
+    0x06, 0x00, 0x0c, 0x18, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x60, 0xc0,
+    0x60, 0x30, 0x30, 0x30, 0x30, 0x30, 0x18, 0x0c, 0x00, 0x00, 0x00, 0x00,
+    // '|'
+    0x04, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
+    0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    // '}'
+    0x06, 0x00, 0xc0, 0x60, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x18, 0x0c,
+    0x18, 0x30, 0x30, 0x30, 0x30, 0x30, 0x60, 0xc0, 0x00, 0x00, 0x00, 0x00,
+    // '~'
+    0x0a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x66, 0x00, 0x3f, 0x00, 0x19,
+    0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const unsigned short HELVETICA18_OFFSETS[] = {
+    0, 24, 48, 72, 119, 166, 213, 260, 284, 308, 332, 356,
+    403, 427, 474, 498, 522, 569, 616, 663, 710, 757, 804, 851,
+    898, 945, 992, 1016, 1040, 1087, 1134, 1181, 1228, 1298, 1345, 1392,
+    1439, 1486, 1533, 1580, 1627, 1674, 1698, 1745, 1792, 1839, 1886, 1933,
+    1980, 2027, 2074, 2121, 2168, 2215, 2262, 2309, 2379, 2426, 2473, 2520,
+    2544, 2568, 2592, 2639, 2686, 2710, 2757, 2804, 2851, 2898, 2945, 2969,
+    3016, 3063, 3087, 3111, 3158, 3182, 3229, 3276, 3323, 3370, 3417, 3441,
+    3488, 3512, 3559, 3606, 3653, 3700, 3747, 3794, 3818, 3842, 3866,
+};
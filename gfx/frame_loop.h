@@ -0,0 +1,85 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Fixed-timestep animation clock.
+// The animation advances in steps of exactly `step` seconds, however
+// fast or unevenly frames are drawn: advance() runs as many steps as the
+// wall-clock time since the previous frame covers, carrying the
+// remainder over. The motion is the same at 30 fps, 60 fps or uncapped.
+// frameDone() counts presented frames and measures the sustained frame
+// rate once a second.
+// ---------------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+
+class FrameLoop {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    // update(dt) advances the animation by dt seconds; null for a static
+    // scene that only wants frame pacing and the frame rate.
+    explicit FrameLoop(void (*update)(double) = nullptr, double step = 1.0 / 60.0,
+        int maxSteps = 8)
+        : update(update), stepSeconds(step), maxSteps(maxSteps) {}
+
+    double step() const { return stepSeconds; }
+    // Animation time: steps taken so far times the step.
+    double time() const { return steps * stepSeconds; }
+
+    // One fixed step, regardless of the clock (headless frames use this).
+    void tick() {
+        if (update) update(stepSeconds);
+        steps++;
+    }
+
+    // Catch the animation up with the clock. After a stall of more than
+    // maxSteps steps the rest is dropped, so the animation slows down
+    // instead of spending ever longer catching up. Returns the steps run.
+    int advance() {
+        Clock::time_point now = Clock::now();
+        if (!started) {
+            started = true;
+            last = rateStart = now;
+        }
+        lag += std::chrono::duration<double>(now - last).count();
+        last = now;
+        int n = 0;
+        for (; lag >= stepSeconds && n < maxSteps; n++) {
+            tick();
+            lag -= stepSeconds;
+        }
+        lag = std::min(lag, stepSeconds);
+        return n;
+    }
+
+    // Count a presented frame. Returns true when a new fps() value is
+    // ready, about once a second.
+    bool frameDone() {
+        frames++;
+        rateFrames++;
+        Clock::time_point now = Clock::now();
+        if (!started) {
+            started = true;
+            last = rateStart = now;
+        }
+        double seconds = std::chrono::duration<double>(now - rateStart).count();
+        if (seconds < 1.0) return false;
+        rate = rateFrames / seconds;
+        rateFrames = 0;
+        rateStart = now;
+        return true;
+    }
+
+    double fps() const { return rate; }
+    long frameCount() const { return frames; }
+
+private:
+    void (*update)(double);
+    double stepSeconds;
+    int maxSteps;
+    long steps = 0;
+    double lag = 0;
+    bool started = false;
+    Clock::time_point last, rateStart;
+    long frames = 0, rateFrames = 0;
+    double rate = 0;
+};
@@ -0,0 +1,253 @@
+#pragma once
+// ---------------------------------------------------------------------
+// CPU framebuffer and image output (binary PPM, uncompressed PNG), plus
+// reading PPM back and comparing images for the golden-image tests.
+// Rows are stored bottom to top like OpenGL window coordinates, so pixel
+// (0,0) is the lower-left corner; the writers flip to top-down order.
+// ---------------------------------------------------------------------
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Pack an 8-bit RGB color into a framebuffer pixel (R in the low byte).
+inline uint32_t packRGB(int r, int g, int b) {
+    return (uint32_t)r | ((uint32_t)g << 8) | ((uint32_t)b << 16) | 0xff000000u;
+}
+
+// Convert a float color the same way GL does for an 8-bit buffer.
+inline uint32_t packColor(float r, float g, float b) {
+    auto channel = [](float c) {
+        if (c < 0.0f) c = 0.0f;
+        if (c > 1.0f) c = 1.0f;
+        return (int)(c * 255.0f + 0.5f);
+    };
+    return packRGB(channel(r), channel(g), channel(b));
+}
+
+// Integer pixel rectangle [x0,x1) x [y0,y1).
+struct PixelRect {
+    int x0, y0, x1, y1;
+
+    bool empty() const { return x0 >= x1 || y0 >= y1; }
+};
+
+inline PixelRect intersectRect(const PixelRect& a, const PixelRect& b) {
+    PixelRect r;
+    r.x0 = a.x0 > b.x0 ? a.x0 : b.x0;
+    r.y0 = a.y0 > b.y0 ? a.y0 : b.y0;
+    r.x1 = a.x1 < b.x1 ? a.x1 : b.x1;
+    r.y1 = a.y1 < b.y1 ? a.y1 : b.y1;
+    return r;
+}
+
+struct Framebuffer {
+    int width = 0, height = 0;
+    std::vector<uint32_t> pixels;
+
+    Framebuffer() {}
+    Framebuffer(int w, int h) : width(w), height(h), pixels((size_t)w * h, packRGB(0, 0, 0)) {}
+
+    uint32_t* row(int y) { return pixels.data() + (size_t)y * width; }
+    const uint32_t* row(int y) const { return pixels.data() + (size_t)y * width; }
+    PixelRect bounds() const { return { 0, 0, width, height }; }
+
+    void fill(uint32_t color, const PixelRect& rect) {
+        PixelRect r = intersectRect(rect, bounds());
+        for (int y = r.y0; y < r.y1; y++) {
+            uint32_t* p = row(y);
+            for (int x = r.x0; x < r.x1; x++)
+                p[x] = color;
+        }
+    }
+};
+
+// Copy the framebuffer into top-down 8-bit RGB rows.
+inline std::vector<unsigned char> framebufferToRGB(const Framebuffer& fb) {
+    std::vector<unsigned char> rgb((size_t)fb.width * fb.height * 3);
+    unsigned char* out = rgb.data();
+    for (int y = fb.height - 1; y >= 0; y--) {
+        const uint32_t* p = fb.row(y);
+        for (int x = 0; x < fb.width; x++) {
+            *out++ = (unsigned char)(p[x] & 0xff);
+            *out++ = (unsigned char)((p[x] >> 8) & 0xff);
+            *out++ = (unsigned char)((p[x] >> 16) & 0xff);
+        }
+    }
+    return rgb;
+}
+
+inline bool writePPM(const Framebuffer& fb, const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    std::vector<unsigned char> rgb = framebufferToRGB(fb);
+    fprintf(f, "P6\n%d %d\n255\n", fb.width, fb.height);
+    bool ok = fwrite(rgb.data(), 1, rgb.size(), f) == rgb.size();
+    return fclose(f) == 0 && ok;
+}
+
+// Read a binary (P6, 8-bit) PPM such as writePPM produces.
+inline bool readPPM(Framebuffer& fb, const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    // Header: magic, width, height, maxval, separated by whitespace or
+    // comments, then exactly one whitespace byte before the pixels.
+    int fields[3], count = 0;
+    bool ok = fgetc(f) == 'P' && fgetc(f) == '6';
+    while (ok && count < 3) {
+        int c = fgetc(f);
+        if (c == '#') {
+            while (c != '\n' && c != EOF) c = fgetc(f);
+        }
+        else if (c >= '0' && c <= '9') {
+            ungetc(c, f);
+            ok = fscanf(f, "%d", &fields[count++]) == 1;
+        }
+        else if (c == EOF || !(c == ' ' || c == '\t' || c == '\r' || c == '\n')) {
+            ok = false;
+        }
+    }
+    ok = ok && fields[0] > 0 && fields[1] > 0 && fields[2] == 255 && fgetc(f) != EOF;
+    if (ok) {
+        std::vector<unsigned char> rgb((size_t)fields[0] * fields[1] * 3);
+        ok = fread(rgb.data(), 1, rgb.size(), f) == rgb.size();
+        if (ok) {
+            fb = Framebuffer(fields[0], fields[1]);
+            const unsigned char* in = rgb.data();
+            for (int y = fb.height - 1; y >= 0; y--) {
+                uint32_t* p = fb.row(y);
+                for (int x = 0; x < fb.width; x++, in += 3)
+                    p[x] = packRGB(in[0], in[1], in[2]);
+            }
+        }
+    }
+    fclose(f);
+    return ok;
+}
+
+// Pixels whose R, G or B differs by more than the tolerance, and the
+// largest channel difference seen. Images of different sizes count every
+// pixel of the larger one.
+struct ImageDiff {
+    long differing;
+    int maxDelta;
+};
+
+inline ImageDiff compareImages(const Framebuffer& a, const Framebuffer& b, int tolerance) {
+    if (a.width != b.width || a.height != b.height)
+        return { (long)std::max(a.pixels.size(), b.pixels.size()), 255 };
+    ImageDiff diff = { 0, 0 };
+    for (size_t i = 0; i < a.pixels.size(); i++) {
+        uint32_t p = a.pixels[i], q = b.pixels[i];
+        if (p == q) continue;
+        int delta = 0;
+        for (int shift = 0; shift < 24; shift += 8)
+            delta = std::max(delta, std::abs((int)((p >> shift) & 0xff) - (int)((q >> shift) & 0xff)));
+        diff.maxDelta = std::max(diff.maxDelta, delta);
+        if (delta > tolerance) diff.differing++;
+    }
+    return diff;
+}
+
+// ---------------------------------------------------------------------
+// PNG writer using stored (uncompressed) deflate blocks, so no zlib is
+// needed. Files are about the size of a PPM.
+// ---------------------------------------------------------------------
+inline uint32_t pngCrc(const unsigned char* data, size_t n, uint32_t crc = 0xffffffffu) {
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        ready = true;
+    }
+    for (size_t i = 0; i < n; i++)
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+
+inline void pngPut32(std::vector<unsigned char>& out, uint32_t v) {
+    out.push_back((unsigned char)(v >> 24));
+    out.push_back((unsigned char)(v >> 16));
+    out.push_back((unsigned char)(v >> 8));
+    out.push_back((unsigned char)v);
+}
+
+inline void pngChunk(std::vector<unsigned char>& out, const char* type,
+    const std::vector<unsigned char>& data) {
+    pngPut32(out, (uint32_t)data.size());
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    pngPut32(out, pngCrc(out.data() + start, out.size() - start) ^ 0xffffffffu);
+}
+
+inline bool writePNG(const Framebuffer& fb, const char* path) {
+    std::vector<unsigned char> rgb = framebufferToRGB(fb);
+    size_t stride = (size_t)fb.width * 3;
+
+    // Raw scanlines, each prefixed with filter type 0.
+    std::vector<unsigned char> raw;
+    raw.reserve((stride + 1) * fb.height);
+    for (int y = 0; y < fb.height; y++) {
+        raw.push_back(0);
+        raw.insert(raw.end(), rgb.begin() + y * stride, rgb.begin() + (y + 1) * stride);
+    }
+
+    // zlib stream: header, stored blocks of at most 65535 bytes, Adler-32.
+    std::vector<unsigned char> z;
+    z.push_back(0x78);
+    z.push_back(0x01);
+    size_t pos = 0;
+    do {
+        size_t len = raw.size() - pos;
+        if (len > 65535) len = 65535;
+        z.push_back(pos + len == raw.size() ? 1 : 0);
+        z.push_back((unsigned char)(len & 0xff));
+        z.push_back((unsigned char)(len >> 8));
+        z.push_back((unsigned char)(~len & 0xff));
+        z.push_back((unsigned char)((~len >> 8) & 0xff));
+        z.insert(z.end(), raw.begin() + pos, raw.begin() + pos + len);
+        pos += len;
+    } while (pos < raw.size());
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < raw.size(); i++) {
+        a = (a + raw[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    pngPut32(z, (b << 16) | a);
+
+    std::vector<unsigned char> header;
+    pngPut32(header, (uint32_t)fb.width);
+    pngPut32(header, (uint32_t)fb.height);
+    header.push_back(8);   // bit depth
+    header.push_back(2);   // color type: RGB
+    header.push_back(0);   // compression
+    header.push_back(0);   // filter
+    header.push_back(0);   // interlace
+
+    static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    std::vector<unsigned char> file(signature, signature + 8);
+    pngChunk(file, "IHDR", header);
+    pngChunk(file, "IDAT", z);
+    pngChunk(file, "IEND", std::vector<unsigned char>());
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(file.data(), 1, file.size(), f) == file.size();
+    return fclose(f) == 0 && ok;
+}
+
+// Write a .png file when the path ends in ".png", otherwise binary PPM.
+inline bool writeImage(const Framebuffer& fb, const char* path) {
+    size_t n = strlen(path);
+    if (n >= 4 && strcmp(path + n - 4, ".png") == 0)
+        return writePNG(fb, path);
+    return writePPM(fb, path);
+}
@@ -0,0 +1,18 @@
+#pragma once
+// Basic geometry types shared by the demos and the gfx modules.
+
+// Define a simple 2D point structure
+struct Point {
+    float x, y;
+};
+
+// Point with another coordinate type (double, Fixed16) for the templated
+// clippers; Point is the float one the demos draw with.
+template <class T>
+struct BasicPoint {
+    T x, y;
+};
+
+// Coordinate type of a point type.
+template <class P>
+using CoordOf = decltype(P::x);
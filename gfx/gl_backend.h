@@ -0,0 +1,123 @@
+#pragma once
+// RenderBackend that forwards every call to OpenGL/GLUT unchanged.
+#include <GL/glut.h>
+#include "circle.h"
+#include "render.h"
+#include "triangulate.h"
+#include <cmath>
+
+class GlBackend : public RenderBackend {
+public:
+    void clearColor(float r, float g, float b, float a) override { glClearColor(r, g, b, a); }
+    void clear() override { glClear(GL_COLOR_BUFFER_BIT); }
+    void color(float r, float g, float b) override { glColor3f(r, g, b); }
+    void lineWidth(float width) override { glLineWidth(width); }
+    void enableScissor(bool enable) override {
+        scissorEnabled = enable;
+        if (enable) glEnable(GL_SCISSOR_TEST);
+        else glDisable(GL_SCISSOR_TEST);
+    }
+    void scissor(int x, int y, int width, int height) override {
+        glScissor(x, y, width, height);
+        scissorBox = { x, y, x + width, y + height };
+    }
+    // Each primitive is submitted as one vertex-array draw. GL only fills
+    // convex polygons correctly, so a concave GL_POLYGON is drawn as the
+    // triangles of its triangulation.
+    void drawPrimitive(GLenum mode, const Point* vertices, int count) override {
+        if (!arraysEnabled) {
+            glEnableClientState(GL_VERTEX_ARRAY);
+            arraysEnabled = true;
+        }
+        if (mode == GL_POLYGON && count > 3 && !isConvexPolygon(vertices, count)) {
+            triangles.clear();
+            triangulator.appendTriangles(vertices, count, triangles);
+            mode = GL_TRIANGLES;
+            vertices = triangles.data();
+            count = (int)triangles.size();
+        }
+        glVertexPointer(2, GL_FLOAT, sizeof(Point), vertices);
+        glDrawArrays(mode, 0, count);
+    }
+    // GL has no ellipse primitive: draw a tessellated one, with the fill
+    // pattern as a polygon stipple.
+    void drawEllipse(float cx, float cy, float rx, float ry, EllipseMode mode, float thickness,
+        const FillPattern* pattern) override {
+        const int segments = 64;
+        Point unit[segments], v[2 * segments + 2];
+        tessellateCircle(0, 0, 1, segments, unit);
+        int n = 0;
+        GLenum primitive;
+        if (mode == ELLIPSE_RING && thickness < rx && thickness < ry) {
+            for (int i = 0; i <= segments; i++) {
+                Point u = unit[i % segments];
+                v[n++] = { cx + rx * u.x, cy + ry * u.y };
+                v[n++] = { cx + (rx - thickness) * u.x, cy + (ry - thickness) * u.y };
+            }
+            primitive = GL_QUAD_STRIP;
+        }
+        else {
+            for (int i = 0; i < segments; i++)
+                v[n++] = { cx + rx * unit[i].x, cy + ry * unit[i].y };
+            primitive = mode == ELLIPSE_OUTLINE ? GL_LINE_LOOP : GL_POLYGON;
+        }
+        glPushAttrib(GL_ENABLE_BIT | GL_LINE_BIT | GL_POLYGON_STIPPLE_BIT);
+        if (primitive == GL_LINE_LOOP)
+            glLineWidth(1.0f);
+        if (pattern) {
+            GLubyte stipple[32 * 4];
+            for (int i = 0; i < 32 * 4; i++)
+                stipple[i] = pattern->rows[(i / 4) & 7];
+            glPolygonStipple(stipple);
+            glEnable(GL_POLYGON_STIPPLE);
+        }
+        drawPrimitive(primitive, v, n);
+        glPopAttrib();
+    }
+    void rasterPos(float x, float y) override { glRasterPos2f(x, y); }
+    void bitmapCharacter(void* font, int character) override { glutBitmapCharacter(font, character); }
+    // Glyphs come from the atlas through glBitmap. With the scissor test on,
+    // glyphs outside the box are skipped by moving the raster position past
+    // them; that needs the string's window position, read back once.
+    void drawText(float x, float y, const TextLayout& layout) override {
+        glRasterPos2f(x, y);
+        if (!layout.atlas) return;
+        const GlyphAtlas& atlas = *layout.atlas;
+        int penX = 0, penY = 0;
+        if (scissorEnabled) {
+            GLboolean valid;
+            glGetBooleanv(GL_CURRENT_RASTER_POSITION_VALID, &valid);
+            if (!valid) return;
+            GLfloat raster[4];
+            glGetFloatv(GL_CURRENT_RASTER_POSITION, raster);
+            penX = (int)std::floor(raster[0] - atlas.xorig);
+            penY = (int)std::floor(raster[1] - atlas.yorig);
+        }
+        glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        int at = 0;     // pen offset of the raster position
+        for (const PlacedGlyph& p : layout.glyphs) {
+            if (scissorEnabled &&
+                intersectRect(glyphBounds(*p.glyph, penX + p.dx, penY), scissorBox).empty())
+                continue;
+            if (p.dx != at)
+                glBitmap(0, 0, 0, 0, (GLfloat)(p.dx - at), 0, nullptr);
+            glBitmap(p.glyph->advance, atlas.height, atlas.xorig, atlas.yorig,
+                (GLfloat)p.glyph->advance, 0, p.glyph->bits);
+            at = p.dx + p.glyph->advance;
+        }
+        if (layout.advance != at)
+            glBitmap(0, 0, 0, 0, (GLfloat)(layout.advance - at), 0, nullptr);
+        glPopClientAttrib();
+    }
+    // Presents the frame: swaps the buffers of a GLUT_DOUBLE window
+    // (GLUT only flushes a single-buffered one).
+    void flush() override { glutSwapBuffers(); }
+
+private:
+    bool arraysEnabled = false;
+    Triangulator triangulator;
+    std::vector<Point> triangles;
+    bool scissorEnabled = false;
+    PixelRect scissorBox = { 0, 0, 0, 0 };
+};
@@ -0,0 +1,80 @@
+#pragma once
+// ---------------------------------------------------------------------
+// GLUT main loop driven by a FrameLoop, for double-buffered windows.
+// Capped, a timer requests a frame every 1/rate seconds against absolute
+// deadlines, so the pace does not drift and does not depend on vsync.
+// Uncapped, frames are redrawn from the idle callback as fast as they
+// can be presented, for throughput measurements. Either way the sustained
+// frame rate is printed once a second and shown in the window title.
+// ---------------------------------------------------------------------
+#include <GL/glut.h>
+#include "frame_loop.h"
+#include "trace.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+struct GlutFrameLoop {
+    FrameLoop* loop = nullptr;
+    void (*display)() = nullptr;
+    std::string title;
+    double period = 0;
+    FrameLoop::Clock::time_point deadline;
+};
+
+inline GlutFrameLoop glutFrameLoop;
+
+// Ask the Mesa and NVIDIA drivers not to wait for vertical blank when
+// uncapped. Must be called before glutInit.
+inline void configureSwapInterval(bool uncapped) {
+    if (!uncapped) return;
+    setenv("vblank_mode", "0", 0);
+    setenv("__GL_SYNC_TO_VBLANK", "0", 0);
+}
+
+inline void glutFrameLoopDisplay() {
+    GlutFrameLoop& s = glutFrameLoop;
+    s.loop->advance();
+    s.display();
+    endTraceFrame();
+    if (s.loop->frameDone()) {
+        char text[64];
+        snprintf(text, sizeof(text), "%.1f fps (%.3f ms/frame)", s.loop->fps(), 1000.0 / s.loop->fps());
+        printf("%s\n", text);
+        fflush(stdout);
+        glutSetWindowTitle((s.title + " - " + text).c_str());
+    }
+}
+
+inline void glutFrameLoopTimer(int) {
+    GlutFrameLoop& s = glutFrameLoop;
+    glutPostRedisplay();
+    FrameLoop::Clock::time_point now = FrameLoop::Clock::now();
+    s.deadline += std::chrono::duration_cast<FrameLoop::Clock::duration>(
+        std::chrono::duration<double>(s.period));
+    // Behind by more than a frame: restart the schedule from now.
+    if (s.deadline < now)
+        s.deadline = now;
+    int ms = (int)std::chrono::duration_cast<std::chrono::milliseconds>(s.deadline - now).count();
+    glutTimerFunc(ms, glutFrameLoopTimer, 0);
+}
+
+// Register display() and the pacing callbacks for the current window.
+// display() should end with gfxFlush(), which swaps the buffers.
+inline void runGlutFrameLoop(FrameLoop& loop, void (*display)(), const char* title, bool uncapped,
+    double rate = 60.0) {
+    GlutFrameLoop& s = glutFrameLoop;
+    s.loop = &loop;
+    s.display = display;
+    s.title = title;
+    s.period = 1.0 / rate;
+    glutDisplayFunc(glutFrameLoopDisplay);
+    if (uncapped) {
+        glutIdleFunc(glutPostRedisplay);
+    }
+    else {
+        s.deadline = FrameLoop::Clock::now();
+        glutTimerFunc(0, glutFrameLoopTimer, 0);
+    }
+}
@@ -0,0 +1,143 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Headless entry point shared by the demo programs: render display() on
+// the CPU with the backend selected by the options and write the image.
+// With a FrameLoop, each of the --repeat frames is one fixed animation
+// step after the previous one, so the output does not depend on timing.
+// --compare checks the image against a golden reference and --perf-log
+// appends the frame timing to a CSV; ctest runs both over every scene.
+// runSaveScene records the frame instead and writes it as a scene file.
+// --save-trace records every frame's draw calls as a trace.
+// ---------------------------------------------------------------------
+#include "frame_loop.h"
+#include "options.h"
+#include "profiler.h"
+#include "scene_file.h"
+#include "soft_backend.h"
+#include "tiled_backend.h"
+#include "trace.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+
+// One CSV row per run, with a header when the file is new, so repeated
+// runs build up a history to spot regressions in.
+inline bool appendPerfLog(const AppOptions& options, const char* kind, int threads,
+    double seconds, long clipOps) {
+    FILE* f = fopen(options.perfLog, "a");
+    if (!f) return false;
+    if (ftell(f) == 0)
+        fprintf(f, "time,program,mode,backend,threads,size,frames,ms_per_frame,fps,clip_ops_per_s\n");
+    char stamp[32];
+    time_t now = time(nullptr);
+    strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+    fprintf(f, "%s,%s,%s,%s,%d,%dx%d,%d,%.4f,%.1f,%.0f\n", stamp, options.program,
+        options.immediate ? "immediate" : options.incremental ? "incremental" : "replay", kind, threads, options.width, options.height,
+        options.repeat, seconds * 1000.0 / options.repeat, options.repeat / seconds, clipOps / seconds);
+    return fclose(f) == 0;
+}
+
+// Compare the rendered image with the --compare reference.
+inline bool matchesReference(const Framebuffer& fb, const AppOptions& options) {
+    Framebuffer reference;
+    if (!readPPM(reference, options.compare)) {
+        fprintf(stderr, "could not read %s\n", options.compare);
+        return false;
+    }
+    ImageDiff diff = compareImages(fb, reference, options.tolerance);
+    bool ok = diff.differing <= options.maxDiff;
+    printf("%s%s: %ld pixel(s) differ from %s by more than %d (max difference %d, %ld allowed)\n",
+        ok ? "" : "** ", options.program, diff.differing, options.compare, options.tolerance,
+        diff.maxDelta, options.maxDiff);
+    return ok;
+}
+
+// The CPU backend the options select, and its description for the logs
+// (kind, 32 bytes) and its thread count.
+inline SoftwareBackend* createHeadlessBackend(const AppOptions& options, char* kind, int* threads) {
+    SoftwareBackend* backend;
+    if (options.untiled) {
+        backend = new SoftwareBackend(options.width, options.height, 0, 500, 0, 500);
+        snprintf(kind, 32, "untiled");
+        *threads = 1;
+    }
+    else {
+        TiledSoftwareBackend* tiled = new TiledSoftwareBackend(options.width, options.height,
+            options.threads, options.tileSize, 0, 500, 0, 500);
+        snprintf(kind, 32, "tiled %dx%d", options.tileSize, options.tileSize);
+        *threads = tiled->threadCount();
+        backend = tiled;
+    }
+    if (options.edgeFill || options.multisampleFill) {
+        backend->setPolygonFill(options.edgeFill ? FILL_EDGE : FILL_MULTISAMPLE, options.samples);
+        size_t len = strlen(kind);
+        len += snprintf(kind + len, 32 - len, options.edgeFill ? " edge" : " multisample");
+        if (options.samples > 1)
+            snprintf(kind + len, 32 - len, " aa%d", options.samples);
+    }
+    return backend;
+}
+
+inline int runHeadless(const AppOptions& options, void (*display)(),
+    float clearR, float clearG, float clearB, FrameLoop* loop = nullptr) {
+    char kind[32];
+    int threads;
+    std::unique_ptr<SoftwareBackend> backend(createHeadlessBackend(options, kind, &threads));
+    gfxUseBackend(backend.get());
+    if (options.saveTrace && !startTraceCapture(options.saveTrace))
+        return 1;
+    gfxClearColor(clearR, clearG, clearB, 1.0f);
+
+    long clipOps0 = clipCallCount;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < options.repeat; i++) {
+        if (loop && i > 0)
+            loop->tick();
+        display();
+        backend->flush();
+        endTraceFrame();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    long clipOps = clipCallCount - clipOps0;
+    if (options.repeat > 1) {
+        printf("%dx%d %s, %d thread(s): %.3f ms/frame (%.1f fps) over %d frames\n",
+            options.width, options.height, kind, threads,
+            seconds * 1000.0 / options.repeat, options.repeat / seconds, options.repeat);
+    }
+
+    if (options.perfLog && !appendPerfLog(options, kind, threads, seconds, clipOps))
+        fprintf(stderr, "could not write %s\n", options.perfLog);
+
+    finishProfile(options.profileOut);
+
+    bool ok = finishTraceCapture();
+    if (!ok)
+        fprintf(stderr, "could not write %s\n", options.saveTrace);
+    ok = backend->writeImage(options.output) && ok;
+    gfxUseBackend(nullptr);
+    if (!ok)
+        fprintf(stderr, "could not write %s\n", options.output);
+    if (ok && options.compare)
+        ok = matchesReference(backend->framebuffer(), options);
+    return ok ? 0 : 1;
+}
+
+// Record one frame of display() and write it to the --save-scene file.
+inline int runSaveScene(const AppOptions& options, void (*display)(),
+    float clearR, float clearG, float clearB) {
+    Scene scene;
+    SceneRecorder recorder(scene);
+    gfxUseBackend(&recorder);
+    gfxClearColor(clearR, clearG, clearB, 1.0f);
+    display();
+    gfxUseBackend(nullptr);
+    if (!writeSceneFile(scene, options.saveScene)) {
+        fprintf(stderr, "could not write %s\n", options.saveScene);
+        return 1;
+    }
+    printf("%s: %zu nodes, %zu vertices\n", options.saveScene, scene.nodes.size(),
+        scene.vertices.size());
+    return 0;
+}
@@ -0,0 +1,213 @@
+#pragma once
+// ---------------------------------------------------------------------
+// DDA and Bresenham rasterization of one-pixel lines between integer
+// pixel endpoints (both endpoints drawn), in three forms:
+//  - scalar reference routines, one line at a time;
+//  - batched routines that step SimdNative::WIDTH lines in lockstep over
+//    structure-of-arrays endpoints, leaving only the pixel stores scalar;
+//  - a span form of Bresenham that fills each row's run of an x-major
+//    line at once instead of deciding pixel by pixel.
+// Every form of an algorithm sets exactly the same pixels. Batches use a
+// single color, so the interleaved order of their stores does not matter.
+// ---------------------------------------------------------------------
+#include "clip.h"
+#include "framebuffer.h"
+#include "simd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+inline void plotPixel(Framebuffer& fb, int x, int y, uint32_t color, const PixelRect& clip) {
+    if (x >= clip.x0 && x < clip.x1 && y >= clip.y0 && y < clip.y1)
+        fb.row(y)[x] = color;
+}
+
+// Step the major axis one pixel at a time and round the accumulated
+// float position on the other.
+inline void ddaLine(Framebuffer& fb, int x0, int y0, int x1, int y1, uint32_t color,
+    const PixelRect& clip) {
+    int dx = x1 - x0, dy = y1 - y0;
+    int steps = std::max(std::abs(dx), std::abs(dy));
+    float xInc = steps ? dx / (float)steps : 0.0f;
+    float yInc = steps ? dy / (float)steps : 0.0f;
+    float x = (float)x0, y = (float)y0;
+    for (int i = 0; i <= steps; i++) {
+        plotPixel(fb, (int)std::floor(x + 0.5f), (int)std::floor(y + 0.5f), color, clip);
+        x += xInc;
+        y += yInc;
+    }
+}
+
+// All-octant integer Bresenham with a single error term.
+inline void bresenhamLine(Framebuffer& fb, int x0, int y0, int x1, int y1, uint32_t color,
+    const PixelRect& clip) {
+    int dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int dy = -std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    while (true) {
+        plotPixel(fb, x0, y0, color, clip);
+        if (x0 == x1 && y0 == y1) break;
+        int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+// Clip a 16.16 segment to the window with the fixed-point Cohen–Sutherland
+// and draw it with Bresenham between the rounded endpoints, so no float is
+// involved between the coordinates and the pixels. Returns false if the
+// segment lies outside the window.
+inline bool bresenhamLineClipped(Framebuffer& fb, FixedPoint a, FixedPoint b,
+    Fixed16 xmin, Fixed16 xmax, Fixed16 ymin, Fixed16 ymax, uint32_t color, const PixelRect& clip) {
+    if (!cohenSutherlandClip(a.x, a.y, b.x, b.y, xmin, xmax, ymin, ymax))
+        return false;
+    bresenhamLine(fb, a.x.round(), a.y.round(), b.x.round(), b.y.round(), color, clip);
+    return true;
+}
+
+// Bresenham by row runs. On an x-major line, step i lands on row
+// y0 + sy * floor((2 * i * |dy| + |dx|) / (2 * |dx|)), which is what
+// bresenhamLine computes; the last step on row k is therefore
+// (|dx| * (2k + 1) - 1) / (2 * |dy|). Y-major lines have one pixel per
+// row and go through bresenhamLine.
+inline void bresenhamLineSpans(Framebuffer& fb, int x0, int y0, int x1, int y1, uint32_t color,
+    const PixelRect& clip) {
+    int adx = std::abs(x1 - x0), ady = std::abs(y1 - y0);
+    if (adx < ady) {
+        bresenhamLine(fb, x0, y0, x1, y1, color, clip);
+        return;
+    }
+    int sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    int first = 0;
+    for (int k = 0; k <= ady; k++) {
+        int last = ady ? (int)std::min<long long>(adx, ((long long)adx * (2 * k + 1) - 1) / (2 * ady)) : adx;
+        int y = y0 + sy * k;
+        if (y >= clip.y0 && y < clip.y1) {
+            int a = sx > 0 ? x0 + first : x0 - last;
+            int b = sx > 0 ? x0 + last : x0 - first;
+            a = std::max(a, clip.x0);
+            b = std::min(b, clip.x1 - 1);
+            uint32_t* row = fb.row(y);
+            for (int x = a; x <= b; x++)
+                row[x] = color;
+        }
+        first = last + 1;
+    }
+}
+
+// Store the visible lanes' pixels.
+template <class V>
+inline void plotLanes(Framebuffer& fb, typename V::F x, typename V::F y, typename V::M visible,
+    uint32_t color) {
+    int bits = V::bits(visible);
+    if (!bits) return;
+    int px[V::WIDTH], py[V::WIDTH];
+    V::storeInt(px, x);
+    V::storeInt(py, y);
+    for (int lane = 0; lane < V::WIDTH; lane++)
+        if (bits & (1 << lane))
+            fb.row(py[lane])[px[lane]] = color;
+}
+
+template <class V>
+inline typename V::M insideClip(typename V::F x, typename V::F y, const PixelRect& clip) {
+    return V::maskAnd(V::maskAnd(V::ge(x, V::set1((float)clip.x0)), V::lt(x, V::set1((float)clip.x1))),
+        V::maskAnd(V::ge(y, V::set1((float)clip.y0)), V::lt(y, V::set1((float)clip.y1))));
+}
+
+// Longest step count in a group of lanes.
+template <class V>
+inline int maxLaneSteps(typename V::F steps) {
+    float s[V::WIDTH];
+    V::store(s, steps);
+    float m = s[0];
+    for (int lane = 1; lane < V::WIDTH; lane++)
+        m = std::max(m, s[lane]);
+    return (int)m;
+}
+
+// DDA over one group of V::WIDTH lines, with the same float operations
+// as ddaLine so every lane rounds identically.
+template <class V>
+inline void ddaLineLanes(Framebuffer& fb, const int* x0, const int* y0, const int* x1,
+    const int* y1, uint32_t color, const PixelRect& clip) {
+    typedef typename V::F F;
+    const F zero = V::set1(0.0f), one = V::set1(1.0f), half = V::set1(0.5f);
+    F x = V::loadInt(x0), y = V::loadInt(y0);
+    F dx = V::sub(V::loadInt(x1), x), dy = V::sub(V::loadInt(y1), y);
+    F steps = V::max(V::max(dx, V::sub(zero, dx)), V::max(dy, V::sub(zero, dy)));
+    typename V::M moving = V::gt(steps, zero);
+    F xInc = V::select(moving, V::div(dx, steps), zero);
+    F yInc = V::select(moving, V::div(dy, steps), zero);
+    int count = maxLaneSteps<V>(steps);
+    F step = zero;
+    for (int i = 0; i <= count; i++) {
+        F px = V::floor(V::add(x, half)), py = V::floor(V::add(y, half));
+        plotLanes<V>(fb, px, py, V::maskAnd(V::le(step, steps), insideClip<V>(px, py, clip)), color);
+        x = V::add(x, xInc);
+        y = V::add(y, yInc);
+        step = V::add(step, one);
+    }
+}
+
+// Bresenham over one group of V::WIDTH lines. Coordinates and the error
+// term are integers held exactly in float lanes (|values| < 2^24).
+template <class V>
+inline void bresenhamLineLanes(Framebuffer& fb, const int* x0, const int* y0, const int* x1,
+    const int* y1, uint32_t color, const PixelRect& clip) {
+    typedef typename V::F F;
+    typedef typename V::M M;
+    const F zero = V::set1(0.0f), one = V::set1(1.0f), minusOne = V::set1(-1.0f);
+    F x = V::loadInt(x0), y = V::loadInt(y0);
+    F ex = V::loadInt(x1), ey = V::loadInt(y1);
+    F ddx = V::sub(ex, x), ddy = V::sub(ey, y);
+    F dx = V::max(ddx, V::sub(zero, ddx));
+    F dy = V::min(ddy, V::sub(zero, ddy));
+    F sx = V::select(V::lt(x, ex), one, minusOne);
+    F sy = V::select(V::lt(y, ey), one, minusOne);
+    F err = V::add(dx, dy);
+    F steps = V::max(dx, V::sub(zero, dy));
+    int count = maxLaneSteps<V>(steps);
+    F step = zero;
+    for (int i = 0; i <= count; i++) {
+        plotLanes<V>(fb, x, y, V::maskAnd(V::le(step, steps), insideClip<V>(x, y, clip)), color);
+        F e2 = V::add(err, err);
+        M stepX = V::ge(e2, dy), stepY = V::le(e2, dx);
+        err = V::add(err, V::add(V::select(stepX, dy, zero), V::select(stepY, dx, zero)));
+        x = V::add(x, V::select(stepX, sx, zero));
+        y = V::add(y, V::select(stepY, sy, zero));
+        step = V::add(step, one);
+    }
+}
+
+// Draw n lines given as structure-of-arrays endpoints, V::WIDTH at a
+// time; the leftover tail goes through the same kernel with one lane.
+template <class V>
+inline void ddaLineBatchWith(Framebuffer& fb, const int* x0, const int* y0, const int* x1,
+    const int* y1, int n, uint32_t color, const PixelRect& clip) {
+    int i = 0;
+    for (; i + V::WIDTH <= n; i += V::WIDTH)
+        ddaLineLanes<V>(fb, x0 + i, y0 + i, x1 + i, y1 + i, color, clip);
+    for (; i < n; i++)
+        ddaLineLanes<SimdScalar>(fb, x0 + i, y0 + i, x1 + i, y1 + i, color, clip);
+}
+
+template <class V>
+inline void bresenhamLineBatchWith(Framebuffer& fb, const int* x0, const int* y0, const int* x1,
+    const int* y1, int n, uint32_t color, const PixelRect& clip) {
+    int i = 0;
+    for (; i + V::WIDTH <= n; i += V::WIDTH)
+        bresenhamLineLanes<V>(fb, x0 + i, y0 + i, x1 + i, y1 + i, color, clip);
+    for (; i < n; i++)
+        bresenhamLineLanes<SimdScalar>(fb, x0 + i, y0 + i, x1 + i, y1 + i, color, clip);
+}
+
+inline void ddaLineBatch(Framebuffer& fb, const int* x0, const int* y0, const int* x1,
+    const int* y1, int n, uint32_t color, const PixelRect& clip) {
+    ddaLineBatchWith<SimdNative>(fb, x0, y0, x1, y1, n, color, clip);
+}
+
+inline void bresenhamLineBatch(Framebuffer& fb, const int* x0, const int* y0, const int* x1,
+    const int* y1, int n, uint32_t color, const PixelRect& clip) {
+    bresenhamLineBatchWith<SimdNative>(fb, x0, y0, x1, y1, n, color, clip);
+}
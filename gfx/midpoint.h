@@ -0,0 +1,178 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Integer midpoint circle and ellipse rasterization.
+// The midpoint algorithm walks one quadrant of the outline with integer
+// decision variables and records, for every row, how far the outline
+// reaches. From those half-widths the shape is produced as horizontal
+// spans (filled, one-pixel outline, or a ring of given thickness), so
+// filling costs one run per row instead of one test per pixel.
+// Spans only depend on the shape, never on the clip rectangle, so the
+// tiled backend gets the same pixels as a full-screen pass.
+// ---------------------------------------------------------------------
+#include "framebuffer.h"
+#include <algorithm>
+#include <vector>
+
+enum EllipseMode { ELLIPSE_FILLED, ELLIPSE_OUTLINE, ELLIPSE_RING };
+
+// 8x8 pattern repeated over the window, like a GL polygon stipple: row 0
+// is the bottom row, and the most significant bit is the leftmost pixel.
+// Pixels whose bit is clear are left untouched.
+struct FillPattern {
+    unsigned char rows[8];
+};
+
+inline constexpr FillPattern PATTERN_SOLID = { { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff } };
+inline constexpr FillPattern PATTERN_HORIZONTAL = { { 0xff, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00 } };
+inline constexpr FillPattern PATTERN_VERTICAL = { { 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88 } };
+inline constexpr FillPattern PATTERN_DIAGONAL = { { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 } };
+inline constexpr FillPattern PATTERN_CROSSHATCH = { { 0xff, 0x88, 0x88, 0x88, 0xff, 0x88, 0x88, 0x88 } };
+inline constexpr FillPattern PATTERN_DOTS = { { 0x88, 0x00, 0x22, 0x00, 0x88, 0x00, 0x22, 0x00 } };
+inline constexpr FillPattern PATTERN_CHECKER = { { 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55, 0xaa, 0x55 } };
+
+// widths[dy] = largest x such that (x, dy) is on the midpoint circle of
+// radius r, for dy = 0..r.
+inline void midpointCircleWidths(int r, int* widths) {
+    int x = 0, y = r, d = 1 - r;
+    while (x <= y) {
+        widths[y] = x;      // x grows, so the last write per row is the widest
+        widths[x] = y;      // mirrored octant: each row is written once
+        if (d < 0) {
+            d += 2 * x + 3;
+        }
+        else {
+            d += 2 * (x - y) + 5;
+            y--;
+        }
+        x++;
+    }
+}
+
+// widths[dy] = largest x such that (x, dy) is on the midpoint ellipse with
+// semi-axes rx, ry, for dy = 0..ry. Decision variables are scaled by 4 so
+// the half-pixel midpoints stay in integers.
+inline void midpointEllipseWidths(int rx, int ry, int* widths) {
+    if (rx == ry) {
+        midpointCircleWidths(rx, widths);
+        return;
+    }
+    if (ry == 0) {
+        widths[0] = rx;
+        return;
+    }
+    long long rx2 = (long long)rx * rx, ry2 = (long long)ry * ry;
+    int x = 0, y = ry;
+    long long px = 0, py = 2 * rx2 * y;
+    widths[y] = 0;
+
+    // Region 1: slope above -1, step x every iteration.
+    long long p = 4 * ry2 - 4 * rx2 * ry + rx2;
+    while (px < py) {
+        x++;
+        px += 2 * ry2;
+        if (p < 0) {
+            p += 4 * (ry2 + px);
+        }
+        else {
+            y--;
+            py -= 2 * rx2;
+            p += 4 * (ry2 + px - py);
+        }
+        widths[y] = x;
+    }
+
+    // Region 2: slope below -1, step y every iteration.
+    p = ry2 * (2 * x + 1) * (2 * x + 1) + 4 * rx2 * (y - 1) * (y - 1) - 4 * rx2 * ry2;
+    while (y > 0) {
+        y--;
+        py -= 2 * rx2;
+        if (p > 0) {
+            p += 4 * (rx2 - py);
+        }
+        else {
+            x++;
+            px += 2 * ry2;
+            p += 4 * (rx2 - py + px);
+        }
+        widths[y] = x;
+    }
+    // Very flat ellipses can leave region 2 short of the end of the axis.
+    widths[0] = rx;
+}
+
+// Call span(y, x0, x1) for every horizontal run [x0, x1) of the ellipse
+// centered on pixel (cx, cy). Rings keep 'thickness' pixels inside the
+// outline; a thickness that reaches the center gives a filled ellipse.
+template<class SpanFn>
+inline void ellipseSpans(int cx, int cy, int rx, int ry, EllipseMode mode, int thickness,
+    SpanFn span) {
+    if (rx < 0 || ry < 0) return;
+    thread_local std::vector<int> outer, inner;
+    outer.resize(ry + 2);
+    midpointEllipseWidths(rx, ry, outer.data());
+    outer[ry + 1] = -1;
+
+    int innerRx = rx - thickness, innerRy = ry - thickness;
+    if (mode == ELLIPSE_RING && (thickness < 1 || innerRx < 0 || innerRy < 0))
+        mode = ELLIPSE_FILLED;
+    if (mode == ELLIPSE_RING) {
+        inner.resize(innerRy + 1);
+        midpointEllipseWidths(innerRx, innerRy, inner.data());
+    }
+
+    for (int dy = 0; dy <= ry; dy++) {
+        int hi = outer[dy], lo;
+        switch (mode) {
+        case ELLIPSE_OUTLINE:
+            // The outline is an 8-connected path: this row holds the pixels
+            // between the previous row's reach and its own.
+            lo = std::min(hi, outer[dy + 1] + 1);
+            break;
+        case ELLIPSE_RING:
+            lo = dy <= innerRy ? inner[dy] + 1 : 0;
+            break;
+        default:
+            lo = 0;
+            break;
+        }
+        for (int side = 0; side < (dy ? 2 : 1); side++) {
+            int y = side ? cy - dy : cy + dy;
+            if (lo == 0) {
+                span(y, cx - hi, cx + hi + 1);
+            }
+            else {
+                span(y, cx - hi, cx - lo + 1);
+                span(y, cx + lo, cx + hi + 1);
+            }
+        }
+    }
+}
+
+// Fill [x0, x1) on row y, through the pattern when one is given.
+inline void fillSpan(Framebuffer& fb, int y, int x0, int x1, uint32_t color,
+    const FillPattern* pattern, const PixelRect& clip) {
+    if (y < clip.y0 || y >= clip.y1) return;
+    x0 = std::max(x0, clip.x0);
+    x1 = std::min(x1, clip.x1);
+    uint32_t* row = fb.row(y);
+    if (!pattern) {
+        for (int x = x0; x < x1; x++)
+            row[x] = color;
+        return;
+    }
+    unsigned bits = pattern->rows[y & 7];
+    for (int x = x0; x < x1; x++)
+        if (bits & (0x80u >> (x & 7)))
+            row[x] = color;
+}
+
+// Rasterize an ellipse centered on pixel (cx, cy) into the framebuffer.
+inline void drawMidpointEllipse(Framebuffer& fb, int cx, int cy, int rx, int ry,
+    EllipseMode mode, int thickness, uint32_t color, const FillPattern* pattern,
+    const PixelRect& clip) {
+    if (cy + ry < clip.y0 || cy - ry >= clip.y1 || cx + rx < clip.x0 || cx - rx >= clip.x1)
+        return;
+    ellipseSpans(cx, cy, rx, ry, mode, thickness, [&](int y, int x0, int x1) {
+        fillSpan(fb, y, x0, x1, color, pattern, clip);
+    });
+}
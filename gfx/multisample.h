@@ -0,0 +1,210 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Multisampled scanline coverage: polygon fill with 1, 4 or 8 samples
+// per pixel, for anti-aliasing.
+// Each sample row of a pixel row is a scanline of its own. Its edge
+// crossings are computed and sorted with fillPolygon's own expression,
+// and a sample is covered when an odd number of crossings lie at or left
+// of it (the even-odd rule of fillPolygon), so with one sample at the
+// pixel center the pixels are exactly fillPolygon's.
+// Runs of pixels between crossings have one coverage and are written
+// directly. Only the blocks of S::WIDTH pixels a crossing falls in, and
+// rows a few blocks wide, are resolved per sample, a compare per
+// crossing over the block. That is 4 lanes with the SSE2 of any x86-64
+// build and 8 with AVX2 (-DGFX_NATIVE=ON), but on scenes of large
+// polygons few pixels take that path, and one sample costs more than
+// fillPolygon's spans; the aliased fill exists to check this one against
+// fillPolygon.
+// With 4 or 8 samples the color is blended by the fraction of samples
+// covered. As with GL_POLYGON_SMOOTH, an edge shared by two polygons is
+// blended twice.
+// ---------------------------------------------------------------------
+#include "framebuffer.h"
+#include "geom.h"
+#include "simd.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Sample positions inside a pixel, each in a different sample row: the
+// center for 1 sample, a rotated grid for 4 and the D3D pattern for 8.
+struct SamplePattern {
+    int count;
+    float dx[8], dy[8];
+};
+
+inline const SamplePattern& samplePattern(int samples) {
+    static const SamplePattern one = { 1, { 0.5f }, { 0.5f } };
+    static const SamplePattern four = { 4,
+        { 0.375f, 0.875f, 0.125f, 0.625f },
+        { 0.125f, 0.375f, 0.625f, 0.875f } };
+    static const SamplePattern eight = { 8,
+        { 0.5625f, 0.4375f, 0.8125f, 0.3125f, 0.1875f, 0.0625f, 0.6875f, 0.9375f },
+        { 0.3125f, 0.6875f, 0.5625f, 0.1875f, 0.8125f, 0.4375f, 0.9375f, 0.0625f } };
+    return samples >= 8 ? eight : samples >= 4 ? four : one;
+}
+
+// dst with color laid over covered of samples parts of it.
+inline uint32_t blendCoverage(uint32_t dst, uint32_t color, int covered, int samples) {
+    if (covered >= samples) return color;
+    uint32_t out = 0xff000000u;
+    for (int shift = 0; shift < 24; shift += 8) {
+        int c = (color >> shift) & 0xff, d = (dst >> shift) & 0xff;
+        out |= (uint32_t)((c * covered + d * (samples - covered) + samples / 2) / samples) << shift;
+    }
+    return out;
+}
+
+template <class S>
+void fillPolygonSamplesWith(Framebuffer& fb, const Point* pts, int n, uint32_t color,
+    const PixelRect& clip, int samples) {
+    if (n < 3) return;
+    const SamplePattern& pattern = samplePattern(samples);
+    const int count = pattern.count, W = S::WIDTH;
+    float ymin = pts[0].y, ymax = pts[0].y;
+    for (int i = 1; i < n; i++) {
+        ymin = std::min(ymin, pts[i].y);
+        ymax = std::max(ymax, pts[i].y);
+    }
+    int yStart = std::max(clip.y0, (int)std::floor(ymin));
+    int yEnd = std::min(clip.y1, (int)std::floor(ymax) + 1);
+
+    // Edges keep their direction: the crossing expression depends on it.
+    struct Edge {
+        Point a, b;
+    };
+    thread_local std::vector<Edge> activeEdges;
+    thread_local std::vector<float> crossings[8];
+    std::vector<Edge>& active = activeEdges;
+    std::vector<float>* xs = crossings;
+    float lanes[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    const typename S::F laneX = S::load(lanes), one = S::set1(1.0f), zero = S::set1(0.0f);
+    float coverage[8];
+
+    // Several sample rows share the edges spanning their pixel row; with
+    // one, every edge is tested once per row anyway.
+    if (count == 1) {
+        active.clear();
+        Point a = pts[n - 1];
+        for (int i = 0; i < n; i++) {
+            active.push_back({ a, pts[i] });
+            a = pts[i];
+        }
+    }
+    for (int y = yStart; y < yEnd; y++) {
+        if (count > 1) {
+            active.clear();
+            Point a = pts[n - 1];
+            for (int i = 0; i < n; i++) {
+                Point b = pts[i];
+                if (std::max(a.y, b.y) >= (float)y && std::min(a.y, b.y) <= (float)(y + 1))
+                    active.push_back({ a, b });
+                a = b;
+            }
+            if (active.empty()) continue;
+        }
+
+        // Crossings of each sample row, sorted.
+        float xlo = 0, xhi = 0;
+        bool any = false;
+        for (int s = 0; s < count; s++) {
+            float yc = y + pattern.dy[s];
+            std::vector<float>& row = xs[s];
+            row.clear();
+            for (const Edge& e : active) {
+                if ((e.a.y <= yc) != (e.b.y <= yc))
+                    row.push_back(e.a.x + (yc - e.a.y) * (e.b.x - e.a.x) / (e.b.y - e.a.y));
+            }
+            if (row.empty()) continue;
+            if (row.size() == 2) {
+                if (row[0] > row[1]) std::swap(row[0], row[1]);
+            }
+            else {
+                std::sort(row.begin(), row.end());
+            }
+            xlo = any ? std::min(xlo, row.front()) : row.front();
+            xhi = any ? std::max(xhi, row.back()) : row.back();
+            any = true;
+        }
+        if (!any) continue;
+        // Left of every crossing and right of every crossing nothing is covered.
+        int x0 = std::max(clip.x0, (int)std::floor(xlo) - 1);
+        int x1 = std::min(clip.x1, (int)std::ceil(xhi) + 1);
+        if (x0 >= x1) continue;
+
+        // next[s]: crossings of sample row s the sample of pixel x is past.
+        int next[8];
+        for (int s = 0; s < count; s++) {
+            next[s] = 0;
+            while (next[s] < (int)xs[s].size() && xs[s][next[s]] <= x0 + pattern.dx[s])
+                next[s]++;
+        }
+        uint32_t* pixels = fb.row(y);
+        // Rows a few blocks wide are evaluated whole.
+        bool runs = x1 - x0 > 4 * W;
+        for (int x = x0; x < x1;) {
+            // Pixels up to the first one past another crossing share a coverage.
+            int covered = 0, runEnd = runs ? x1 : x;
+            for (int s = 0; s < count && runs; s++) {
+                covered += next[s] & 1;
+                if (next[s] < (int)xs[s].size()) {
+                    float c = xs[s][next[s]];
+                    int first = (int)std::ceil(c - pattern.dx[s]);
+                    while ((float)(first - 1) + pattern.dx[s] >= c) first--;
+                    while ((float)first + pattern.dx[s] < c) first++;
+                    runEnd = std::min(runEnd, first);
+                }
+            }
+            if (runEnd > x) {
+                if (covered == count) {
+                    std::fill(pixels + x, pixels + runEnd, color);
+                }
+                else if (covered > 0) {
+                    for (int i = x; i < runEnd; i++)
+                        pixels[i] = blendCoverage(pixels[i], color, covered, count);
+                }
+                x = runEnd;
+                continue;
+            }
+
+            // A crossing in this block: test each sample against the
+            // crossings up to its last pixel.
+            typename S::F cov = zero, px = S::add(S::set1((float)x), laneX);
+            typename S::M inside = S::maskFalse();
+            for (int s = 0; s < count; s++) {
+                typename S::F sx = S::add(px, S::set1(pattern.dx[s]));
+                inside = (next[s] & 1) ? S::maskTrue() : S::maskFalse();
+                float last = (float)(x + W - 1) + pattern.dx[s];
+                const std::vector<float>& row = xs[s];
+                while (next[s] < (int)row.size() && row[next[s]] <= last) {
+                    inside = S::maskXor(inside, S::ge(sx, S::set1(row[next[s]])));
+                    next[s]++;
+                }
+                if (count > 1)
+                    cov = S::add(cov, S::select(inside, one, zero));
+            }
+            int end = std::min(x1, x + W);
+            if (count == 1) {
+                // Aliased: the mask is the coverage.
+                int bits = S::bits(inside);
+                for (int i = x; i < end; i++, bits >>= 1)
+                    if (bits & 1) pixels[i] = color;
+            }
+            else {
+                S::store(coverage, cov);
+                for (int i = x; i < end; i++) {
+                    int k = (int)coverage[i - x];
+                    if (k > 0)
+                        pixels[i] = blendCoverage(pixels[i], color, k, count);
+                }
+            }
+            x += W;
+        }
+    }
+}
+
+// Fill with the widest SIMD the build enables; samples is 1, 4 or 8.
+inline void fillPolygonSamples(Framebuffer& fb, const Point* pts, int n, uint32_t color,
+    const PixelRect& clip, int samples = 1) {
+    fillPolygonSamplesWith<SimdNative>(fb, pts, n, color, clip, samples);
+}
@@ -0,0 +1,169 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Command-line options shared by the demo programs.
+//
+//   --headless out.png|out.ppm   render one frame on the CPU and exit
+//   --size WxH                   framebuffer size for headless output
+//   --threads N                  rasterizer threads (default: all cores)
+//   --tile N                     tile size of the threaded rasterizer (64)
+//   --untiled                    single-threaded, untiled rasterizer
+//   --fill F                     polygon fill of the CPU rasterizer:
+//                                scanline, edge or multisample
+//   --aa N                       anti-alias polygons with 4 or 8 samples
+//                                (implies --fill edge unless multisample)
+//   --immediate                  redraw with the draw functions every frame
+//                                instead of replaying the recorded scene
+//   --incremental                redraw only the rectangles that changed
+//                                since the previous frame (gfx/dirty.h)
+//   --liang-barsky               clip the clock with Liang–Barsky
+//   --repeat N                   render N frames and report the timing
+//   --uncapped                   redraw as fast as possible (no frame cap
+//                                or vsync) and report the sustained fps
+//   --fps N                      frame rate of the capped loop (60)
+//   --profile                    time every draw function and print p50/p99
+//                                per stage (an overlay in the window)
+//   --profile-out out.csv|.json  also write every frame's samples
+//   --compare ref.ppm            compare the headless image with a reference
+//                                and exit with 1 if it differs
+//   --tolerance N                per-channel difference --compare ignores (0)
+//   --max-diff N                 pixels allowed to differ beyond it (0)
+//   --perf-log perf.csv          append the frame rate and clip operations
+//                                per second of the --repeat frames
+//   --save-scene out.gfxs        write the first frame as a binary scene
+//                                file (gfx/scene_file.h) and exit
+//   --scene in.gfxs              scene file for sceneview to draw
+//   --save-trace out.gfxt        record every draw call of the run, frame
+//                                by frame, as a trace (gfx/trace.h)
+//   --trace in.gfxt              trace for tracereplay to replay
+// ---------------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+struct AppOptions {
+    bool headless = false;
+    const char* output = "out.ppm";
+    int width = 500, height = 500;
+    int threads = 0;
+    int tileSize = 64;
+    bool untiled = false;
+    bool edgeFill = false;
+    bool multisampleFill = false;
+    int samples = 1;
+    int repeat = 1;
+    bool immediate = false;
+    bool incremental = false;
+    bool liangBarsky = false;
+    bool uncapped = false;
+    double frameRate = 60.0;
+    bool profile = false;
+    const char* profileOut = nullptr;
+    const char* compare = nullptr;
+    int tolerance = 0;
+    long maxDiff = 0;
+    const char* perfLog = nullptr;
+    const char* saveScene = nullptr;
+    const char* scene = nullptr;
+    const char* saveTrace = nullptr;
+    const char* trace = nullptr;
+    const char* program = "";       // argv[0] without its directory
+};
+
+inline AppOptions parseAppOptions(int argc, char** argv) {
+    AppOptions options;
+    if (argc > 0) {
+        const char* slash = strrchr(argv[0], '/');
+        options.program = slash ? slash + 1 : argv[0];
+    }
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--headless") == 0 && i + 1 < argc) {
+            options.headless = true;
+            options.output = argv[++i];
+        }
+        else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2 ||
+                options.width <= 0 || options.height <= 0) {
+                fprintf(stderr, "bad --size '%s', expected WxH\n", argv[i]);
+                exit(1);
+            }
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.threads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--tile") == 0 && i + 1 < argc) {
+            options.tileSize = std::max(8, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--untiled") == 0) {
+            options.untiled = true;
+        }
+        else if (strcmp(argv[i], "--fill") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "edge") != 0 && strcmp(argv[i], "multisample") != 0 &&
+                strcmp(argv[i], "scanline") != 0) {
+                fprintf(stderr, "bad --fill '%s', expected scanline, edge or multisample\n", argv[i]);
+                exit(1);
+            }
+            options.edgeFill = strcmp(argv[i], "edge") == 0;
+            options.multisampleFill = strcmp(argv[i], "multisample") == 0;
+        }
+        else if (strcmp(argv[i], "--aa") == 0 && i + 1 < argc) {
+            options.samples = atoi(argv[++i]);
+            if (options.samples != 1 && options.samples != 4 && options.samples != 8) {
+                fprintf(stderr, "bad --aa '%s', expected 1, 4 or 8\n", argv[i]);
+                exit(1);
+            }
+            if (options.samples > 1 && !options.multisampleFill) options.edgeFill = true;
+        }
+        else if (strcmp(argv[i], "--immediate") == 0) {
+            options.immediate = true;
+        }
+        else if (strcmp(argv[i], "--incremental") == 0) {
+            options.incremental = true;
+        }
+        else if (strcmp(argv[i], "--liang-barsky") == 0) {
+            options.liangBarsky = true;
+        }
+        else if (strcmp(argv[i], "--uncapped") == 0) {
+            options.uncapped = true;
+        }
+        else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            options.frameRate = std::max(1.0, atof(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--profile") == 0) {
+            options.profile = true;
+        }
+        else if (strcmp(argv[i], "--profile-out") == 0 && i + 1 < argc) {
+            options.profile = true;
+            options.profileOut = argv[++i];
+        }
+        else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc) {
+            options.compare = argv[++i];
+        }
+        else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            options.tolerance = std::max(0, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--max-diff") == 0 && i + 1 < argc) {
+            options.maxDiff = std::max(0L, atol(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--perf-log") == 0 && i + 1 < argc) {
+            options.perfLog = argv[++i];
+        }
+        else if (strcmp(argv[i], "--save-scene") == 0 && i + 1 < argc) {
+            options.saveScene = argv[++i];
+        }
+        else if (strcmp(argv[i], "--scene") == 0 && i + 1 < argc) {
+            options.scene = argv[++i];
+        }
+        else if (strcmp(argv[i], "--save-trace") == 0 && i + 1 < argc) {
+            options.saveTrace = argv[++i];
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            options.trace = argv[++i];
+        }
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            options.repeat = std::max(1, atoi(argv[++i]));
+        }
+    }
+    return options;
+}
@@ -0,0 +1,385 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Sutherland–Hodgman polygon clipping.
+// Each clip edge is a compile-time ClipEdge, and the clippers are
+// templates on the point type (Point, BasicPoint<double>, FixedPoint), so
+// every edge test and intersection is specialized and inlined.
+// clipPolygonEdge is one pass against one edge; sutherlandHodgmanClip
+// chains the four passes.
+// The single-pass clipper pushes each vertex through the left, right,
+// bottom and top stages in turn instead of building a new polygon per
+// edge; every stage only remembers its first and previous vertex, and the
+// clipped polygon is written straight into a caller-supplied buffer, so
+// clipping allocates nothing.
+// clipPolygonOutside computes the difference instead: the parts of a
+// polygon outside the rectangle, as separate pieces.
+// clipPolygonConvex does the same clip against any convex region, one
+// pass per edge of the region.
+// ---------------------------------------------------------------------
+#include "fixed.h"
+#include "geom.h"
+#include <algorithm>
+#include <vector>
+
+enum ClipEdge {
+    CLIP_LEFT,      // x >= bound
+    CLIP_RIGHT,     // x <= bound
+    CLIP_BOTTOM,    // y >= bound
+    CLIP_TOP        // y <= bound
+};
+
+// Where the segment from (p0, q0) to (p1, q1) crosses p = b, on the q axis:
+// q0 + (b - p0) / (p1 - p0) * (q1 - q0).
+template <class T>
+inline T clipLerp(T b, T p0, T p1, T q0, T q1) {
+    T t = (b - p0) / (p1 - p0);
+    return q0 + t * (q1 - q0);
+}
+
+// Fixed point has no room for a fractional t: scale before dividing.
+inline Fixed16 clipLerp(Fixed16 b, Fixed16 p0, Fixed16 p1, Fixed16 q0, Fixed16 q1) {
+    return q0 + mulDiv(b - p0, q1 - q0, p1 - p0);
+}
+
+template <ClipEdge E, class P>
+inline bool insideEdge(const P& p, CoordOf<P> bound) {
+    if constexpr (E == CLIP_LEFT) return p.x >= bound;
+    else if constexpr (E == CLIP_RIGHT) return p.x <= bound;
+    else if constexpr (E == CLIP_BOTTOM) return p.y >= bound;
+    else return p.y <= bound;
+}
+
+// Intersection of prev -> curr with the edge; the two must be on
+// opposite sides of it.
+template <ClipEdge E, class P>
+inline P intersectEdge(const P& prev, const P& curr, CoordOf<P> bound) {
+    if constexpr (E == CLIP_LEFT || E == CLIP_RIGHT)
+        return { bound, clipLerp(bound, prev.x, curr.x, prev.y, curr.y) };
+    else
+        return { clipLerp(bound, prev.y, curr.y, prev.x, curr.x), bound };
+}
+
+// One Sutherland–Hodgman pass: clip poly[0..n) against edge E and write
+// the result to out, which must hold 2 * n vertices (n + 1 when poly is
+// convex). Returns the number of vertices written.
+template <ClipEdge E, class P>
+inline int clipPolygonEdge(const P* poly, int n, CoordOf<P> bound, P* out) {
+    if (n == 0) return 0;
+    int m = 0;
+    P prev = poly[n - 1];
+    bool prevInside = insideEdge<E>(prev, bound);
+    for (int i = 0; i < n; i++) {
+        P curr = poly[i];
+        bool currInside = insideEdge<E>(curr, bound);
+        if (prevInside != currInside)
+            out[m++] = intersectEdge<E>(prev, curr, bound);
+        if (currInside)
+            out[m++] = curr;
+        prev = curr;
+        prevInside = currInside;
+    }
+    return m;
+}
+
+template <ClipEdge E, class P>
+inline std::vector<P> clipEdge(const std::vector<P>& poly, CoordOf<P> bound) {
+    std::vector<P> result(2 * poly.size());
+    result.resize(clipPolygonEdge<E>(poly.data(), (int)poly.size(), bound, result.data()));
+    return result;
+}
+
+// Clip poly against [xMin,xMax] x [yMin,yMax], one pass per edge.
+template <class P>
+inline std::vector<P> sutherlandHodgmanClip(const std::vector<P>& poly,
+    CoordOf<P> xMin, CoordOf<P> xMax, CoordOf<P> yMin, CoordOf<P> yMax) {
+    std::vector<P> output = clipEdge<CLIP_LEFT>(poly, xMin);
+    output = clipEdge<CLIP_RIGHT>(output, xMax);
+    output = clipEdge<CLIP_BOTTOM>(output, yMin);
+    output = clipEdge<CLIP_TOP>(output, yMax);
+    return output;
+}
+
+// Per-edge state of the streaming clipper.
+template <class P>
+struct ShStage {
+    P first, prev;
+    bool prevInside;
+    bool started;
+};
+
+template <class P>
+struct ShPipeline {
+    ShStage<P> stage[4];
+    CoordOf<P> bound[4];    // xMin, xMax, yMin, yMax: indexed by ClipEdge
+    P* out;
+    int capacity;
+    int count;
+
+    template <int S>
+    void edge(P prev, bool prevInside, P curr, bool currInside) {
+        if (prevInside && currInside) {
+            push<S + 1>(curr);
+        }
+        else if (prevInside && !currInside) {
+            push<S + 1>(intersectEdge<(ClipEdge)S>(prev, curr, bound[S]));
+        }
+        else if (!prevInside && currInside) {
+            push<S + 1>(intersectEdge<(ClipEdge)S>(prev, curr, bound[S]));
+            push<S + 1>(curr);
+        }
+    }
+
+    template <int S>
+    void push(P p) {
+        if constexpr (S == 4) {
+            if (count < capacity)
+                out[count] = p;
+            count++;
+        }
+        else {
+            ShStage<P>& st = stage[S];
+            bool in = insideEdge<(ClipEdge)S>(p, bound[S]);
+            if (st.started)
+                edge<S>(st.prev, st.prevInside, p, in);
+            else {
+                st.first = p;
+                st.started = true;
+            }
+            st.prev = p;
+            st.prevInside = in;
+        }
+    }
+
+    // Feed the closing edge (last -> first) of every stage, in order.
+    template <int S>
+    void close() {
+        if constexpr (S < 4) {
+            ShStage<P>& st = stage[S];
+            if (st.started)
+                edge<S>(st.prev, st.prevInside, st.first, insideEdge<(ClipEdge)S>(st.first, bound[S]));
+            close<S + 1>();
+        }
+    }
+};
+
+// Clip poly[0..n) against [xMin,xMax] x [yMin,yMax] and write the result to
+// out[0..capacity). Returns the number of vertices in the clipped polygon;
+// if that exceeds capacity only the first capacity vertices were written and
+// the call should be repeated with a larger buffer. The output is the same
+// polygon sutherlandHodgmanClip produces, possibly starting at another vertex.
+template <class P>
+inline int sutherlandHodgmanClipStream(const P* poly, int n,
+    CoordOf<P> xMin, CoordOf<P> xMax, CoordOf<P> yMin, CoordOf<P> yMax,
+    P* out, int capacity) {
+    ShPipeline<P> pipe;
+    for (int s = 0; s < 4; s++)
+        pipe.stage[s].started = false;
+    pipe.bound[CLIP_LEFT] = xMin; pipe.bound[CLIP_RIGHT] = xMax;
+    pipe.bound[CLIP_BOTTOM] = yMin; pipe.bound[CLIP_TOP] = yMax;
+    pipe.out = out;
+    pipe.capacity = capacity;
+    pipe.count = 0;
+    for (int i = 0; i < n; i++)
+        pipe.template push<0>(poly[i]);
+    pipe.template close<0>();
+    return pipe.count;
+}
+
+// Growable output buffer for clipped polygons. The storage only ever grows,
+// so once it fits the largest result no further heap allocation happens;
+// count is the number of valid vertices.
+template <class P>
+struct BasicPolygonBuffer {
+    std::vector<P> storage;
+    int count = 0;
+
+    const P* begin() const { return storage.data(); }
+    const P* end() const { return storage.data() + count; }
+    const P& operator[](int i) const { return storage[i]; }
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+};
+
+typedef BasicPolygonBuffer<Point> PolygonBuffer;
+
+// Clip into a reusable buffer, growing it when the result does not fit.
+template <class P>
+inline void sutherlandHodgmanClipStream(const P* poly, int n,
+    CoordOf<P> xMin, CoordOf<P> xMax, CoordOf<P> yMin, CoordOf<P> yMax,
+    BasicPolygonBuffer<P>& out) {
+    if ((int)out.storage.size() < n + 4)
+        out.storage.resize(n + 4);
+    out.count = sutherlandHodgmanClipStream(poly, n, xMin, xMax, yMin, yMax,
+        out.storage.data(), (int)out.storage.size());
+    if (out.count > (int)out.storage.size()) {
+        out.storage.resize(out.count);
+        out.count = sutherlandHodgmanClipStream(poly, n, xMin, xMax, yMin, yMax,
+            out.storage.data(), (int)out.storage.size());
+    }
+}
+
+// Polygons stored back to back, e.g. the pieces of a polygon difference.
+// Like PolygonBuffer the storage only grows, so refilling it every frame
+// stops allocating once it has seen the largest result.
+template <class P>
+struct BasicPolygonSet {
+    std::vector<P> vertices;
+    std::vector<int> starts, counts;
+    std::vector<P> scratch[2];
+    int used = 0;
+    int pieces = 0;
+
+    void clear() { used = pieces = 0; }
+    int size() const { return pieces; }
+    bool empty() const { return pieces == 0; }
+    const P* polygon(int i) const { return vertices.data() + starts[i]; }
+    int count(int i) const { return counts[i]; }
+
+    // Keep poly[0..n) as the next polygon, unless it is degenerate.
+    void append(const P* poly, int n) {
+        if (n < 3) return;
+        if ((int)vertices.size() < used + n) vertices.resize(2 * (used + n));
+        if ((int)starts.size() <= pieces) {
+            starts.resize(pieces + 1);
+            counts.resize(pieces + 1);
+        }
+        std::copy(poly, poly + n, vertices.data() + used);
+        starts[pieces] = used;
+        counts[pieces] = n;
+        used += n;
+        pieces++;
+    }
+};
+
+typedef BasicPolygonSet<Point> PolygonSet;
+
+// One clipPolygonEdge pass into dst, growing it to fit; n is updated to
+// the output count.
+template <ClipEdge E, class P>
+inline const P* clipEdgeInto(const P* poly, int& n, CoordOf<P> bound, std::vector<P>& dst) {
+    if ((int)dst.size() < 2 * n) dst.resize(2 * n);
+    n = clipPolygonEdge<E>(poly, n, bound, dst.data());
+    return dst.data();
+}
+
+// Polygon difference poly[0..n) minus [xMin,xMax] x [yMin,yMax], into out
+// (cleared first). The outside of the rectangle is cut into four slabs,
+// x <= xMin, x >= xMax, and the column between them below yMin and above
+// yMax. Each slab is convex, so poly is clipped to each with the
+// Sutherland-Hodgman passes, giving at most four pieces that do not
+// overlap and that fill exactly the part outside. A rectangle wholly
+// inside poly, which would leave a hole, comes out as the frame around
+// it. A convex poly gives convex pieces. When poly's bounding box misses
+// the rectangle, poly comes back whole as the only piece; when the box
+// lies in it, there are none; neither case runs the clipper.
+template <class P>
+inline void clipPolygonOutside(const P* poly, int n,
+    CoordOf<P> xMin, CoordOf<P> xMax, CoordOf<P> yMin, CoordOf<P> yMax, BasicPolygonSet<P>& out) {
+    out.clear();
+    if (n <= 0) return;
+    CoordOf<P> x0 = poly[0].x, x1 = poly[0].x, y0 = poly[0].y, y1 = poly[0].y;
+    for (int i = 1; i < n; i++) {
+        x0 = std::min(x0, poly[i].x);
+        x1 = std::max(x1, poly[i].x);
+        y0 = std::min(y0, poly[i].y);
+        y1 = std::max(y1, poly[i].y);
+    }
+    if (x1 < xMin || x0 > xMax || y1 < yMin || y0 > yMax) {
+        out.append(poly, n);
+        return;
+    }
+    if (x0 >= xMin && x1 <= xMax && y0 >= yMin && y1 <= yMax) return;
+    std::vector<P>& a = out.scratch[0];
+    std::vector<P>& b = out.scratch[1];
+    int m = n;
+    const P* piece = clipEdgeInto<CLIP_RIGHT>(poly, m, xMin, a);     // x <= xMin
+    out.append(piece, m);
+    m = n;
+    piece = clipEdgeInto<CLIP_LEFT>(poly, m, xMax, a);               // x >= xMax
+    out.append(piece, m);
+    m = n;
+    piece = clipEdgeInto<CLIP_LEFT>(poly, m, xMin, a);
+    const P* column = clipEdgeInto<CLIP_RIGHT>(piece, m, xMax, b);  // xMin <= x <= xMax
+    int columnCount = m;
+    piece = clipEdgeInto<CLIP_TOP>(column, m, yMin, a);              // y <= yMin
+    out.append(piece, m);
+    m = columnCount;
+    piece = clipEdgeInto<CLIP_BOTTOM>(column, m, yMax, a);           // y >= yMax
+    out.append(piece, m);
+}
+
+// Convex clip region as the half-planes a * x + b * y + c >= 0 bounding it,
+// one per edge.
+struct HalfPlane {
+    float a, b, c;
+
+    float eval(Point p) const { return a * p.x + b * p.y + c; }
+};
+
+struct ConvexRegion {
+    std::vector<HalfPlane> planes;
+};
+
+// Region inside the convex polygon poly[0..n), in either winding.
+inline ConvexRegion makeConvexRegion(const Point* poly, int n) {
+    float area = 0;
+    for (int i = 0; i < n; i++) {
+        Point a = poly[i], b = poly[(i + 1) % n];
+        area += a.x * b.y - b.x * a.y;
+    }
+    float side = area < 0 ? -1.0f : 1.0f;
+    ConvexRegion region;
+    for (int i = 0; i < n; i++) {
+        Point a = poly[i], b = poly[(i + 1) % n];
+        // Left of a -> b for a counter-clockwise polygon
+        float na = side * (a.y - b.y), nb = side * (b.x - a.x);
+        region.planes.push_back({ na, nb, -(na * a.x + nb * a.y) });
+    }
+    return region;
+}
+
+inline ConvexRegion makeRectRegion(float xMin, float xMax, float yMin, float yMax) {
+    ConvexRegion region;
+    region.planes = { { 1, 0, -xMin }, { -1, 0, xMax }, { 0, 1, -yMin }, { 0, -1, yMax } };
+    return region;
+}
+
+// Clip poly[0..n) against the region, one Sutherland–Hodgman pass per
+// half-plane. out and scratch must each hold n + planes.size() vertices.
+// Returns the vertex count of the clipped polygon, which is left in out.
+inline int clipPolygonConvex(const Point* poly, int n, const ConvexRegion& region,
+    Point* out, Point* scratch) {
+    int planes = (int)region.planes.size();
+    // Alternate buffers so that the last pass writes to out.
+    Point* dst = planes % 2 ? out : scratch;
+    Point* other = planes % 2 ? scratch : out;
+    const Point* src = poly;
+    if (planes == 0) {
+        std::copy(poly, poly + n, out);
+        return n;
+    }
+    for (int k = 0; k < planes && n > 0; k++) {
+        const HalfPlane& h = region.planes[k];
+        int m = 0;
+        Point prev = src[n - 1];
+        float fPrev = h.eval(prev);
+        for (int i = 0; i < n; i++) {
+            Point curr = src[i];
+            float fCurr = h.eval(curr);
+            if ((fPrev >= 0) != (fCurr >= 0)) {
+                float t = fPrev / (fPrev - fCurr);
+                dst[m++] = { prev.x + t * (curr.x - prev.x), prev.y + t * (curr.y - prev.y) };
+            }
+            if (fCurr >= 0)
+                dst[m++] = curr;
+            prev = curr;
+            fPrev = fCurr;
+        }
+        n = m;
+        src = dst;
+        std::swap(dst, other);
+    }
+    if (src != out)
+        std::copy(src, src + n, out);
+    return n;
+}
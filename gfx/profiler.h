@@ -0,0 +1,313 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Frame profiler: scoped timers around draw functions and clip calls.
+// Each named stage accumulates its (inclusive) CPU time over a frame;
+// ending the frame pushes one sample per stage into a ring buffer of the
+// last `capacity` frames, from which report() gives p50/p99 per stage and
+// writeDump() writes every sample as CSV or JSON.
+//
+//   void drawFan() {
+//       GFX_PROFILE_FUNCTION();
+//       ...
+//   }
+//
+// Timers cost one branch while the profiler is disabled. Scenes recorded
+// with it enabled remember the stage of every node, so replaying them
+// still charges the time to the draw function that recorded it. Backends
+// that defer work (the tiled rasterizer, GL) do it in their flush, so
+// time that stage too.
+// ---------------------------------------------------------------------
+#include "render.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+struct StageSummary {
+    const char* name;
+    int depth;              // nesting below "frame" when first entered
+    double p50, p99, mean, max;     // milliseconds per frame
+    long calls;                     // scopes entered, over all frames
+};
+
+class Profiler {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    bool enabled = false;
+    bool overlay = false;       // drawProfileOverlay draws only when set
+
+    explicit Profiler(int capacity = 256) : capacity(capacity) {
+        stages[stage("frame")].depth = 0;
+    }
+
+    // Id of the named stage, registering it on first use. The name must
+    // stay valid (a literal or __func__).
+    int stage(const char* name) {
+        for (int i = 0; i < (int)stages.size(); i++)
+            if (strcmp(stages[i].name, name) == 0) return i;
+        Stage s;
+        s.name = name;
+        s.parent = open.empty() ? -1 : open.back();
+        s.depth = s.parent < 0 ? 1 : stages[s.parent].depth + 1;
+        s.ring.assign(capacity, 0.0f);
+        stages.push_back(s);
+        return (int)stages.size() - 1;
+    }
+
+    // Innermost open stage, or -1.
+    int current() const { return open.empty() ? -1 : open.back(); }
+
+    void push(int id) { open.push_back(id); }
+    void pop(int id, double seconds) {
+        if (!open.empty() && open.back() == id) open.pop_back();
+        stages[id].pending += seconds;
+        stages[id].calls++;
+    }
+    // Charge time to a stage and every stage it was nested in.
+    void addInclusive(int id, double seconds) {
+        for (; id > 0; id = stages[id].parent)
+            stages[id].pending += seconds;
+    }
+
+    void beginFrame() {
+        for (Stage& s : stages) s.pending = 0;
+        frameStart = Clock::now();
+    }
+    void endFrame() {
+        stages[0].pending = std::chrono::duration<double>(Clock::now() - frameStart).count();
+        int slot = frames % capacity;
+        for (Stage& s : stages)
+            s.ring[slot] = (float)(s.pending * 1000.0);
+        frames++;
+    }
+
+    int frameCount() const { return frames; }
+    int sampleCount() const { return std::min(frames, capacity); }
+
+    std::vector<StageSummary> summarize() const {
+        std::vector<StageSummary> result;
+        int n = sampleCount();
+        std::vector<float> sorted;
+        for (const Stage& s : stages) {
+            StageSummary sum = { s.name, s.depth, 0, 0, 0, 0, s.calls };
+            if (n > 0) {
+                sorted.assign(s.ring.begin(), s.ring.begin() + n);
+                std::sort(sorted.begin(), sorted.end());
+                double total = 0;
+                for (float v : sorted) total += v;
+                sum.p50 = percentile(sorted, 0.50);
+                sum.p99 = percentile(sorted, 0.99);
+                sum.mean = total / n;
+                sum.max = sorted.back();
+            }
+            result.push_back(sum);
+        }
+        return result;
+    }
+
+    void report(FILE* out) const {
+        fprintf(out, "%-32s %9s %9s %9s %9s %11s   (ms, last %d frames)\n", "stage", "p50", "p99",
+            "mean", "max", "calls/frame", sampleCount());
+        for (const StageSummary& s : summarize()) {
+            std::string label(2 * s.depth, ' ');
+            label += s.name;
+            fprintf(out, "%-32s %9.3f %9.3f %9.3f %9.3f %11.1f\n", label.c_str(), s.p50, s.p99, s.mean,
+                s.max, frames ? (double)s.calls / frames : 0.0);
+        }
+    }
+
+    // One row (CSV) or array entry (JSON) per frame in the ring, oldest
+    // first; a .json path selects JSON.
+    bool writeDump(const char* path) const {
+        FILE* f = fopen(path, "w");
+        if (!f) return false;
+        const char* dot = strrchr(path, '.');
+        if (dot && strcmp(dot, ".json") == 0)
+            writeJson(f);
+        else
+            writeCsv(f);
+        return fclose(f) == 0;
+    }
+
+private:
+    struct Stage {
+        const char* name;
+        int parent, depth;
+        double pending = 0;         // seconds in the current frame
+        long calls = 0;
+        std::vector<float> ring;    // milliseconds per frame
+    };
+
+    static double percentile(const std::vector<float>& sorted, double p) {
+        int rank = (int)std::ceil(p * sorted.size());
+        return sorted[std::max(0, rank - 1)];
+    }
+
+    int firstFrame() const { return frames - sampleCount(); }
+
+    void writeCsv(FILE* f) const {
+        fprintf(f, "frame");
+        for (const Stage& s : stages) fprintf(f, ",%s", s.name);
+        fprintf(f, "\n");
+        for (int i = firstFrame(); i < frames; i++) {
+            fprintf(f, "%d", i);
+            for (const Stage& s : stages) fprintf(f, ",%.4f", s.ring[i % capacity]);
+            fprintf(f, "\n");
+        }
+    }
+
+    void writeJson(FILE* f) const {
+        std::vector<StageSummary> sums = summarize();
+        fprintf(f, "{\n  \"frames\": %d,\n  \"firstFrame\": %d,\n  \"stages\": [\n", sampleCount(),
+            firstFrame());
+        for (size_t k = 0; k < stages.size(); k++) {
+            const Stage& s = stages[k];
+            fprintf(f, "    { \"name\": \"%s\", \"parent\": %d, \"p50\": %.4f, \"p99\": %.4f, "
+                "\"mean\": %.4f, \"max\": %.4f, \"calls\": %ld,\n      \"samples\": [", s.name,
+                s.parent, sums[k].p50, sums[k].p99, sums[k].mean, sums[k].max, s.calls);
+            for (int i = firstFrame(); i < frames; i++)
+                fprintf(f, i == firstFrame() ? "%.4f" : ", %.4f", s.ring[i % capacity]);
+            fprintf(f, "] }%s\n", k + 1 < stages.size() ? "," : "");
+        }
+        fprintf(f, "  ]\n}\n");
+    }
+
+    int capacity;
+    int frames = 0;
+    std::vector<Stage> stages;
+    std::vector<int> open;
+    Clock::time_point frameStart;
+};
+
+inline Profiler profiler;
+
+// Clip calls made so far, counted whether or not the profiler is on; the
+// perf log reports them per second. A recorded scene keeps the count its
+// recording made and adds it again each time it is drawn (gfx/scene.h).
+inline long clipCallCount = 0;
+
+// Times the enclosing scope as one stage; with countClip, also counts a
+// clip call.
+class ProfileScope {
+public:
+    explicit ProfileScope(int id, bool countClip = false) : id(id), active(profiler.enabled) {
+        if (countClip) ++clipCallCount;
+        if (active) {
+            profiler.push(id);
+            start = Profiler::Clock::now();
+        }
+    }
+    ~ProfileScope() {
+        if (active)
+            profiler.pop(id, std::chrono::duration<double>(Profiler::Clock::now() - start).count());
+    }
+
+private:
+    int id;
+    bool active;
+    Profiler::Clock::time_point start;
+};
+
+// Brackets one displayed frame.
+class ProfileFrame {
+public:
+    ProfileFrame() : active(profiler.enabled) {
+        if (active) profiler.beginFrame();
+    }
+    ~ProfileFrame() {
+        if (active) profiler.endFrame();
+    }
+
+private:
+    bool active;
+};
+
+// Charges replayed work to the stages recorded with it: enter() each
+// node's stage, and the time since the previous change goes to the
+// previous stage.
+class ProfileReplay {
+public:
+    ~ProfileReplay() { enter(-1); }
+
+    void enter(int id) {
+        if (id == currentId || !profiler.enabled) return;
+        Profiler::Clock::time_point now = Profiler::Clock::now();
+        if (currentId >= 0)
+            profiler.addInclusive(currentId, std::chrono::duration<double>(now - start).count());
+        currentId = id;
+        start = now;
+    }
+
+private:
+    int currentId = -1;
+    Profiler::Clock::time_point start;
+};
+
+#define GFX_PROFILE_CONCAT2(a, b) a##b
+#define GFX_PROFILE_CONCAT(a, b) GFX_PROFILE_CONCAT2(a, b)
+#define GFX_PROFILE(name) \
+    static const int GFX_PROFILE_CONCAT(gfxProfileStage, __LINE__) = profiler.stage(name); \
+    ProfileScope GFX_PROFILE_CONCAT(gfxProfileScope, __LINE__)(GFX_PROFILE_CONCAT(gfxProfileStage, __LINE__))
+#define GFX_PROFILE_FUNCTION() GFX_PROFILE(__func__)
+
+// GFX_PROFILE for a clip call, which the scope also counts. Like
+// GFX_PROFILE it declares the scope, so it cannot stand alone as the body
+// of an unbraced if or loop.
+#define GFX_PROFILE_CLIP(name) \
+    static const int GFX_PROFILE_CONCAT(gfxProfileStage, __LINE__) = profiler.stage(name); \
+    ProfileScope GFX_PROFILE_CONCAT(gfxProfileScope, __LINE__)(GFX_PROFILE_CONCAT(gfxProfileStage, __LINE__), true)
+
+// Stage table in the top-left corner of the window: p50 and p99 over the
+// frames so far, black on white. The lines are laid out into storage that
+// lives as long as the program, since gfxText may keep the layout: a
+// SceneRecorder stores a pointer to it.
+inline void drawProfileOverlay() {
+    if (!profiler.enabled || !profiler.overlay || profiler.sampleCount() == 0) return;
+    std::vector<StageSummary> sums = profiler.summarize();
+    const float lineHeight = 18, top = 495, left = 5, width = 300;
+    float bottom = top - lineHeight * (sums.size() + 1) - 4;
+    gfxColor3f(1.0f, 1.0f, 1.0f);
+    gfxBegin(GL_QUADS);
+    gfxVertex2f(left, bottom);
+    gfxVertex2f(left + width, bottom);
+    gfxVertex2f(left + width, top);
+    gfxVertex2f(left, top);
+    gfxEnd();
+    gfxColor3f(0.0f, 0.0f, 0.0f);
+    // A deque keeps its elements in place as it grows.
+    static std::deque<TextLayout> lines;
+    if (lines.size() < sums.size() + 1) lines.resize(sums.size() + 1);
+    char line[96];
+    float y = top - lineHeight;
+    lines[0] = layoutText("stage  p50 / p99 ms");
+    gfxText(left + 4, y, lines[0]);
+    for (size_t k = 0; k < sums.size(); k++) {
+        const StageSummary& s = sums[k];
+        y -= lineHeight;
+        snprintf(line, sizeof(line), "%*s%s  %.2f / %.2f", 2 * s.depth, "", s.name, s.p50, s.p99);
+        lines[k + 1] = layoutText(line);
+        gfxText(left + 4, y, lines[k + 1]);
+    }
+}
+
+// Print the report to stdout and, given a path, write the dump.
+inline void finishProfile(const char* dumpPath) {
+    if (!profiler.enabled) return;
+    profiler.report(stdout);
+    if (dumpPath && !profiler.writeDump(dumpPath))
+        fprintf(stderr, "could not write %s\n", dumpPath);
+}
+
+// finishProfile when the program exits, for GLUT's main loop, which
+// never returns.
+inline void finishProfileAtExit(const char* dumpPath) {
+    static const char* path;
+    path = dumpPath;
+    atexit([]() { finishProfile(path); });
+}
@@ -0,0 +1,110 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Immediate-mode drawing front end.
+// The scenes draw through gfxBegin/gfxVertex2f/gfxEnd and friends, which
+// mirror the GL calls they replace. Vertices are collected between begin
+// and end and handed to the current RenderBackend as one primitive, so a
+// backend can be OpenGL (GlBackend) or the CPU rasterizer (SoftwareBackend).
+// ---------------------------------------------------------------------
+#include <GL/gl.h>
+#include "clip.h"
+#include "geom.h"
+#include "midpoint.h"
+#include "text.h"
+#include <vector>
+
+class RenderBackend {
+public:
+    virtual ~RenderBackend() {}
+
+    virtual void clearColor(float r, float g, float b, float a) = 0;
+    virtual void clear() = 0;
+    virtual void color(float r, float g, float b) = 0;
+    virtual void lineWidth(float width) = 0;
+    virtual void enableScissor(bool enable) = 0;
+    virtual void scissor(int x, int y, int width, int height) = 0;
+    // mode is a GL primitive type (GL_POLYGON, GL_LINES, GL_LINE_LOOP, ...)
+    virtual void drawPrimitive(GLenum mode, const Point* vertices, int count) = 0;
+    // Ellipse centered on (cx, cy). thickness applies to ELLIPSE_RING; a
+    // null pattern fills solid.
+    virtual void drawEllipse(float cx, float cy, float rx, float ry, EllipseMode mode,
+        float thickness, const FillPattern* pattern) = 0;
+    virtual void rasterPos(float x, float y) = 0;
+    // font is a GLUT bitmap font handle such as GLUT_BITMAP_HELVETICA_18
+    virtual void bitmapCharacter(void* font, int character) = 0;
+    // Laid-out text with its pen at (x, y): the same pixels as rasterPos
+    // followed by bitmapCharacter for each character. Scenes keep a
+    // pointer to the layout, so it must outlive them.
+    virtual void drawText(float x, float y, const TextLayout& layout) = 0;
+    virtual void flush() = 0;
+
+    // Incremental redraw (gfx/dirty.h). pixelBounds is the window
+    // rectangle that anything inside the world box bounds, drawn with
+    // lines lineWidth wide, can touch. setDamage limits all drawing until
+    // the next call to the damage rectangle (null: no limit) and returns
+    // false if the backend cannot, as GL cannot keep the previous frame
+    // across a buffer swap; such a backend always redraws everything.
+    // mayDraw says whether something inside bounds can reach the damage.
+    virtual PixelRect pixelBounds(const ClipWindow& bounds, float lineWidth) const {
+        (void)bounds;
+        (void)lineWidth;
+        return { -0x40000000, -0x40000000, 0x40000000, 0x40000000 };
+    }
+    virtual bool setDamage(const PixelRect* damage) { return damage == nullptr; }
+    virtual bool mayDraw(const ClipWindow& bounds, float lineWidth) const {
+        (void)bounds;
+        (void)lineWidth;
+        return true;
+    }
+};
+
+// Current backend and the primitive being assembled.
+struct GfxContext {
+    RenderBackend* backend = nullptr;
+    GLenum mode = GL_POINTS;
+    std::vector<Point> vertices;
+};
+
+inline GfxContext gfx;
+
+inline void gfxUseBackend(RenderBackend* backend) { gfx.backend = backend; }
+
+inline void gfxClearColor(float r, float g, float b, float a) { gfx.backend->clearColor(r, g, b, a); }
+inline void gfxClear(GLbitfield mask) {
+    if (mask & GL_COLOR_BUFFER_BIT)
+        gfx.backend->clear();
+}
+inline void gfxColor3f(float r, float g, float b) { gfx.backend->color(r, g, b); }
+inline void gfxLineWidth(float width) { gfx.backend->lineWidth(width); }
+inline void gfxEnable(GLenum cap) {
+    if (cap == GL_SCISSOR_TEST)
+        gfx.backend->enableScissor(true);
+}
+inline void gfxDisable(GLenum cap) {
+    if (cap == GL_SCISSOR_TEST)
+        gfx.backend->enableScissor(false);
+}
+inline void gfxScissor(int x, int y, int width, int height) { gfx.backend->scissor(x, y, width, height); }
+
+inline void gfxBegin(GLenum mode) {
+    gfx.mode = mode;
+    gfx.vertices.clear();
+}
+inline void gfxVertex2f(float x, float y) { gfx.vertices.push_back({ x, y }); }
+inline void gfxEnd() {
+    gfx.backend->drawPrimitive(gfx.mode, gfx.vertices.data(), (int)gfx.vertices.size());
+}
+// A whole vertex array as one primitive, like glDrawArrays.
+inline void gfxDrawArrays(GLenum mode, const Point* vertices, int count) {
+    gfx.backend->drawPrimitive(mode, vertices, count);
+}
+
+inline void gfxEllipse(float cx, float cy, float rx, float ry, EllipseMode mode,
+    float thickness = 1.0f, const FillPattern* pattern = nullptr) {
+    gfx.backend->drawEllipse(cx, cy, rx, ry, mode, thickness, pattern);
+}
+
+inline void gfxRasterPos2f(float x, float y) { gfx.backend->rasterPos(x, y); }
+inline void gfxBitmapCharacter(void* font, int character) { gfx.backend->bitmapCharacter(font, character); }
+inline void gfxText(float x, float y, const TextLayout& layout) { gfx.backend->drawText(x, y, layout); }
+inline void gfxFlush() { gfx.backend->flush(); }
@@ -0,0 +1,295 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Retained-mode scene: the gfx* calls made by a draw function, captured
+// once into packed vertex arrays and replayed every frame.
+// Each SceneNode stores the state it was drawn with (color, line width,
+// scissor) and one operation. Replaying only issues the state changes
+// that are actually needed, and consecutive primitives of a batchable
+// type (points, lines, triangles, quads) with equal state are merged
+// into a single draw when the scene is recorded.
+// Primitives and ellipses also keep their world bounding box, so replay
+// can skip those the backend says cannot reach the region being redrawn.
+// ---------------------------------------------------------------------
+#include "profiler.h"
+#include "render.h"
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include <vector>
+
+enum SceneOp { SCENE_CLEAR, SCENE_PRIMITIVE, SCENE_ELLIPSE, SCENE_RASTER_POS, SCENE_BITMAP_CHAR,
+    SCENE_TEXT };
+
+struct SceneState {
+    float color[3];
+    float lineWidth;
+    bool scissorEnabled;
+    int scissor[4];
+
+    bool operator==(const SceneState& o) const {
+        return color[0] == o.color[0] && color[1] == o.color[1] && color[2] == o.color[2] &&
+            lineWidth == o.lineWidth && scissorEnabled == o.scissorEnabled &&
+            scissor[0] == o.scissor[0] && scissor[1] == o.scissor[1] &&
+            scissor[2] == o.scissor[2] && scissor[3] == o.scissor[3];
+    }
+    bool operator!=(const SceneState& o) const { return !(*this == o); }
+};
+
+struct SceneNode {
+    SceneOp op;
+    SceneState state;
+    GLenum mode;        // SCENE_PRIMITIVE: GL primitive type
+    int first, count;   // SCENE_PRIMITIVE: range in Scene::vertices
+    Point pos;          // SCENE_RASTER_POS, SCENE_TEXT, center for SCENE_ELLIPSE
+    Point radii;        // SCENE_ELLIPSE
+    EllipseMode ellipseMode;
+    float thickness;
+    const FillPattern* pattern;
+    void* font;         // SCENE_BITMAP_CHAR
+    int character;      // SCENE_BITMAP_CHAR
+    const TextLayout* text;     // SCENE_TEXT, owned by the caller
+    int stage;          // profiler stage it was recorded in, or -1
+    ClipWindow bounds;  // world box of a primitive or ellipse, else infinite
+};
+
+struct Scene {
+    std::vector<Point> vertices;
+    std::vector<SceneNode> nodes;
+    float clear[4] = { 0, 0, 0, 0 };
+    bool hasClearColor = false;
+    // State when recording ended, which drawing after the scene inherits.
+    SceneState endState = { { 1.0f, 1.0f, 1.0f }, 1.0f, false, { 0, 0, 0, 0 } };
+    // Clip calls made while recording, counted again by every drawScene.
+    long clipCalls = 0;
+
+    void reset() {
+        vertices.clear();
+        nodes.clear();
+        hasClearColor = false;
+        clipCalls = 0;
+    }
+};
+
+// Backend that appends everything it is given to a Scene, starting from
+// GL's initial state or from initial.
+class SceneRecorder : public RenderBackend {
+public:
+    explicit SceneRecorder(Scene& scene, const SceneState* initial = nullptr)
+        : scene(scene), state(initial ? *initial : Scene().endState) {}
+
+    const SceneState& currentState() const { return state; }
+
+    void clearColor(float r, float g, float b, float a) override {
+        scene.clear[0] = r; scene.clear[1] = g; scene.clear[2] = b; scene.clear[3] = a;
+        scene.hasClearColor = true;
+    }
+    void clear() override { append(SCENE_CLEAR); }
+    void color(float r, float g, float b) override {
+        state.color[0] = r; state.color[1] = g; state.color[2] = b;
+    }
+    void lineWidth(float width) override { state.lineWidth = width; }
+    void enableScissor(bool enable) override { state.scissorEnabled = enable; }
+    void scissor(int x, int y, int width, int height) override {
+        state.scissor[0] = x; state.scissor[1] = y;
+        state.scissor[2] = width; state.scissor[3] = height;
+    }
+
+    void drawPrimitive(GLenum mode, const Point* vertices, int count) override {
+        if (count <= 0) return;
+        int first = (int)scene.vertices.size();
+        scene.vertices.insert(scene.vertices.end(), vertices, vertices + count);
+        ClipWindow box = { vertices[0].x, vertices[0].x, vertices[0].y, vertices[0].y };
+        for (int i = 1; i < count; i++) {
+            box.xmin = std::min(box.xmin, vertices[i].x);
+            box.xmax = std::max(box.xmax, vertices[i].x);
+            box.ymin = std::min(box.ymin, vertices[i].y);
+            box.ymax = std::max(box.ymax, vertices[i].y);
+        }
+        if (!scene.nodes.empty() && batchable(mode)) {
+            SceneNode& last = scene.nodes.back();
+            if (last.op == SCENE_PRIMITIVE && last.mode == mode && last.state == state &&
+                last.stage == profiler.current() &&
+                last.first + last.count == first && last.count % batchSize(mode) == 0) {
+                last.count += count;
+                last.bounds.xmin = std::min(last.bounds.xmin, box.xmin);
+                last.bounds.xmax = std::max(last.bounds.xmax, box.xmax);
+                last.bounds.ymin = std::min(last.bounds.ymin, box.ymin);
+                last.bounds.ymax = std::max(last.bounds.ymax, box.ymax);
+                return;
+            }
+        }
+        SceneNode& node = append(SCENE_PRIMITIVE);
+        node.mode = mode;
+        node.first = first;
+        node.count = count;
+        node.bounds = box;
+    }
+
+    void drawEllipse(float cx, float cy, float rx, float ry, EllipseMode mode, float thickness,
+        const FillPattern* pattern) override {
+        SceneNode& node = append(SCENE_ELLIPSE);
+        node.pos = { cx, cy };
+        node.radii = { rx, ry };
+        node.ellipseMode = mode;
+        node.thickness = thickness;
+        node.pattern = pattern;
+        node.bounds = { cx - rx, cx + rx, cy - ry, cy + ry };
+    }
+
+    void rasterPos(float x, float y) override { append(SCENE_RASTER_POS).pos = { x, y }; }
+    void bitmapCharacter(void* font, int character) override {
+        SceneNode& node = append(SCENE_BITMAP_CHAR);
+        node.font = font;
+        node.character = character;
+    }
+    void drawText(float x, float y, const TextLayout& layout) override {
+        SceneNode& node = append(SCENE_TEXT);
+        node.pos = { x, y };
+        node.text = &layout;
+    }
+    void flush() override {}
+
+private:
+    // Primitive types whose concatenation draws the same as separate calls.
+    static bool batchable(GLenum mode) {
+        return mode == GL_POINTS || mode == GL_LINES || mode == GL_TRIANGLES || mode == GL_QUADS;
+    }
+    static int batchSize(GLenum mode) {
+        return mode == GL_LINES ? 2 : mode == GL_TRIANGLES ? 3 : mode == GL_QUADS ? 4 : 1;
+    }
+
+    SceneNode& append(SceneOp op) {
+        SceneNode node = {};
+        node.op = op;
+        node.state = state;
+        node.stage = profiler.current();
+        node.bounds = { -FLT_MAX, FLT_MAX, -FLT_MAX, FLT_MAX };
+        scene.nodes.push_back(node);
+        return scene.nodes.back();
+    }
+
+    Scene& scene;
+    SceneState state;
+};
+
+// Capture everything draw() issues through the gfx* calls into scene.
+// initial is the state draw() starts in, when something is drawn before.
+inline void recordScene(Scene& scene, void (*draw)(), const SceneState* initial = nullptr) {
+    scene.reset();
+    SceneRecorder recorder(scene, initial);
+    RenderBackend* previous = gfx.backend;
+    long clipCalls = clipCallCount;
+    gfxUseBackend(&recorder);
+    draw();
+    gfxUseBackend(previous);
+    scene.endState = recorder.currentState();
+    // The clip calls are counted when the scene is drawn.
+    scene.clipCalls = clipCallCount - clipCalls;
+    clipCallCount = clipCalls;
+}
+
+// Issue the parts of state s that differ from current (all of it when
+// current is null) and make s current. The scissor box is sent only
+// while enabled, and only when it differs from scissorSent, the last one
+// sent.
+inline void issueSceneState(RenderBackend* backend, const SceneState& s,
+    const SceneState*& current, const int*& scissorSent) {
+    if (!current || s.color[0] != current->color[0] || s.color[1] != current->color[1] ||
+        s.color[2] != current->color[2])
+        backend->color(s.color[0], s.color[1], s.color[2]);
+    if (!current || s.lineWidth != current->lineWidth)
+        backend->lineWidth(s.lineWidth);
+    if (!current || s.scissorEnabled != current->scissorEnabled)
+        backend->enableScissor(s.scissorEnabled);
+    if (s.scissorEnabled && (!scissorSent || s.scissor[0] != scissorSent[0] ||
+        s.scissor[1] != scissorSent[1] || s.scissor[2] != scissorSent[2] ||
+        s.scissor[3] != scissorSent[3])) {
+        backend->scissor(s.scissor[0], s.scissor[1], s.scissor[2], s.scissor[3]);
+        scissorSent = s.scissor;
+    }
+    current = &s;
+}
+
+// Replay a recorded scene on the current backend, which is left in the
+// scene's end state, as after drawing it immediately.
+inline void drawScene(const Scene& scene) {
+    RenderBackend* backend = gfx.backend;
+    clipCallCount += scene.clipCalls;
+    if (scene.hasClearColor)
+        backend->clearColor(scene.clear[0], scene.clear[1], scene.clear[2], scene.clear[3]);
+    const SceneState* current = nullptr;
+    const int* scissorSent = nullptr;
+    ProfileReplay replay;
+    for (const SceneNode& node : scene.nodes) {
+        const SceneState& s = node.state;
+        if ((node.op == SCENE_PRIMITIVE || node.op == SCENE_ELLIPSE) &&
+            !backend->mayDraw(node.bounds, s.lineWidth))
+            continue;
+        replay.enter(node.stage);
+        issueSceneState(backend, s, current, scissorSent);
+
+        switch (node.op) {
+        case SCENE_CLEAR:
+            backend->clear();
+            break;
+        case SCENE_PRIMITIVE:
+            backend->drawPrimitive(node.mode, scene.vertices.data() + node.first, node.count);
+            break;
+        case SCENE_ELLIPSE:
+            backend->drawEllipse(node.pos.x, node.pos.y, node.radii.x, node.radii.y,
+                node.ellipseMode, node.thickness, node.pattern);
+            break;
+        case SCENE_RASTER_POS:
+            backend->rasterPos(node.pos.x, node.pos.y);
+            break;
+        case SCENE_BITMAP_CHAR:
+            backend->bitmapCharacter(node.font, node.character);
+            break;
+        case SCENE_TEXT:
+            backend->drawText(node.pos.x, node.pos.y, *node.text);
+            break;
+        }
+    }
+
+    // The last node drawn, if any, may not carry the end state: later
+    // calls can change state without drawing, and culled nodes are skipped.
+    issueSceneState(backend, scene.endState, current, scissorSent);
+}
+
+// True when a and b issue the same drawing: the same nodes with the same
+// state and the same vertices.
+inline bool sameDrawing(const Scene& a, const Scene& b) {
+    if (a.nodes.size() != b.nodes.size() || a.vertices.size() != b.vertices.size() ||
+        a.hasClearColor != b.hasClearColor ||
+        (a.hasClearColor && memcmp(a.clear, b.clear, sizeof a.clear) != 0) ||
+        (!a.vertices.empty() && memcmp(a.vertices.data(), b.vertices.data(), a.vertices.size() * sizeof(Point)) != 0))
+        return false;
+    for (size_t i = 0; i < a.nodes.size(); i++) {
+        const SceneNode& m = a.nodes[i];
+        const SceneNode& n = b.nodes[i];
+        if (m.op != n.op || m.state != n.state) return false;
+        switch (m.op) {
+        case SCENE_CLEAR:
+            break;
+        case SCENE_PRIMITIVE:
+            if (m.mode != n.mode || m.first != n.first || m.count != n.count) return false;
+            break;
+        case SCENE_ELLIPSE:
+            if (m.pos.x != n.pos.x || m.pos.y != n.pos.y || m.radii.x != n.radii.x ||
+                m.radii.y != n.radii.y || m.ellipseMode != n.ellipseMode ||
+                m.thickness != n.thickness || m.pattern != n.pattern)
+                return false;
+            break;
+        case SCENE_RASTER_POS:
+            if (m.pos.x != n.pos.x || m.pos.y != n.pos.y) return false;
+            break;
+        case SCENE_BITMAP_CHAR:
+            if (m.font != n.font || m.character != n.character) return false;
+            break;
+        case SCENE_TEXT:
+            if (m.pos.x != n.pos.x || m.pos.y != n.pos.y || m.text != n.text) return false;
+            break;
+        }
+    }
+    return true;
+}
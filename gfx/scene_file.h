@@ -0,0 +1,352 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Binary scene files (.gfxs), read through mmap.
+// A file is a recorded Scene laid out as fixed-size little-endian
+// records: a header, then the node, vertex, clip-rectangle, text and
+// glyph tables at the offsets the header gives. The records are the
+// host's structs, so only little-endian hosts read and write them.
+// MappedScene maps the file read-only and drawSceneFile replays the
+// tables in place, so opening a file costs a few system calls and one
+// pass that checks every record (gfx/validate.h), with no parsing or
+// copying. Only the text table is turned into TextLayouts on open, a few
+// dozen bytes per string.
+//
+// Scissor boxes are interned into the clip table and each node carries
+// the index of its box (its clip-region tag), or -1 with the scissor
+// test off. Fill patterns are stored inline; profiler stages are not
+// stored, so a replayed file is timed as a whole.
+// ---------------------------------------------------------------------
+#include <GL/glut.h>
+#include "scene.h"
+#include "validate.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+const uint32_t SCENE_FILE_VERSION = 1;
+
+struct SceneFileSection {
+    uint64_t offset;        // from the start of the file, 16-byte aligned
+    uint64_t count;         // records
+};
+
+struct SceneFileHeader {
+    char magic[4];          // "GFXS"
+    uint32_t version;
+    uint64_t fileSize;
+    float clear[4];
+    uint32_t hasClearColor;
+    uint32_t reserved;
+    SceneFileSection nodes, vertices, clips, texts, glyphs;
+};
+
+struct SceneFileNode {
+    uint8_t op;             // SceneOp
+    uint8_t ellipseMode;    // SCENE_ELLIPSE: EllipseMode
+    uint8_t hasPattern;     // SCENE_ELLIPSE: pattern holds a fill pattern
+    uint8_t reserved;
+    int32_t clip;           // index in the clip table, -1 with no scissor
+    uint32_t mode;          // SCENE_PRIMITIVE: GL primitive type
+    uint32_t first, count;  // SCENE_PRIMITIVE: range in the vertex table
+    float color[3];
+    float lineWidth;
+    float pos[2];           // SCENE_RASTER_POS, SCENE_TEXT, ellipse center
+    float radii[2];         // SCENE_ELLIPSE
+    float thickness;        // SCENE_ELLIPSE
+    int32_t character;      // SCENE_BITMAP_CHAR: character; SCENE_TEXT: text index
+    uint8_t pattern[8];     // SCENE_ELLIPSE: FillPattern rows
+};
+
+struct SceneFileClip {
+    int32_t x, y, width, height;
+};
+
+// A laid-out string: glyphs [firstGlyph, firstGlyph + glyphCount).
+struct SceneFileText {
+    uint32_t firstGlyph, glyphCount;
+    int32_t advance;
+    uint32_t reserved;
+};
+
+struct SceneFileGlyph {
+    int32_t dx;
+    int32_t character;
+};
+
+static_assert(sizeof(SceneFileHeader) == 120, "scene file header layout");
+static_assert(sizeof(SceneFileNode) == 68, "scene file node layout");
+static_assert(sizeof(Point) == 8, "scene file vertices are packed float pairs");
+static_assert(sizeof(FillPattern) == 8, "scene file patterns are FillPattern rows");
+static_assert(sizeof(SceneFileGlyph) == 8, "scene file glyphs are (dx, character) pairs");
+#if defined(__BYTE_ORDER__)
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "scene files are little-endian");
+#endif
+
+// Write scene to path. Bitmap characters are stored without their font
+// and replayed in Helvetica 18, the only one embedded.
+inline bool writeSceneFile(const Scene& scene, const char* path) {
+    std::vector<SceneFileNode> nodes;
+    std::vector<SceneFileClip> clips;
+    std::vector<SceneFileText> texts;
+    std::vector<SceneFileGlyph> glyphs;
+    nodes.reserve(scene.nodes.size());
+    for (const SceneNode& n : scene.nodes) {
+        SceneFileNode f = {};
+        f.op = (uint8_t)n.op;
+        f.clip = -1;
+        if (n.state.scissorEnabled) {
+            SceneFileClip box = { n.state.scissor[0], n.state.scissor[1], n.state.scissor[2],
+                n.state.scissor[3] };
+            size_t i = 0;
+            while (i < clips.size() && memcmp(&clips[i], &box, sizeof box) != 0)
+                i++;
+            if (i == clips.size()) clips.push_back(box);
+            f.clip = (int32_t)i;
+        }
+        memcpy(f.color, n.state.color, sizeof f.color);
+        f.lineWidth = n.state.lineWidth;
+        switch (n.op) {
+        case SCENE_CLEAR:
+            break;
+        case SCENE_PRIMITIVE:
+            f.mode = n.mode;
+            f.first = (uint32_t)n.first;
+            f.count = (uint32_t)n.count;
+            break;
+        case SCENE_ELLIPSE:
+            f.pos[0] = n.pos.x; f.pos[1] = n.pos.y;
+            f.radii[0] = n.radii.x; f.radii[1] = n.radii.y;
+            f.ellipseMode = (uint8_t)n.ellipseMode;
+            f.thickness = n.thickness;
+            if (n.pattern) {
+                f.hasPattern = 1;
+                memcpy(f.pattern, n.pattern->rows, sizeof f.pattern);
+            }
+            break;
+        case SCENE_RASTER_POS:
+            f.pos[0] = n.pos.x; f.pos[1] = n.pos.y;
+            break;
+        case SCENE_BITMAP_CHAR:
+            f.character = n.character;
+            break;
+        case SCENE_TEXT: {
+            f.pos[0] = n.pos.x; f.pos[1] = n.pos.y;
+            f.character = (int32_t)texts.size();
+            const TextLayout& layout = *n.text;
+            SceneFileText text = { (uint32_t)glyphs.size(), (uint32_t)layout.glyphs.size(),
+                layout.advance, 0 };
+            texts.push_back(text);
+            for (const PlacedGlyph& g : layout.glyphs)
+                glyphs.push_back({ g.dx, (int32_t)(g.glyph - layout.atlas->glyphs.data()) +
+                    layout.atlas->first });
+            break;
+        }
+        }
+        nodes.push_back(f);
+    }
+
+    SceneFileHeader header = {};
+    memcpy(header.magic, "GFXS", 4);
+    header.version = SCENE_FILE_VERSION;
+    memcpy(header.clear, scene.clear, sizeof header.clear);
+    header.hasClearColor = scene.hasClearColor;
+    uint64_t at = sizeof(SceneFileHeader);
+    auto place = [&at](SceneFileSection& s, size_t count, size_t recordSize) {
+        at = (at + 15) & ~(uint64_t)15;
+        s.offset = at;
+        s.count = count;
+        at += count * recordSize;
+    };
+    place(header.nodes, nodes.size(), sizeof(SceneFileNode));
+    place(header.vertices, scene.vertices.size(), sizeof(Point));
+    place(header.clips, clips.size(), sizeof(SceneFileClip));
+    place(header.texts, texts.size(), sizeof(SceneFileText));
+    place(header.glyphs, glyphs.size(), sizeof(SceneFileGlyph));
+    header.fileSize = at;
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = true;
+    uint64_t written = 0;
+    auto put = [&](uint64_t offset, const void* data, size_t bytes) {
+        static const char zeros[16] = {};
+        if (offset > written) ok = ok && fwrite(zeros, 1, offset - written, f) == offset - written;
+        ok = ok && (bytes == 0 || fwrite(data, 1, bytes, f) == bytes);
+        written = offset + bytes;
+    };
+    put(0, &header, sizeof header);
+    put(header.nodes.offset, nodes.data(), nodes.size() * sizeof(SceneFileNode));
+    put(header.vertices.offset, scene.vertices.data(), scene.vertices.size() * sizeof(Point));
+    put(header.clips.offset, clips.data(), clips.size() * sizeof(SceneFileClip));
+    put(header.texts.offset, texts.data(), texts.size() * sizeof(SceneFileText));
+    put(header.glyphs.offset, glyphs.data(), glyphs.size() * sizeof(SceneFileGlyph));
+    return fclose(f) == 0 && ok;
+}
+
+// A scene file mapped into memory. The tables point into the mapping and
+// stay valid until close() or destruction.
+class MappedScene {
+public:
+    MappedScene() {}
+    MappedScene(const MappedScene&) = delete;
+    MappedScene& operator=(const MappedScene&) = delete;
+    ~MappedScene() { close(); }
+
+    // Map path and check that its tables lie inside the file and index
+    // each other in range, and that every node is a call the backends
+    // accept (validate.h). On failure, error() says why.
+    bool open(const char* path) {
+        close();
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return fail("cannot open the file");
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(SceneFileHeader)) {
+            ::close(fd);
+            return fail("too short for a scene file");
+        }
+        size = (size_t)st.st_size;
+        data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            data = nullptr;
+            return fail("mmap failed");
+        }
+        const SceneFileHeader& h = header();
+        if (memcmp(h.magic, "GFXS", 4) != 0) return fail("not a scene file");
+        if (h.version != SCENE_FILE_VERSION) return fail("unsupported version");
+        if (h.fileSize != size) return fail("truncated");
+        if (!fits(h.nodes, sizeof(SceneFileNode)) || !fits(h.vertices, sizeof(Point)) ||
+            !fits(h.clips, sizeof(SceneFileClip)) || !fits(h.texts, sizeof(SceneFileText)) ||
+            !fits(h.glyphs, sizeof(SceneFileGlyph)))
+            return fail("table outside the file");
+        // One pass over the nodes so that replay needs no checks.
+        for (size_t i = 0; i < nodeCount(); i++) {
+            const SceneFileNode& n = nodes()[i];
+            if (n.op > SCENE_TEXT || (n.clip >= 0 && (uint64_t)n.clip >= h.clips.count) ||
+                (n.op == SCENE_PRIMITIVE && (uint64_t)n.first + n.count > h.vertices.count) ||
+                (n.op == SCENE_TEXT && (n.character < 0 || (uint64_t)n.character >= h.texts.count)))
+                return fail("bad node");
+            const char* why = checkLineWidth(n.lineWidth);
+            if (!why) why = checkColor(n.color[0], n.color[1], n.color[2]);
+            if (!why && n.op == SCENE_PRIMITIVE) why = checkPrimitiveMode(n.mode);
+            if (!why && n.op == SCENE_ELLIPSE)
+                why = checkEllipse(n.pos[0], n.pos[1], n.radii[0], n.radii[1], n.ellipseMode,
+                    n.thickness);
+            if (!why && (n.op == SCENE_RASTER_POS || n.op == SCENE_TEXT))
+                why = checkPosition(n.pos[0], n.pos[1]);
+            if (why) return fail(why);
+        }
+        for (size_t i = 0; i < h.clips.count; i++) {
+            const SceneFileClip& c = clips()[i];
+            if (const char* why = checkScissor(c.x, c.y, c.width, c.height)) return fail(why);
+        }
+        if (const char* why = checkVertices(vertices(), vertexCount())) return fail(why);
+        const SceneFileText* t = at<SceneFileText>(h.texts);
+        const SceneFileGlyph* g = at<SceneFileGlyph>(h.glyphs);
+        layouts.resize(h.texts.count);
+        for (size_t i = 0; i < layouts.size(); i++) {
+            if ((uint64_t)t[i].firstGlyph + t[i].glyphCount > h.glyphs.count) return fail("bad text");
+            if (const char* why = layoutRecordedText(layouts[i], t[i].advance,
+                    &g[t[i].firstGlyph].dx, t[i].glyphCount))
+                return fail(why);
+        }
+        return true;
+    }
+
+    void close() {
+        if (data) munmap(data, size);
+        data = nullptr;
+        size = 0;
+        layouts.clear();
+    }
+
+    bool isOpen() const { return data != nullptr; }
+    const char* error() const { return message; }
+    size_t bytes() const { return size; }
+
+    const SceneFileHeader& header() const { return *(const SceneFileHeader*)data; }
+    const SceneFileNode* nodes() const { return at<SceneFileNode>(header().nodes); }
+    size_t nodeCount() const { return (size_t)header().nodes.count; }
+    const Point* vertices() const { return at<Point>(header().vertices); }
+    size_t vertexCount() const { return (size_t)header().vertices.count; }
+    const SceneFileClip* clips() const { return at<SceneFileClip>(header().clips); }
+    const TextLayout& text(int i) const { return layouts[i]; }
+
+private:
+    template <class T>
+    const T* at(const SceneFileSection& s) const { return (const T*)((const char*)data + s.offset); }
+
+    bool fits(const SceneFileSection& s, size_t recordSize) const {
+        return s.offset % 16 == 0 && s.offset <= size && s.count <= (size - s.offset) / recordSize;
+    }
+
+    bool fail(const char* why) {
+        close();
+        message = why;
+        return false;
+    }
+
+    void* data = nullptr;
+    size_t size = 0;
+    std::vector<TextLayout> layouts;
+    const char* message = "";
+};
+
+// Replay a mapped scene file on the current backend, issuing only the
+// state changes that are needed, like drawScene.
+inline void drawSceneFile(const MappedScene& file) {
+    RenderBackend* backend = gfx.backend;
+    const SceneFileHeader& h = file.header();
+    if (h.hasClearColor)
+        backend->clearColor(h.clear[0], h.clear[1], h.clear[2], h.clear[3]);
+    const Point* vertices = file.vertices();
+    const SceneFileClip* clips = file.clips();
+    const SceneFileNode* current = nullptr;
+    int clipSent = -1;
+    for (const SceneFileNode* n = file.nodes(), *end = n + file.nodeCount(); n != end; n++) {
+        if (!current || n->color[0] != current->color[0] || n->color[1] != current->color[1] ||
+            n->color[2] != current->color[2])
+            backend->color(n->color[0], n->color[1], n->color[2]);
+        if (!current || n->lineWidth != current->lineWidth)
+            backend->lineWidth(n->lineWidth);
+        if (!current || (n->clip >= 0) != (current->clip >= 0))
+            backend->enableScissor(n->clip >= 0);
+        if (n->clip >= 0 && n->clip != clipSent) {
+            const SceneFileClip& c = clips[n->clip];
+            backend->scissor(c.x, c.y, c.width, c.height);
+            clipSent = n->clip;
+        }
+        current = n;
+
+        switch (n->op) {
+        case SCENE_CLEAR:
+            backend->clear();
+            break;
+        case SCENE_PRIMITIVE:
+            backend->drawPrimitive(n->mode, vertices + n->first, (int)n->count);
+            break;
+        case SCENE_ELLIPSE:
+            // Backends may keep the pattern until the frame is flushed; the
+            // mapping outlives the frame.
+            backend->drawEllipse(n->pos[0], n->pos[1], n->radii[0], n->radii[1],
+                (EllipseMode)n->ellipseMode, n->thickness,
+                n->hasPattern ? (const FillPattern*)n->pattern : nullptr);
+            break;
+        case SCENE_RASTER_POS:
+            backend->rasterPos(n->pos[0], n->pos[1]);
+            break;
+        case SCENE_BITMAP_CHAR:
+            // Helvetica 18 is the only font there is.
+            backend->bitmapCharacter(GLUT_BITMAP_HELVETICA_18, n->character);
+            break;
+        case SCENE_TEXT:
+            backend->drawText(n->pos[0], n->pos[1], file.text(n->character));
+            break;
+        }
+    }
+}
@@ -0,0 +1,194 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Minimal float SIMD wrappers used by the batched clip/raster kernels.
+// Each struct exposes the same static operations so a kernel written as
+// a template over it compiles to scalar, SSE (4 lanes) or AVX2 (8 lanes).
+// Masks are "true" lanes; select(m, a, b) yields a where m is set.
+// loadInt/storeInt convert to and from int32 (storeInt truncates).
+// ---------------------------------------------------------------------
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+// One lane, plain floats. Used for tails and as the portable fallback.
+struct SimdScalar {
+    typedef float F;
+    typedef bool M;
+    static const int WIDTH = 1;
+    static F load(const float* p) { return *p; }
+    static void store(float* p, F v) { *p = v; }
+    static F loadInt(const int* p) { return (float)*p; }
+    static void storeInt(int* p, F v) { *p = (int)v; }
+    static F set1(float v) { return v; }
+    static F add(F a, F b) { return a + b; }
+    static F sub(F a, F b) { return a - b; }
+    static F mul(F a, F b) { return a * b; }
+    static F div(F a, F b) { return a / b; }
+    static F min(F a, F b) { return a < b ? a : b; }
+    static F max(F a, F b) { return a > b ? a : b; }
+    static F floor(F a) { return std::floor(a); }
+    static M lt(F a, F b) { return a < b; }
+    static M gt(F a, F b) { return a > b; }
+    static M le(F a, F b) { return a <= b; }
+    static M ge(F a, F b) { return a >= b; }
+    static M maskAnd(M a, M b) { return a && b; }
+    static M maskOr(M a, M b) { return a || b; }
+    static M maskAndNot(M a, M b) { return a && !b; } // a & ~b
+    static M maskXor(M a, M b) { return a != b; }
+    static M maskTrue() { return true; }
+    static M maskFalse() { return false; }
+    static F select(M m, F a, F b) { return m ? a : b; }
+    static M selectMask(M m, M a, M b) { return m ? a : b; }
+    static int bits(M m) { return m ? 1 : 0; }
+    static bool any(M m) { return m; }
+};
+
+#if defined(__SSE2__) || defined(_M_X64)
+// Four lanes, SSE2.
+struct SimdSse {
+    typedef __m128 F;
+    typedef __m128 M;
+    static const int WIDTH = 4;
+    static F load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, F v) { _mm_storeu_ps(p, v); }
+    static F loadInt(const int* p) { return _mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*)p)); }
+    static void storeInt(int* p, F v) { _mm_storeu_si128((__m128i*)p, _mm_cvttps_epi32(v)); }
+    static F set1(float v) { return _mm_set1_ps(v); }
+    static F add(F a, F b) { return _mm_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+    static F div(F a, F b) { return _mm_div_ps(a, b); }
+    static F min(F a, F b) { return _mm_min_ps(a, b); }
+    static F max(F a, F b) { return _mm_max_ps(a, b); }
+    static F floor(F a) {
+        // Truncate, then step down where that rounded up (negative inputs).
+        F t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+        return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.0f)));
+    }
+    static M lt(F a, F b) { return _mm_cmplt_ps(a, b); }
+    static M gt(F a, F b) { return _mm_cmpgt_ps(a, b); }
+    static M le(F a, F b) { return _mm_cmple_ps(a, b); }
+    static M ge(F a, F b) { return _mm_cmpge_ps(a, b); }
+    static M maskAnd(M a, M b) { return _mm_and_ps(a, b); }
+    static M maskOr(M a, M b) { return _mm_or_ps(a, b); }
+    static M maskAndNot(M a, M b) { return _mm_andnot_ps(b, a); }
+    static M maskXor(M a, M b) { return _mm_xor_ps(a, b); }
+    static M maskTrue() { return _mm_castsi128_ps(_mm_set1_epi32(-1)); }
+    static M maskFalse() { return _mm_setzero_ps(); }
+    static F select(M m, F a, F b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static M selectMask(M m, M a, M b) { return select(m, a, b); }
+    static int bits(M m) { return _mm_movemask_ps(m); }
+    static bool any(M m) { return _mm_movemask_ps(m) != 0; }
+};
+#define GFX_HAVE_SSE 1
+#endif
+
+#if defined(__AVX2__)
+// Eight lanes, AVX2 (build with -mavx2 or -march=native).
+struct SimdAvx2 {
+    typedef __m256 F;
+    typedef __m256 M;
+    static const int WIDTH = 8;
+    static F load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, F v) { _mm256_storeu_ps(p, v); }
+    static F loadInt(const int* p) { return _mm256_cvtepi32_ps(_mm256_loadu_si256((const __m256i*)p)); }
+    static void storeInt(int* p, F v) { _mm256_storeu_si256((__m256i*)p, _mm256_cvttps_epi32(v)); }
+    static F set1(float v) { return _mm256_set1_ps(v); }
+    static F add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F div(F a, F b) { return _mm256_div_ps(a, b); }
+    static F min(F a, F b) { return _mm256_min_ps(a, b); }
+    static F max(F a, F b) { return _mm256_max_ps(a, b); }
+    static F floor(F a) { return _mm256_floor_ps(a); }
+    static M lt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static M gt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static M le(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static M ge(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static M maskAnd(M a, M b) { return _mm256_and_ps(a, b); }
+    static M maskOr(M a, M b) { return _mm256_or_ps(a, b); }
+    static M maskAndNot(M a, M b) { return _mm256_andnot_ps(b, a); }
+    static M maskXor(M a, M b) { return _mm256_xor_ps(a, b); }
+    static M maskTrue() { return _mm256_castsi256_ps(_mm256_set1_epi32(-1)); }
+    static M maskFalse() { return _mm256_setzero_ps(); }
+    static F select(M m, F a, F b) { return _mm256_blendv_ps(b, a, m); }
+    static M selectMask(M m, M a, M b) { return _mm256_blendv_ps(b, a, m); }
+    static int bits(M m) { return _mm256_movemask_ps(m); }
+    static bool any(M m) { return _mm256_movemask_ps(m) != 0; }
+};
+#define GFX_HAVE_AVX2 1
+#endif
+
+#if defined(__GNUC__) && defined(GFX_HAVE_SSE)
+// Eight lanes written with GCC vector extensions rather than intrinsics,
+// so they compile for whatever the function they are inlined into
+// targets: two SSE2 halves by default, AVX2 inside a function marked
+// __attribute__((target("avx2"))). A kernel instantiated with it in such
+// a function uses AVX2 in a default build; call it only when
+// cpuHasAvx2(). The vectors are wrapped in structs, and aligned to 16
+// bytes, because GCC warns about passing 32-byte vectors without AVX,
+// though these calls are always inlined.
+#define GFX_LANE8 __attribute__((always_inline)) static
+struct SimdVector8 {
+    typedef float Floats __attribute__((vector_size(32), aligned(16)));
+    typedef int Ints __attribute__((vector_size(32), aligned(16)));
+    struct F { Floats v; };
+    struct M { Ints v; };
+    static const int WIDTH = 8;
+    GFX_LANE8 F load(const float* p) { F r; __builtin_memcpy(&r.v, p, sizeof r.v); return r; }
+    GFX_LANE8 void store(float* p, F a) { __builtin_memcpy(p, &a.v, sizeof a.v); }
+    GFX_LANE8 F loadInt(const int* p) { Ints v; __builtin_memcpy(&v, p, sizeof v); return { __builtin_convertvector(v, Floats) }; }
+    GFX_LANE8 void storeInt(int* p, F a) { Ints v = __builtin_convertvector(a.v, Ints); __builtin_memcpy(p, &v, sizeof v); }
+    // Broadcast as ints: one vpbroadcastd, and the bits of any float (a
+    // color stored as a NaN included) come through unchanged.
+    GFX_LANE8 F set1(float x) { int i; __builtin_memcpy(&i, &x, sizeof i); return { (Floats)(Ints{} + i) }; }
+    GFX_LANE8 F add(F a, F b) { return { a.v + b.v }; }
+    GFX_LANE8 F sub(F a, F b) { return { a.v - b.v }; }
+    GFX_LANE8 F mul(F a, F b) { return { a.v * b.v }; }
+    GFX_LANE8 F div(F a, F b) { return { a.v / b.v }; }
+    GFX_LANE8 F min(F a, F b) { return { a.v < b.v ? a.v : b.v }; }
+    GFX_LANE8 F max(F a, F b) { return { a.v > b.v ? a.v : b.v }; }
+    GFX_LANE8 F floor(F a) {
+        Floats t = __builtin_convertvector(__builtin_convertvector(a.v, Ints), Floats);
+        return { t > a.v ? t - 1.0f : t };
+    }
+    GFX_LANE8 M lt(F a, F b) { return { a.v < b.v }; }
+    GFX_LANE8 M gt(F a, F b) { return { a.v > b.v }; }
+    GFX_LANE8 M le(F a, F b) { return { a.v <= b.v }; }
+    GFX_LANE8 M ge(F a, F b) { return { a.v >= b.v }; }
+    GFX_LANE8 M maskAnd(M a, M b) { return { a.v & b.v }; }
+    GFX_LANE8 M maskOr(M a, M b) { return { a.v | b.v }; }
+    GFX_LANE8 M maskAndNot(M a, M b) { return { a.v & ~b.v }; }
+    GFX_LANE8 M maskXor(M a, M b) { return { a.v ^ b.v }; }
+    GFX_LANE8 M maskTrue() { return { Ints{} - 1 }; }
+    GFX_LANE8 M maskFalse() { return { Ints{} }; }
+    GFX_LANE8 F select(M m, F a, F b) { return { m.v ? a.v : b.v }; }
+    GFX_LANE8 M selectMask(M m, M a, M b) { return { m.v ? a.v : b.v }; }
+    GFX_LANE8 int bits(M m) {
+        Ints b = m.v & Ints{ 1, 2, 4, 8, 16, 32, 64, 128 };
+        b |= __builtin_shuffle(b, Ints{ 4, 5, 6, 7, 0, 1, 2, 3 });
+        b |= __builtin_shuffle(b, Ints{ 2, 3, 0, 1, 6, 7, 4, 5 });
+        b |= __builtin_shuffle(b, Ints{ 1, 0, 3, 2, 5, 4, 7, 6 });
+        return b[0];
+    }
+    GFX_LANE8 bool any(M m) { return bits(m) != 0; }
+};
+#undef GFX_LANE8
+#define GFX_HAVE_VECTOR8 1
+
+// Whether the CPU running the program has AVX2, checked once.
+inline bool cpuHasAvx2() {
+    static const bool has = __builtin_cpu_supports("avx2");
+    return has;
+}
+#endif
+
+// Widest implementation enabled by the compiler flags.
+#if defined(GFX_HAVE_AVX2)
+typedef SimdAvx2 SimdNative;
+#elif defined(GFX_HAVE_SSE)
+typedef SimdSse SimdNative;
+#else
+typedef SimdScalar SimdNative;
+#endif
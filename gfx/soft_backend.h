@@ -0,0 +1,235 @@
+#pragma once
+// ---------------------------------------------------------------------
+// RenderBackend that rasterizes on the CPU into a Framebuffer, for
+// rendering without a GL context or display. Follows the GL state the
+// scenes rely on: current color, line width, scissor box, raster position
+// and a 2D orthographic projection onto the framebuffer.
+// Polygons are filled by the scanline fill or, after setPolygonFill, by
+// the edge-function fill (gfx/edge_raster.h) or the multisampled fill
+// (gfx/multisample.h), either optionally anti-aliased.
+// ---------------------------------------------------------------------
+#include "edge_raster.h"
+#include "font_helvetica18.h"
+#include "framebuffer.h"
+#include "midpoint.h"
+#include "render.h"
+#include "softraster.h"
+#include "text.h"
+#include <cmath>
+#include <vector>
+
+enum PolygonFill { FILL_SCANLINE, FILL_EDGE, FILL_MULTISAMPLE };
+
+class SoftwareBackend : public RenderBackend {
+public:
+    // Framebuffer of width x height pixels showing the world rectangle
+    // [left,right] x [bottom,top], like gluOrtho2D(left, right, bottom, top).
+    SoftwareBackend(int width, int height,
+        float left = 0, float right = 500, float bottom = 0, float top = 500)
+        : fb(width, height), left(left), bottom(bottom), right(right), top(top),
+        scaleX(width / (right - left)), scaleY(height / (top - bottom)) {
+        scissorRect = damageRect = fb.bounds();
+    }
+
+    // Fill polygons with fill and samples (1, 4 or 8) per pixel; samples
+    // other than 1 need FILL_EDGE or FILL_MULTISAMPLE. Set it before
+    // drawing a frame.
+    void setPolygonFill(PolygonFill fill, int samples = 1) {
+        polygonFill = fill;
+        fillSamples = fill != FILL_SCANLINE ? samplePattern(samples).count : 1;
+    }
+
+    // Call flush() first when drawing may still be pending.
+    Framebuffer& framebuffer() { return fb; }
+    bool writeImage(const char* path) {
+        flush();
+        return ::writeImage(fb, path);
+    }
+
+    void clearColor(float r, float g, float b, float) override { clearValue = packColor(r, g, b); }
+    void clear() override { emitClear(clearValue, clipRect()); }
+    void color(float r, float g, float b) override { currentColor = packColor(r, g, b); }
+    void lineWidth(float width) override { lineWidthPx = std::max(1, (int)std::lround(width)); }
+    void enableScissor(bool enable) override { scissorEnabled = enable; }
+    void scissor(int x, int y, int width, int height) override {
+        scissorRect = { x, y, x + width, y + height };
+    }
+
+    void drawPrimitive(GLenum mode, const Point* vertices, int count) override {
+        window.resize(count);
+        for (int i = 0; i < count; i++)
+            window[i] = toWindow(vertices[i]);
+        emitPrimitive(mode, window.data(), count, currentColor, lineWidthPx, clipRect());
+    }
+
+    void drawEllipse(float cx, float cy, float rx, float ry, EllipseMode mode, float thickness,
+        const FillPattern* pattern) override {
+        Point c = toWindow({ cx, cy });
+        int ring = std::max(1, (int)std::lround(thickness * std::min(scaleX, scaleY)));
+        emitEllipse((int)std::floor(c.x), (int)std::floor(c.y), (int)std::lround(rx * scaleX),
+            (int)std::lround(ry * scaleY), mode, ring, currentColor, pattern, clipRect());
+    }
+
+    void rasterPos(float x, float y) override {
+        // Like GL, a raster position outside the view volume is invalid and
+        // bitmaps drawn there are discarded.
+        rasterValid = x >= left && x <= right && y >= bottom && y <= top;
+        raster = toWindow({ x, y });
+        rasterColor = currentColor;
+    }
+
+    void bitmapCharacter(void*, int character) override {
+        // Only the Helvetica 18 glyphs are embedded; other fonts use them too.
+        if (!rasterValid || character < HELVETICA18_FIRST || character > HELVETICA18_LAST)
+            return;
+        const unsigned char* glyph = HELVETICA18_DATA + HELVETICA18_OFFSETS[character - HELVETICA18_FIRST];
+        int width = glyph[0];
+        int x = (int)std::floor(raster.x - HELVETICA18_XORIG);
+        int y = (int)std::floor(raster.y - HELVETICA18_YORIG);
+        emitBitmap(x, y, width, HELVETICA18_HEIGHT, glyph + 1, rasterColor, clipRect());
+        raster.x += width;
+    }
+
+    void drawText(float x, float y, const TextLayout& layout) override {
+        rasterPos(x, y);
+        if (!rasterValid || !layout.atlas) return;
+        const GlyphAtlas& atlas = *layout.atlas;
+        int penX = (int)std::floor(raster.x - atlas.xorig);
+        int penY = (int)std::floor(raster.y - atlas.yorig);
+        raster.x += layout.advance;
+        // Whole strings, then whole glyphs, are culled by their ink boxes.
+        PixelRect clip = clipRect();
+        PixelRect ink = { penX + layout.ink.x0, penY + layout.ink.y0,
+            penX + layout.ink.x1, penY + layout.ink.y1 };
+        if (intersectRect(ink, clip).empty()) return;
+        for (const PlacedGlyph& p : layout.glyphs) {
+            if (!intersectRect(glyphBounds(*p.glyph, penX + p.dx, penY), clip).empty())
+                emitGlyph(penX + p.dx, penY, *p.glyph, atlas.runs.data(), rasterColor, clip);
+        }
+    }
+
+    void flush() override {}
+
+protected:
+    // Pixel output, already in window coordinates with the final clip
+    // rectangle. Drawn immediately here; subclasses may defer it.
+    virtual void emitClear(uint32_t color, const PixelRect& clip) { fb.fill(color, clip); }
+    virtual void emitPrimitive(GLenum mode, const Point* v, int n, uint32_t color, int width,
+        const PixelRect& clip) {
+        rasterize(mode, v, n, color, width, clip);
+    }
+    virtual void emitBitmap(int x, int y, int w, int h, const unsigned char* bits, uint32_t color,
+        const PixelRect& clip) {
+        drawBitmap(fb, x, y, w, h, bits, color, clip);
+    }
+    virtual void emitGlyph(int x, int y, const Glyph& glyph, const GlyphRun* runs, uint32_t color,
+        const PixelRect& clip) {
+        drawGlyph(fb, x, y, glyph, runs, color, clip);
+    }
+    virtual void emitEllipse(int cx, int cy, int rx, int ry, EllipseMode mode, int thickness,
+        uint32_t color, const FillPattern* pattern, const PixelRect& clip) {
+        drawMidpointEllipse(fb, cx, cy, rx, ry, mode, thickness, color, pattern, clip);
+    }
+
+    Point toWindow(Point p) const { return { (p.x - left) * scaleX, (p.y - bottom) * scaleY }; }
+
+    PixelRect clipRect() const {
+        return intersectRect(scissorEnabled ? intersectRect(scissorRect, fb.bounds()) : fb.bounds(),
+            damageRect);
+    }
+
+    // Rasterizing never depends on the clip rectangle, so redrawing the
+    // scene inside a damage rectangle sets exactly the pixels a full
+    // redraw would set there. Bounds are padded by half the line width
+    // and two pixels of rounding.
+    PixelRect pixelBounds(const ClipWindow& bounds, float lineWidth) const override {
+        Point a = toWindow({ bounds.xmin, bounds.ymin }), b = toWindow({ bounds.xmax, bounds.ymax });
+        float pad = std::max(1.0f, std::round(lineWidth)) * 0.5f + 2.0f;
+        // Clamped, for the infinite bounds of what cannot be bounded.
+        const float big = 1e9f;
+        return { (int)std::max(std::floor(a.x - pad), -big), (int)std::max(std::floor(a.y - pad), -big),
+            (int)std::min(std::ceil(b.x + pad) + 1, big), (int)std::min(std::ceil(b.y + pad) + 1, big) };
+    }
+    bool setDamage(const PixelRect* damage) override {
+        damageRect = damage ? *damage : fb.bounds();
+        return true;
+    }
+    bool mayDraw(const ClipWindow& bounds, float lineWidth) const override {
+        return !intersectRect(pixelBounds(bounds, lineWidth), intersectRect(damageRect, fb.bounds())).empty();
+    }
+
+    void fill(const Point* v, int n, uint32_t color, const PixelRect& clip) {
+        if (polygonFill == FILL_EDGE)
+            fillPolygonEdges(fb, v, n, color, clip, fillSamples);
+        else if (polygonFill == FILL_MULTISAMPLE)
+            fillPolygonSamples(fb, v, n, color, clip, fillSamples);
+        else
+            fillPolygon(fb, v, n, color, clip);
+    }
+
+    // Break a GL primitive into polygons, lines and points.
+    void rasterize(GLenum mode, const Point* v, int n, uint32_t color, int width,
+        const PixelRect& clip) {
+        switch (mode) {
+        case GL_POINTS:
+            for (int i = 0; i < n; i++)
+                drawPoint(fb, v[i], 1, color, clip);
+            break;
+        case GL_LINES:
+            for (int i = 0; i + 1 < n; i += 2)
+                drawLine(fb, v[i], v[i + 1], width, color, clip);
+            break;
+        case GL_LINE_STRIP:
+        case GL_LINE_LOOP:
+            for (int i = 0; i + 1 < n; i++)
+                drawLine(fb, v[i], v[i + 1], width, color, clip);
+            if (mode == GL_LINE_LOOP && n > 2)
+                drawLine(fb, v[n - 1], v[0], width, color, clip);
+            break;
+        case GL_TRIANGLES:
+            for (int i = 0; i + 2 < n; i += 3)
+                fill(v + i, 3, color, clip);
+            break;
+        case GL_TRIANGLE_STRIP:
+            for (int i = 0; i + 2 < n; i++)
+                fill(v + i, 3, color, clip);
+            break;
+        case GL_TRIANGLE_FAN:
+            for (int i = 1; i + 1 < n; i++) {
+                Point tri[3] = { v[0], v[i], v[i + 1] };
+                fill(tri, 3, color, clip);
+            }
+            break;
+        case GL_QUADS:
+            for (int i = 0; i + 3 < n; i += 4)
+                fill(v + i, 4, color, clip);
+            break;
+        case GL_QUAD_STRIP:
+            for (int i = 0; i + 3 < n; i += 2) {
+                Point quad[4] = { v[i], v[i + 1], v[i + 3], v[i + 2] };
+                fill(quad, 4, color, clip);
+            }
+            break;
+        case GL_POLYGON:
+            fill(v, n, color, clip);
+            break;
+        }
+    }
+
+    Framebuffer fb;
+    float left, bottom, right, top;
+    float scaleX, scaleY;
+    std::vector<Point> window;
+
+    uint32_t clearValue = packRGB(0, 0, 0);
+    uint32_t currentColor = packRGB(255, 255, 255);
+    int lineWidthPx = 1;
+    PolygonFill polygonFill = FILL_SCANLINE;
+    int fillSamples = 1;
+    bool scissorEnabled = false;
+    PixelRect scissorRect;
+    PixelRect damageRect;
+    Point raster = { 0, 0 };
+    uint32_t rasterColor = packRGB(255, 255, 255);
+    bool rasterValid = false;
+};
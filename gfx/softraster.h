@@ -0,0 +1,165 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Scalar rasterization routines for the CPU framebuffer.
+// Coordinates are window pixels (origin lower-left). Every routine takes
+// a clip rectangle and decides coverage per pixel from the primitive's own
+// geometry, so drawing through several smaller clip rectangles produces
+// exactly the same pixels as one full-screen pass.
+// fillPolygon also takes 16.16 fixed-point vertices, for which every
+// edge crossing is integer arithmetic: the pixels depend only on the
+// input, not on the compiler or its floating-point flags.
+// ---------------------------------------------------------------------
+#include "fixed.h"
+#include "framebuffer.h"
+#include "geom.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Fill a polygon with the even-odd rule, sampling at pixel centers.
+// A pixel is covered when its center lies inside, with half-open edges
+// (left/bottom inclusive) so that adjacent polygons never overlap.
+inline void fillPolygon(Framebuffer& fb, const Point* pts, int n, uint32_t color,
+    const PixelRect& clip) {
+    if (n < 3) return;
+    float ymin = pts[0].y, ymax = pts[0].y;
+    for (int i = 1; i < n; i++) {
+        ymin = std::min(ymin, pts[i].y);
+        ymax = std::max(ymax, pts[i].y);
+    }
+    // Rows whose centers y + 0.5 fall in [ymin, ymax)
+    int yStart = std::max(clip.y0, (int)std::ceil(ymin - 0.5f));
+    int yEnd = std::min(clip.y1, (int)std::ceil(ymax - 0.5f));
+
+    thread_local std::vector<float> xs;
+    for (int y = yStart; y < yEnd; y++) {
+        float yc = y + 0.5f;
+        xs.clear();
+        Point a = pts[n - 1];
+        for (int i = 0; i < n; i++) {
+            Point b = pts[i];
+            if ((a.y <= yc) != (b.y <= yc))
+                xs.push_back(a.x + (yc - a.y) * (b.x - a.x) / (b.y - a.y));
+            a = b;
+        }
+        if (xs.size() == 2) {
+            if (xs[0] > xs[1]) std::swap(xs[0], xs[1]);
+        }
+        else {
+            std::sort(xs.begin(), xs.end());
+        }
+        uint32_t* row = fb.row(y);
+        for (size_t k = 0; k + 1 < xs.size(); k += 2) {
+            int x0 = std::max(clip.x0, (int)std::ceil(xs[k] - 0.5f));
+            int x1 = std::min(clip.x1, (int)std::ceil(xs[k + 1] - 0.5f));
+            for (int x = x0; x < x1; x++)
+                row[x] = color;
+        }
+    }
+}
+
+// The same fill for 16.16 vertices. Row and span bounds are the ceilings
+// of the float version, computed on the raw values, and each crossing is
+// one rounded mulDiv.
+inline void fillPolygon(Framebuffer& fb, const FixedPoint* pts, int n, uint32_t color,
+    const PixelRect& clip) {
+    if (n < 3) return;
+    Fixed16 ymin = pts[0].y, ymax = pts[0].y;
+    for (int i = 1; i < n; i++) {
+        ymin = std::min(ymin, pts[i].y);
+        ymax = std::max(ymax, pts[i].y);
+    }
+    const Fixed16 half = Fixed16::fromRaw(Fixed16::HALF);
+    int yStart = std::max(clip.y0, (ymin - half).ceil());
+    int yEnd = std::min(clip.y1, (ymax - half).ceil());
+
+    thread_local std::vector<Fixed16> xs;
+    for (int y = yStart; y < yEnd; y++) {
+        Fixed16 yc = Fixed16::fromInt(y) + half;
+        xs.clear();
+        FixedPoint a = pts[n - 1];
+        for (int i = 0; i < n; i++) {
+            FixedPoint b = pts[i];
+            if ((a.y <= yc) != (b.y <= yc))
+                xs.push_back(a.x + mulDiv(yc - a.y, b.x - a.x, b.y - a.y));
+            a = b;
+        }
+        if (xs.size() == 2) {
+            if (xs[0] > xs[1]) std::swap(xs[0], xs[1]);
+        }
+        else {
+            std::sort(xs.begin(), xs.end());
+        }
+        uint32_t* row = fb.row(y);
+        for (size_t k = 0; k + 1 < xs.size(); k += 2) {
+            int x0 = std::max(clip.x0, (xs[k] - half).ceil());
+            int x1 = std::min(clip.x1, (xs[k + 1] - half).ceil());
+            for (int x = x0; x < x1; x++)
+                row[x] = color;
+        }
+    }
+}
+
+// Aliased line of the given pixel width. The major axis is stepped one
+// pixel at a time over the half-open interval [a, b); each step fills a
+// run of 'width' pixels across the minor axis, as GL does for wide lines.
+inline void drawLine(Framebuffer& fb, Point a, Point b, int width, uint32_t color,
+    const PixelRect& clip) {
+    if (width < 1) width = 1;
+    float dx = b.x - a.x, dy = b.y - a.y;
+    float half = (width - 1) * 0.5f;
+    if (std::fabs(dx) >= std::fabs(dy)) {
+        if (dx == 0.0f) return;
+        if (a.x > b.x) std::swap(a, b);
+        float slope = dy / dx;
+        int xStart = std::max(clip.x0, (int)std::ceil(a.x - 0.5f));
+        int xEnd = std::min(clip.x1, (int)std::ceil(b.x - 0.5f));
+        for (int x = xStart; x < xEnd; x++) {
+            float y = a.y + (x + 0.5f - a.x) * slope;
+            int y0 = std::max(clip.y0, (int)std::floor(y - half));
+            int y1 = std::min(clip.y1, (int)std::floor(y - half) + width);
+            for (int yy = y0; yy < y1; yy++)
+                fb.row(yy)[x] = color;
+        }
+    }
+    else {
+        if (a.y > b.y) std::swap(a, b);
+        float slope = dx / dy;
+        int yStart = std::max(clip.y0, (int)std::ceil(a.y - 0.5f));
+        int yEnd = std::min(clip.y1, (int)std::ceil(b.y - 0.5f));
+        for (int y = yStart; y < yEnd; y++) {
+            float x = a.x + (y + 0.5f - a.y) * slope;
+            int x0 = std::max(clip.x0, (int)std::floor(x - half));
+            int x1 = std::min(clip.x1, (int)std::floor(x - half) + width);
+            uint32_t* row = fb.row(y);
+            for (int xx = x0; xx < x1; xx++)
+                row[xx] = color;
+        }
+    }
+}
+
+// Square point of the given size centered on p.
+inline void drawPoint(Framebuffer& fb, Point p, int size, uint32_t color,
+    const PixelRect& clip) {
+    if (size < 1) size = 1;
+    int x = (int)std::floor(p.x - (size - 1) * 0.5f);
+    int y = (int)std::floor(p.y - (size - 1) * 0.5f);
+    fb.fill(color, intersectRect(clip, { x, y, x + size, y + size }));
+}
+
+// Draw a 1-bit bitmap with its lower-left pixel at (x, y). Rows are
+// bottom-up, ((w + 7) / 8) bytes each, most significant bit leftmost.
+inline void drawBitmap(Framebuffer& fb, int x, int y, int w, int h,
+    const unsigned char* bits, uint32_t color, const PixelRect& clip) {
+    int stride = (w + 7) / 8;
+    PixelRect r = intersectRect(clip, { x, y, x + w, y + h });
+    for (int yy = r.y0; yy < r.y1; yy++) {
+        const unsigned char* src = bits + (yy - y) * stride;
+        uint32_t* row = fb.row(yy);
+        for (int xx = r.x0; xx < r.x1; xx++) {
+            int c = xx - x;
+            if (src[c >> 3] & (0x80 >> (c & 7)))
+                row[xx] = color;
+        }
+    }
+}
@@ -0,0 +1,147 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Bounding-box hierarchy for trivial accept/reject before clipping.
+// BoxTree is built once over the bounding boxes of a static set of
+// primitives (segments, polygons, whole objects). A query against a clip
+// window walks it from the root: a node wholly outside the window drops
+// its whole subtree, a node wholly inside accepts its whole subtree
+// without looking at the items, and only the items of leaves that cross
+// the window edge are tested one by one. The clipper then runs on just
+// the items reported as crossing, so its work follows the geometry near
+// the window edge instead of the size of the scene.
+// Boxes are closed, like the clippers' windows: an item touching the
+// window edge from outside is reported as crossing, never dropped.
+// ---------------------------------------------------------------------
+#include "clip.h"
+#include "geom.h"
+#include <algorithm>
+#include <vector>
+
+const int BOX_OUTSIDE = -1, BOX_CROSSING = 0, BOX_INSIDE = 1;
+
+// Where box lies relative to window.
+inline int classifyBox(const ClipWindow& window, const ClipWindow& box) {
+    if (box.xmax < window.xmin || box.xmin > window.xmax || box.ymax < window.ymin ||
+        box.ymin > window.ymax)
+        return BOX_OUTSIDE;
+    if (box.xmin >= window.xmin && box.xmax <= window.xmax && box.ymin >= window.ymin &&
+        box.ymax <= window.ymax)
+        return BOX_INSIDE;
+    return BOX_CROSSING;
+}
+
+// Bounding box of points[0..n), n > 0.
+inline ClipWindow boundsOf(const Point* points, int n) {
+    ClipWindow box = { points[0].x, points[0].x, points[0].y, points[0].y };
+    for (int i = 1; i < n; i++) {
+        box.xmin = std::min(box.xmin, points[i].x);
+        box.xmax = std::max(box.xmax, points[i].x);
+        box.ymin = std::min(box.ymin, points[i].y);
+        box.ymax = std::max(box.ymax, points[i].y);
+    }
+    return box;
+}
+
+inline ClipWindow segmentBounds(Point a, Point b) {
+    return { std::min(a.x, b.x), std::max(a.x, b.x), std::min(a.y, b.y), std::max(a.y, b.y) };
+}
+
+class BoxTree {
+public:
+    // Build over boxes[0..n), splitting each node at the median of its
+    // items' centers along the wider axis until at most leafSize remain.
+    void build(const ClipWindow* boxes, int n, int leafSize = 4) {
+        items.resize(n);
+        itemBoxes.assign(boxes, boxes + n);
+        for (int i = 0; i < n; i++) items[i] = i;
+        nodes.clear();
+        if (n > 0) {
+            nodes.reserve(2 * (n / std::max(1, leafSize)) + 1);
+            split(0, n, std::max(1, leafSize));
+        }
+    }
+
+    int size() const { return (int)items.size(); }
+
+    // Items wholly inside window go to inside, those crossing its edge to
+    // crossing, and the rest are dropped. Both lists are in tree order,
+    // not input order; sort them if drawing order matters.
+    void query(const ClipWindow& window, std::vector<int>& inside, std::vector<int>& crossing) const {
+        inside.clear();
+        crossing.clear();
+        if (nodes.empty()) return;
+        int stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node& node = nodes[stack[--top]];
+            int side = classifyBox(window, node.box);
+            if (side == BOX_OUTSIDE) continue;
+            if (side == BOX_INSIDE) {
+                inside.insert(inside.end(), items.begin() + node.first, items.begin() + node.first + node.count);
+                continue;
+            }
+            if (node.left >= 0) {
+                stack[top++] = node.right;
+                stack[top++] = node.left;
+                continue;
+            }
+            for (int i = node.first; i < node.first + node.count; i++) {
+                side = classifyBox(window, itemBoxes[items[i]]);
+                if (side == BOX_INSIDE) inside.push_back(items[i]);
+                else if (side == BOX_CROSSING) crossing.push_back(items[i]);
+            }
+        }
+    }
+
+private:
+    struct Node {
+        ClipWindow box;
+        int first, count;   // range in items
+        int left, right;    // children, or -1 for a leaf
+    };
+
+    // Median splits keep the depth under log2(n) + 1, well within the
+    // query stack.
+    int split(int first, int count, int leafSize) {
+        int index = (int)nodes.size();
+        nodes.push_back(Node());
+        ClipWindow box = itemBoxes[items[first]], centers = center(box);
+        for (int i = first + 1; i < first + count; i++) {
+            const ClipWindow& b = itemBoxes[items[i]];
+            box.xmin = std::min(box.xmin, b.xmin);
+            box.xmax = std::max(box.xmax, b.xmax);
+            box.ymin = std::min(box.ymin, b.ymin);
+            box.ymax = std::max(box.ymax, b.ymax);
+            ClipWindow c = center(b);
+            centers.xmin = std::min(centers.xmin, c.xmin);
+            centers.xmax = std::max(centers.xmax, c.xmax);
+            centers.ymin = std::min(centers.ymin, c.ymin);
+            centers.ymax = std::max(centers.ymax, c.ymax);
+        }
+        int left = -1, right = -1;
+        if (count > leafSize) {
+            bool alongX = centers.xmax - centers.xmin >= centers.ymax - centers.ymin;
+            int half = count / 2;
+            std::nth_element(items.begin() + first, items.begin() + first + half,
+                items.begin() + first + count, [this, alongX](int a, int b) {
+                    const ClipWindow& p = itemBoxes[a];
+                    const ClipWindow& q = itemBoxes[b];
+                    return alongX ? p.xmin + p.xmax < q.xmin + q.xmax : p.ymin + p.ymax < q.ymin + q.ymax;
+                });
+            left = split(first, half, leafSize);
+            right = split(first + half, count - half, leafSize);
+        }
+        nodes[index] = { box, first, count, left, right };
+        return index;
+    }
+
+    static ClipWindow center(const ClipWindow& b) {
+        float x = (b.xmin + b.xmax) * 0.5f, y = (b.ymin + b.ymax) * 0.5f;
+        return { x, x, y, y };
+    }
+
+    std::vector<int> items;
+    std::vector<ClipWindow> itemBoxes;
+    std::vector<Node> nodes;
+};
@@ -0,0 +1,245 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Bitmap text through a glyph atlas.
+// The atlas decodes every embedded Helvetica 18 glyph once, into the
+// horizontal runs of set pixels on each row plus the glyph's ink box.
+// layoutText places a string's glyphs once; drawing the layout then costs
+// one rectangle test per glyph, so glyphs wholly outside the clip
+// rectangle are skipped, wholly inside ones are filled run by run without
+// clipping, and only glyphs crossing the edge clip their runs.
+// The pixels set are exactly those of drawBitmap on the same glyphs.
+//
+// appendTextGeometry turns a layout into triangles instead, clipped
+// against any convex region, so a page of strings can be drawn as one
+// GL_TRIANGLES primitive with no scissor. Glyph pixels become world units
+// from the pen; with the pen on whole pixels and one world unit per
+// pixel, the fill covers the same pixels as the bitmaps.
+// ---------------------------------------------------------------------
+#include "font_helvetica18.h"
+#include "framebuffer.h"
+#include "polyclip.h"
+#include <algorithm>
+#include <vector>
+
+// Pixels [x0, x1) of glyph row y, relative to the glyph's lower-left.
+struct GlyphRun {
+    short y, x0, x1;
+};
+
+struct Glyph {
+    int advance;                // also the bitmap width
+    int firstRun, runCount;     // range in GlyphAtlas::runs
+    int firstRect, rectCount;   // range in GlyphAtlas::rects
+    PixelRect ink;              // bounds of the runs; empty for blanks
+    const unsigned char* bits;  // the packed bitmap, for glBitmap
+};
+
+struct GlyphAtlas {
+    int first, last;            // character range
+    int height;
+    float xorig, yorig;         // bitmap origin, as glBitmap's xorig/yorig
+    std::vector<Glyph> glyphs;
+    std::vector<GlyphRun> runs;
+    std::vector<PixelRect> rects;   // runs merged down equal columns
+
+    const Glyph* find(int character) const {
+        if (character < first || character > last) return nullptr;
+        return &glyphs[character - first];
+    }
+};
+
+inline GlyphAtlas buildHelvetica18Atlas() {
+    GlyphAtlas atlas;
+    atlas.first = HELVETICA18_FIRST;
+    atlas.last = HELVETICA18_LAST;
+    atlas.height = HELVETICA18_HEIGHT;
+    atlas.xorig = HELVETICA18_XORIG;
+    atlas.yorig = HELVETICA18_YORIG;
+    for (int c = atlas.first; c <= atlas.last; c++) {
+        const unsigned char* data = HELVETICA18_DATA + HELVETICA18_OFFSETS[c - atlas.first];
+        Glyph g;
+        g.advance = data[0];
+        g.bits = data + 1;
+        g.firstRun = (int)atlas.runs.size();
+        g.ink = { g.advance, atlas.height, 0, 0 };
+        int stride = (g.advance + 7) / 8;
+        for (int y = 0; y < atlas.height; y++) {
+            const unsigned char* row = g.bits + y * stride;
+            for (int x = 0; x < g.advance;) {
+                if (!(row[x >> 3] & (0x80 >> (x & 7)))) { x++; continue; }
+                int start = x;
+                while (x < g.advance && (row[x >> 3] & (0x80 >> (x & 7))))
+                    x++;
+                atlas.runs.push_back({ (short)y, (short)start, (short)x });
+                g.ink.x0 = std::min(g.ink.x0, start);
+                g.ink.x1 = std::max(g.ink.x1, x);
+                g.ink.y0 = std::min(g.ink.y0, y);
+                g.ink.y1 = std::max(g.ink.y1, y + 1);
+            }
+        }
+        g.runCount = (int)atlas.runs.size() - g.firstRun;
+        // A run identical to one on the row below extends its rectangle.
+        g.firstRect = (int)atlas.rects.size();
+        for (int i = g.firstRun; i < g.firstRun + g.runCount; i++) {
+            const GlyphRun& run = atlas.runs[i];
+            bool merged = false;
+            for (int k = g.firstRect; k < (int)atlas.rects.size() && !merged; k++) {
+                PixelRect& r = atlas.rects[k];
+                if (r.y1 == run.y && r.x0 == run.x0 && r.x1 == run.x1) {
+                    r.y1++;
+                    merged = true;
+                }
+            }
+            if (!merged)
+                atlas.rects.push_back({ run.x0, run.y, run.x1, run.y + 1 });
+        }
+        g.rectCount = (int)atlas.rects.size() - g.firstRect;
+        atlas.glyphs.push_back(g);
+    }
+    return atlas;
+}
+
+// Built on first use and shared by every layout.
+inline const GlyphAtlas& helvetica18Atlas() {
+    static const GlyphAtlas atlas = buildHelvetica18Atlas();
+    return atlas;
+}
+
+// Ink rectangle of a glyph whose bitmap's lower-left pixel is (x, y).
+inline PixelRect glyphBounds(const Glyph& g, int x, int y) {
+    return { x + g.ink.x0, y + g.ink.y0, x + g.ink.x1, y + g.ink.y1 };
+}
+
+// A glyph's bitmap sits at pen position + (dx, 0), shifted by the atlas
+// origin.
+struct PlacedGlyph {
+    int dx;
+    const Glyph* glyph;
+};
+
+// A string laid out in pixels from its pen position. Characters outside
+// the atlas are dropped, as glutBitmapCharacter ignores them.
+struct TextLayout {
+    const GlyphAtlas* atlas = nullptr;
+    std::vector<PlacedGlyph> glyphs;
+    int advance = 0;            // total pen movement
+    PixelRect ink = { 0, 0, 0, 0 };   // union of the glyphs' ink, relative to the pen
+};
+
+inline TextLayout layoutText(const char* text, const GlyphAtlas& atlas = helvetica18Atlas()) {
+    TextLayout layout;
+    layout.atlas = &atlas;
+    for (const char* p = text; *p; p++) {
+        const Glyph* g = atlas.find((unsigned char)*p);
+        if (!g) continue;
+        if (g->runCount) {
+            PixelRect box = glyphBounds(*g, layout.advance, 0);
+            if (layout.glyphs.empty()) layout.ink = box;
+            layout.ink.x0 = std::min(layout.ink.x0, box.x0);
+            layout.ink.y0 = std::min(layout.ink.y0, box.y0);
+            layout.ink.x1 = std::max(layout.ink.x1, box.x1);
+            layout.ink.y1 = std::max(layout.ink.y1, box.y1);
+            layout.glyphs.push_back({ layout.advance, g });
+        }
+        layout.advance += g->advance;
+    }
+    return layout;
+}
+
+inline bool containsRect(const PixelRect& outer, const PixelRect& r) {
+    return r.x0 >= outer.x0 && r.y0 >= outer.y0 && r.x1 <= outer.x1 && r.y1 <= outer.y1;
+}
+
+// Fill a glyph's runs with its bitmap's lower-left pixel at (x, y).
+inline void drawGlyph(Framebuffer& fb, int x, int y, const Glyph& g, const GlyphRun* runs,
+    uint32_t color, const PixelRect& clip) {
+    PixelRect box = glyphBounds(g, x, y);
+    if (intersectRect(box, clip).empty()) return;
+    const GlyphRun* run = runs + g.firstRun;
+    const GlyphRun* end = run + g.runCount;
+    if (containsRect(clip, box)) {
+        for (; run != end; run++) {
+            uint32_t* row = fb.row(y + run->y) + x;
+            for (int xx = run->x0; xx < run->x1; xx++)
+                row[xx] = color;
+        }
+        return;
+    }
+    for (; run != end; run++) {
+        int yy = y + run->y;
+        if (yy < clip.y0 || yy >= clip.y1) continue;
+        int x0 = std::max(x + run->x0, clip.x0), x1 = std::min(x + run->x1, clip.x1);
+        uint32_t* row = fb.row(yy);
+        for (int xx = x0; xx < x1; xx++)
+            row[xx] = color;
+    }
+}
+
+// Triangles of clipped text, appended to by appendTextGeometry. The
+// buffers only grow, so a mesh rebuilt every frame stops allocating.
+struct TextMesh {
+    std::vector<Point> triangles;
+    std::vector<Point> clipped, scratch;
+
+    void clear() { triangles.clear(); }
+};
+
+// Which corners of [x0,x1] x [y0,y1] are inside the region: 1 when all
+// are, -1 when all lie outside one half-plane, 0 when it must be clipped.
+inline int classifyRegionBox(const ConvexRegion& region, float x0, float y0, float x1, float y1) {
+    int result = 1;
+    for (const HalfPlane& h : region.planes) {
+        int in = (h.eval({ x0, y0 }) >= 0) + (h.eval({ x1, y0 }) >= 0) +
+            (h.eval({ x0, y1 }) >= 0) + (h.eval({ x1, y1 }) >= 0);
+        if (in == 0) return -1;
+        if (in < 4) result = 0;
+    }
+    return result;
+}
+
+inline void appendBoxTriangles(std::vector<Point>& out, float x0, float y0, float x1, float y1) {
+    Point a = { x0, y0 }, b = { x1, y0 }, c = { x1, y1 }, d = { x0, y1 };
+    out.insert(out.end(), { a, b, c, a, c, d });
+}
+
+// Append the layout's glyphs, pen at (x, y), clipped to region, as
+// triangles. Whole glyphs inside or outside the region are settled from
+// their ink boxes; only rectangles of glyphs crossing an edge are clipped.
+inline void appendTextGeometry(TextMesh& mesh, const TextLayout& layout, float x, float y,
+    const ConvexRegion& region) {
+    if (!layout.atlas || layout.glyphs.empty()) return;
+    const GlyphAtlas& atlas = *layout.atlas;
+    float ox = x - atlas.xorig, oy = y - atlas.yorig;
+    if (classifyRegionBox(region, ox + layout.ink.x0, oy + layout.ink.y0,
+        ox + layout.ink.x1, oy + layout.ink.y1) < 0)
+        return;
+    size_t capacity = 4 + region.planes.size();
+    if (mesh.clipped.size() < capacity) {
+        mesh.clipped.resize(capacity);
+        mesh.scratch.resize(capacity);
+    }
+    for (const PlacedGlyph& p : layout.glyphs) {
+        const Glyph& g = *p.glyph;
+        float gx = ox + p.dx;
+        int glyphSide = classifyRegionBox(region, gx + g.ink.x0, oy + g.ink.y0,
+            gx + g.ink.x1, oy + g.ink.y1);
+        if (glyphSide < 0) continue;
+        for (int i = g.firstRect; i < g.firstRect + g.rectCount; i++) {
+            const PixelRect& r = atlas.rects[i];
+            float x0 = gx + r.x0, y0 = oy + r.y0, x1 = gx + r.x1, y1 = oy + r.y1;
+            int side = glyphSide ? 1 : classifyRegionBox(region, x0, y0, x1, y1);
+            if (side > 0) {
+                appendBoxTriangles(mesh.triangles, x0, y0, x1, y1);
+                continue;
+            }
+            if (side < 0) continue;
+            Point box[4] = { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y1 } };
+            int n = clipPolygonConvex(box, 4, region, mesh.clipped.data(), mesh.scratch.data());
+            for (int k = 1; k + 1 < n; k++) {
+                mesh.triangles.push_back(mesh.clipped[0]);
+                mesh.triangles.push_back(mesh.clipped[k]);
+                mesh.triangles.push_back(mesh.clipped[k + 1]);
+            }
+        }
+    }
+}
@@ -0,0 +1,125 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Small work-stealing thread pool for data-parallel loops.
+// parallelFor deals the indices round-robin into one queue per thread;
+// each thread takes work from the back of its own queue and, when that
+// runs dry, steals from the front of the others. The calling thread acts
+// as worker 0, so a pool of size 1 runs everything inline.
+// ---------------------------------------------------------------------
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+    // threads <= 0 uses one thread per hardware core.
+    explicit WorkStealingPool(int threads = 0) {
+        if (threads <= 0)
+            threads = (int)std::thread::hardware_concurrency();
+        if (threads <= 0)
+            threads = 1;
+        for (int i = 0; i < threads; i++)
+            queues.emplace_back(new Queue);
+        for (int i = 1; i < threads; i++)
+            workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : workers)
+            t.join();
+    }
+
+    int size() const { return (int)queues.size(); }
+
+    // Run task(i) for every i in [0, count) and wait for all of them.
+    void parallelFor(int count, const std::function<void(int)>& task) {
+        if (count <= 0) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            job = &task;
+            remaining.store(count);
+            for (int i = 0; i < count; i++) {
+                Queue& q = *queues[i % queues.size()];
+                std::lock_guard<std::mutex> qlock(q.mutex);
+                q.items.push_back(i);
+            }
+            generation++;
+        }
+        wake.notify_all();
+        drain(0);
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this]() { return remaining.load() == 0; });
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<int> items;
+    };
+
+    bool take(int self, int& item) {
+        {
+            Queue& own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.items.empty()) {
+                item = own.items.back();
+                own.items.pop_back();
+                return true;
+            }
+        }
+        int n = (int)queues.size();
+        for (int k = 1; k < n; k++) {
+            Queue& victim = *queues[(self + k) % n];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.items.empty()) {
+                item = victim.items.front();
+                victim.items.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void drain(int self) {
+        int item;
+        while (take(self, item)) {
+            (*job)(item);
+            if (remaining.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.notify_all();
+            }
+        }
+    }
+
+    void workerLoop(int self) {
+        unsigned seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&]() { return stop || generation != seen; });
+                if (stop) return;
+                seen = generation;
+            }
+            drain(self);
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue> > queues;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake, done;
+    const std::function<void(int)>* job = nullptr;
+    std::atomic<int> remaining{ 0 };
+    unsigned generation = 0;
+    bool stop = false;
+};
@@ -0,0 +1,171 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Software backend that defers drawing and rasterizes in screen tiles.
+// Commands are recorded during the frame; flush() bins them by bounding
+// box into tileSize x tileSize tiles and rasterizes the tiles in parallel
+// on a WorkStealingPool. Within a tile commands run in submission order,
+// and the raster routines decide each pixel independently of the clip
+// rectangle, so the image is identical to SoftwareBackend's for any
+// thread count or tile size.
+// ---------------------------------------------------------------------
+#include "soft_backend.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+class TiledSoftwareBackend : public SoftwareBackend {
+public:
+    TiledSoftwareBackend(int width, int height, int threads = 0, int tileSize = 64,
+        float left = 0, float right = 500, float bottom = 0, float top = 500)
+        : SoftwareBackend(width, height, left, right, bottom, top),
+        pool(threads), tileSize(tileSize),
+        tilesX((width + tileSize - 1) / tileSize), tilesY((height + tileSize - 1) / tileSize),
+        bins(tilesX * tilesY) {}
+
+    int threadCount() const { return pool.size(); }
+
+    void flush() override {
+        if (commands.empty()) return;
+        for (std::vector<int>& bin : bins)
+            bin.clear();
+        for (int i = 0; i < (int)commands.size(); i++) {
+            const Command& c = commands[i];
+            int tx0 = c.bounds.x0 / tileSize, tx1 = (c.bounds.x1 - 1) / tileSize;
+            int ty0 = c.bounds.y0 / tileSize, ty1 = (c.bounds.y1 - 1) / tileSize;
+            for (int ty = ty0; ty <= ty1; ty++)
+                for (int tx = tx0; tx <= tx1; tx++)
+                    bins[ty * tilesX + tx].push_back(i);
+        }
+        pool.parallelFor(tilesX * tilesY, [this](int tile) { rasterizeTile(tile); });
+        commands.clear();
+        vertices.clear();
+    }
+
+protected:
+    enum CommandKind { CMD_CLEAR, CMD_PRIMITIVE, CMD_BITMAP, CMD_ELLIPSE, CMD_GLYPH };
+
+    struct Command {
+        CommandKind kind;
+        GLenum mode;
+        int first, count;          // vertex range for CMD_PRIMITIVE
+        uint32_t color;
+        int width;                 // line width for CMD_PRIMITIVE, ring width for CMD_ELLIPSE
+        int x, y, w, h;            // placement for CMD_BITMAP and CMD_GLYPH, center and radii for CMD_ELLIPSE
+        const unsigned char* bits;
+        const Glyph* glyph;        // CMD_GLYPH, with the atlas runs
+        const GlyphRun* runs;
+        EllipseMode ellipseMode;
+        const FillPattern* pattern;
+        PixelRect clip;            // scissor and framebuffer bounds
+        PixelRect bounds;          // clip intersected with the command's extent
+    };
+
+    void record(Command c, const PixelRect& extent) {
+        c.bounds = intersectRect(c.clip, extent);
+        if (!c.bounds.empty())
+            commands.push_back(c);
+    }
+
+    void emitClear(uint32_t color, const PixelRect& clip) override {
+        Command c = {};
+        c.kind = CMD_CLEAR;
+        c.color = color;
+        c.clip = clip;
+        record(c, clip);
+    }
+
+    void emitPrimitive(GLenum mode, const Point* v, int n, uint32_t color, int width,
+        const PixelRect& clip) override {
+        if (n <= 0) return;
+        Command c = {};
+        c.kind = CMD_PRIMITIVE;
+        c.mode = mode;
+        c.first = (int)vertices.size();
+        c.count = n;
+        c.color = color;
+        c.width = width;
+        c.clip = clip;
+        vertices.insert(vertices.end(), v, v + n);
+        // Conservative pixel extent: vertex bounds grown by the line width.
+        float x0 = v[0].x, x1 = v[0].x, y0 = v[0].y, y1 = v[0].y;
+        for (int i = 1; i < n; i++) {
+            x0 = std::min(x0, v[i].x); x1 = std::max(x1, v[i].x);
+            y0 = std::min(y0, v[i].y); y1 = std::max(y1, v[i].y);
+        }
+        float pad = width * 0.5f + 1.0f;
+        PixelRect extent = { (int)std::floor(x0 - pad), (int)std::floor(y0 - pad),
+            (int)std::ceil(x1 + pad) + 1, (int)std::ceil(y1 + pad) + 1 };
+        record(c, extent);
+    }
+
+    void emitBitmap(int x, int y, int w, int h, const unsigned char* bits, uint32_t color,
+        const PixelRect& clip) override {
+        Command c = {};
+        c.kind = CMD_BITMAP;
+        c.x = x; c.y = y; c.w = w; c.h = h;
+        c.bits = bits;
+        c.color = color;
+        c.clip = clip;
+        record(c, { x, y, x + w, y + h });
+    }
+
+    void emitGlyph(int x, int y, const Glyph& glyph, const GlyphRun* runs, uint32_t color,
+        const PixelRect& clip) override {
+        Command c = {};
+        c.kind = CMD_GLYPH;
+        c.x = x; c.y = y;
+        c.glyph = &glyph;
+        c.runs = runs;
+        c.color = color;
+        c.clip = clip;
+        record(c, glyphBounds(glyph, x, y));
+    }
+
+    void emitEllipse(int cx, int cy, int rx, int ry, EllipseMode mode, int thickness,
+        uint32_t color, const FillPattern* pattern, const PixelRect& clip) override {
+        Command c = {};
+        c.kind = CMD_ELLIPSE;
+        c.x = cx; c.y = cy; c.w = rx; c.h = ry;
+        c.ellipseMode = mode;
+        c.width = thickness;
+        c.pattern = pattern;
+        c.color = color;
+        c.clip = clip;
+        record(c, { cx - rx, cy - ry, cx + rx + 1, cy + ry + 1 });
+    }
+
+    void rasterizeTile(int tile) {
+        int tx = tile % tilesX, ty = tile / tilesX;
+        PixelRect rect = { tx * tileSize, ty * tileSize, (tx + 1) * tileSize, (ty + 1) * tileSize };
+        rect = intersectRect(rect, fb.bounds());
+        for (int index : bins[tile]) {
+            const Command& c = commands[index];
+            PixelRect clip = intersectRect(c.bounds, rect);
+            switch (c.kind) {
+            case CMD_CLEAR:
+                fb.fill(c.color, clip);
+                break;
+            case CMD_PRIMITIVE:
+                rasterize(c.mode, vertices.data() + c.first, c.count, c.color, c.width, clip);
+                break;
+            case CMD_BITMAP:
+                drawBitmap(fb, c.x, c.y, c.w, c.h, c.bits, c.color, clip);
+                break;
+            case CMD_ELLIPSE:
+                drawMidpointEllipse(fb, c.x, c.y, c.w, c.h, c.ellipseMode, c.width, c.color,
+                    c.pattern, clip);
+                break;
+            case CMD_GLYPH:
+                drawGlyph(fb, c.x, c.y, *c.glyph, c.runs, c.color, clip);
+                break;
+            }
+        }
+    }
+
+    WorkStealingPool pool;
+    int tileSize, tilesX, tilesY;
+    std::vector<Command> commands;
+    std::vector<Point> vertices;
+    std::vector<std::vector<int> > bins;
+};
@@ -0,0 +1,464 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Draw-call traces (.gfxt): every RenderBackend call a program makes,
+// frame by frame, recorded as it runs so the same work can be replayed
+// later on any backend, away from the program and its GLUT callbacks.
+// A trace is a header and a stream of records. Each record is a 32-bit
+// word holding the opcode in its low byte and a small operand above it,
+// followed by its payload in whole 32-bit words, so vertices stay
+// aligned and a trace can be replayed in place. Frames end with
+// TRACE_FRAME.
+// The header's frame and record counts are written when the trace is
+// closed. A trace cut short by a crash still reads: TraceFile counts the
+// frames by scanning the records, drops a partly written last record and
+// treats a final frame with no TRACE_FRAME as complete.
+//
+// Capture through startTraceCapture (--save-trace), which puts a
+// TraceRecorder in front of the current backend; replay with TraceFile,
+// as the tracereplay program does.
+// ---------------------------------------------------------------------
+#include <GL/glut.h>
+#include "render.h"
+#include "text.h"
+#include "validate.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+const uint32_t TRACE_FILE_VERSION = 1;
+
+enum TraceOp {
+    TRACE_CLEAR_COLOR = 1,  // r, g, b, a
+    TRACE_CLEAR,
+    TRACE_COLOR,            // r, g, b
+    TRACE_LINE_WIDTH,       // width
+    TRACE_ENABLE_SCISSOR,   // operand: enable
+    TRACE_SCISSOR,          // x, y, width, height
+    TRACE_PRIMITIVE,        // operand: GL mode; count, count points
+    TRACE_ELLIPSE,          // operand: mode | has pattern << 8; cx, cy, rx, ry, thickness[, pattern]
+    TRACE_RASTER_POS,       // x, y
+    TRACE_BITMAP_CHAR,      // operand: font id; character
+    TRACE_TEXT,             // x, y, advance, glyph count, (dx, character) per glyph
+    TRACE_FLUSH,
+    TRACE_DAMAGE,           // operand: has rectangle; x0, y0, x1, y1
+    TRACE_FRAME,            // end of a frame
+    TRACE_OP_COUNT
+};
+
+struct TraceFileHeader {
+    char magic[4];          // "GFXT"
+    uint32_t version;
+    uint32_t frames;        // 0 when the trace was not closed
+    uint32_t reserved;
+    uint64_t records;
+};
+
+static_assert(sizeof(TraceFileHeader) == 24, "trace header layout");
+static_assert(sizeof(Point) == 8, "trace vertices are packed float pairs");
+static_assert(sizeof(FillPattern) == 8, "trace patterns are FillPattern rows");
+
+// GLUT bitmap fonts by trace id; any other handle is stored as 0 and
+// replayed in Helvetica 18, as SoftwareBackend draws every font.
+inline void* traceFont(int id) {
+    switch (id) {
+    case 1: return GLUT_BITMAP_8_BY_13;
+    case 2: return GLUT_BITMAP_9_BY_15;
+    case 3: return GLUT_BITMAP_TIMES_ROMAN_10;
+    case 4: return GLUT_BITMAP_TIMES_ROMAN_24;
+    case 5: return GLUT_BITMAP_HELVETICA_10;
+    case 6: return GLUT_BITMAP_HELVETICA_12;
+    default: return GLUT_BITMAP_HELVETICA_18;
+    }
+}
+
+inline int traceFontId(void* font) {
+    for (int id = 1; id <= 6; id++)
+        if (traceFont(id) == font) return id;
+    return 0;
+}
+
+// Backend that appends every call to a trace file and passes it on to
+// target (if any), whose answers to the incremental-redraw queries it
+// also passes back.
+class TraceRecorder : public RenderBackend {
+public:
+    ~TraceRecorder() { close(); }
+
+    bool open(const char* path, RenderBackend* forwardTo) {
+        close();
+        file = fopen(path, "wb");
+        if (!file) return false;
+        target = forwardTo;
+        frames = 0;
+        records = 0;
+        frameEmpty = true;
+        TraceFileHeader header = {};
+        memcpy(header.magic, "GFXT", 4);
+        header.version = TRACE_FILE_VERSION;
+        ok = fwrite(&header, sizeof header, 1, file) == 1;
+        return ok;
+    }
+
+    bool isOpen() const { return file != nullptr; }
+    RenderBackend* forwardTarget() const { return target; }
+
+    // Mark the end of a frame; frames with no calls are not recorded.
+    void endFrame() {
+        if (!file || frameEmpty) return;
+        begin(TRACE_FRAME);
+        end();
+        frames++;
+        frameEmpty = true;
+    }
+
+    // Write the counts into the header; false if anything failed to write.
+    bool close() {
+        if (!file) return ok;
+        endFrame();
+        TraceFileHeader header = {};
+        memcpy(header.magic, "GFXT", 4);
+        header.version = TRACE_FILE_VERSION;
+        header.frames = frames;
+        header.records = records;
+        ok = ok && fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof header, 1, file) == 1;
+        ok = fclose(file) == 0 && ok;
+        file = nullptr;
+        return ok;
+    }
+
+    void clearColor(float r, float g, float b, float a) override {
+        begin(TRACE_CLEAR_COLOR);
+        put(r); put(g); put(b); put(a);
+        end();
+        if (target) target->clearColor(r, g, b, a);
+    }
+    void clear() override {
+        begin(TRACE_CLEAR);
+        end();
+        if (target) target->clear();
+    }
+    void color(float r, float g, float b) override {
+        begin(TRACE_COLOR);
+        put(r); put(g); put(b);
+        end();
+        if (target) target->color(r, g, b);
+    }
+    void lineWidth(float width) override {
+        begin(TRACE_LINE_WIDTH);
+        put(width);
+        end();
+        if (target) target->lineWidth(width);
+    }
+    void enableScissor(bool enable) override {
+        begin(TRACE_ENABLE_SCISSOR, enable);
+        end();
+        if (target) target->enableScissor(enable);
+    }
+    void scissor(int x, int y, int width, int height) override {
+        begin(TRACE_SCISSOR);
+        put(x); put(y); put(width); put(height);
+        end();
+        if (target) target->scissor(x, y, width, height);
+    }
+    void drawPrimitive(GLenum mode, const Point* vertices, int count) override {
+        begin(TRACE_PRIMITIVE, mode);
+        put(count);
+        putBytes(vertices, count * sizeof(Point));
+        end();
+        if (target) target->drawPrimitive(mode, vertices, count);
+    }
+    void drawEllipse(float cx, float cy, float rx, float ry, EllipseMode mode, float thickness,
+        const FillPattern* pattern) override {
+        begin(TRACE_ELLIPSE, (uint32_t)mode | (pattern ? 0x100u : 0u));
+        put(cx); put(cy); put(rx); put(ry); put(thickness);
+        if (pattern) putBytes(pattern->rows, sizeof pattern->rows);
+        end();
+        if (target) target->drawEllipse(cx, cy, rx, ry, mode, thickness, pattern);
+    }
+    void rasterPos(float x, float y) override {
+        begin(TRACE_RASTER_POS);
+        put(x); put(y);
+        end();
+        if (target) target->rasterPos(x, y);
+    }
+    void bitmapCharacter(void* font, int character) override {
+        begin(TRACE_BITMAP_CHAR, traceFontId(font));
+        put(character);
+        end();
+        if (target) target->bitmapCharacter(font, character);
+    }
+    void drawText(float x, float y, const TextLayout& layout) override {
+        begin(TRACE_TEXT);
+        put(x); put(y); put(layout.advance); put((int)layout.glyphs.size());
+        for (const PlacedGlyph& g : layout.glyphs) {
+            put(g.dx);
+            put((int)(g.glyph - layout.atlas->glyphs.data()) + layout.atlas->first);
+        }
+        end();
+        if (target) target->drawText(x, y, layout);
+    }
+    void flush() override {
+        begin(TRACE_FLUSH);
+        end();
+        if (target) target->flush();
+    }
+
+    PixelRect pixelBounds(const ClipWindow& bounds, float lineWidth) const override {
+        return target ? target->pixelBounds(bounds, lineWidth) : RenderBackend::pixelBounds(bounds, lineWidth);
+    }
+    bool setDamage(const PixelRect* damage) override {
+        begin(TRACE_DAMAGE, damage != nullptr);
+        if (damage) {
+            put(damage->x0); put(damage->y0); put(damage->x1); put(damage->y1);
+        }
+        end();
+        return target ? target->setDamage(damage) : RenderBackend::setDamage(damage);
+    }
+    bool mayDraw(const ClipWindow& bounds, float lineWidth) const override {
+        return target ? target->mayDraw(bounds, lineWidth) : true;
+    }
+
+private:
+    void begin(TraceOp op, uint32_t operand = 0) {
+        record.clear();
+        record.push_back((uint32_t)op | operand << 8);
+    }
+    void put(float v) { putBytes(&v, 4); }
+    void put(int v) { putBytes(&v, 4); }
+    void putBytes(const void* data, size_t bytes) {
+        size_t at = record.size();
+        record.resize(at + (bytes + 3) / 4, 0);
+        memcpy(&record[at], data, bytes);
+    }
+    void end() {
+        if (!file) return;
+        ok = ok && fwrite(record.data(), 4, record.size(), file) == record.size();
+        records++;
+        frameEmpty = false;
+    }
+
+    FILE* file = nullptr;
+    RenderBackend* target = nullptr;
+    std::vector<uint32_t> record;
+    uint32_t frames = 0;
+    uint64_t records = 0;
+    bool frameEmpty = true;
+    bool ok = true;
+};
+
+// Words in the record at w, with its payload.
+inline size_t traceRecordWords(const uint32_t* w) {
+    switch ((TraceOp)(w[0] & 0xff)) {
+    case TRACE_CLEAR_COLOR: return 5;
+    case TRACE_COLOR: return 4;
+    case TRACE_LINE_WIDTH: return 2;
+    case TRACE_SCISSOR: return 5;
+    case TRACE_PRIMITIVE: return 2 + 2 * (size_t)w[1];
+    case TRACE_ELLIPSE: return (w[0] & 0x10000) ? 8 : 6;
+    case TRACE_RASTER_POS: return 3;
+    case TRACE_BITMAP_CHAR: return 2;
+    case TRACE_TEXT: return 5 + 2 * (size_t)w[4];
+    case TRACE_DAMAGE: return (w[0] >> 8) ? 5 : 1;
+    default: return 1;
+    }
+}
+
+// What a replayed record was, for timing statistics.
+struct TraceCall {
+    TraceOp op;
+    GLenum mode;            // TRACE_PRIMITIVE
+    int count;              // vertices of TRACE_PRIMITIVE, glyphs of TRACE_TEXT
+};
+
+// Position in a trace: the next record and the text layouts before it.
+struct TraceCursor {
+    size_t word = 0;
+    size_t text = 0;
+};
+
+// A trace read into memory and checked, ready to replay on the current
+// backend frame by frame.
+class TraceFile {
+public:
+    bool open(const char* path) {
+        words.clear();
+        frameStarts.clear();
+        layouts.clear();
+        recordTotal = 0;
+        FILE* f = fopen(path, "rb");
+        if (!f) return fail("cannot open");
+        TraceFileHeader header;
+        bool read = fread(&header, sizeof header, 1, f) == 1;
+        if (read) {
+            long at = ftell(f);
+            fseek(f, 0, SEEK_END);
+            long size = ftell(f);
+            fseek(f, at, SEEK_SET);
+            words.resize(size > at ? (size_t)(size - at) / 4 : 0);
+            read = fread(words.data(), 4, words.size(), f) == words.size();
+        }
+        fclose(f);
+        if (!read) return fail("truncated or unreadable");
+        if (memcmp(header.magic, "GFXT", 4) != 0) return fail("not a trace file");
+        if (header.version != TRACE_FILE_VERSION) return fail("unsupported trace version");
+        return scan();
+    }
+
+    const char* error() const { return message; }
+    int frameCount() const { return (int)frameStarts.size(); }
+    uint64_t recordCount() const { return recordTotal; }
+    size_t bytes() const { return sizeof(TraceFileHeader) + words.size() * 4; }
+
+    TraceCursor frameStart(int frame) const { return frameStarts[frame]; }
+    // Word just past the frame's last record.
+    size_t frameEnd(int frame) const {
+        return frame + 1 < frameCount() ? frameStarts[frame + 1].word : words.size();
+    }
+
+    // Issue the record at cursor on the current backend and step past
+    // it. TRACE_FRAME issues nothing.
+    TraceCall play(TraceCursor& cursor) const {
+        const uint32_t* w = words.data() + cursor.word;
+        TraceCall call = { (TraceOp)(w[0] & 0xff), 0, 0 };
+        uint32_t operand = w[0] >> 8;
+        const float* f = (const float*)(w + 1);
+        const int32_t* i = (const int32_t*)(w + 1);
+        RenderBackend* backend = gfx.backend;
+        switch (call.op) {
+        case TRACE_CLEAR_COLOR: backend->clearColor(f[0], f[1], f[2], f[3]); break;
+        case TRACE_CLEAR: backend->clear(); break;
+        case TRACE_COLOR: backend->color(f[0], f[1], f[2]); break;
+        case TRACE_LINE_WIDTH: backend->lineWidth(f[0]); break;
+        case TRACE_ENABLE_SCISSOR: backend->enableScissor(operand != 0); break;
+        case TRACE_SCISSOR: backend->scissor(i[0], i[1], i[2], i[3]); break;
+        case TRACE_PRIMITIVE:
+            call.mode = operand;
+            call.count = i[0];
+            backend->drawPrimitive(operand, (const Point*)(w + 2), i[0]);
+            break;
+        case TRACE_ELLIPSE:
+            // Backends may keep the pattern until the frame is flushed; the
+            // trace outlives the frame.
+            backend->drawEllipse(f[0], f[1], f[2], f[3], (EllipseMode)(operand & 0xff), f[4],
+                (operand & 0x100) ? (const FillPattern*)(w + 6) : nullptr);
+            break;
+        case TRACE_RASTER_POS: backend->rasterPos(f[0], f[1]); break;
+        case TRACE_BITMAP_CHAR: backend->bitmapCharacter(traceFont(operand), i[0]); break;
+        case TRACE_TEXT:
+            call.count = i[3];
+            backend->drawText(f[0], f[1], layouts[cursor.text++]);
+            break;
+        case TRACE_FLUSH: backend->flush(); break;
+        case TRACE_DAMAGE: {
+            PixelRect r = { i[0], i[1], i[2], i[3] };
+            backend->setDamage(operand ? &r : nullptr);
+            break;
+        }
+        default: break;
+        }
+        cursor.word += traceRecordWords(w);
+        return call;
+    }
+
+private:
+    // Check every record fits and is a call the backends accept
+    // (validate.h), find the frames and lay out the text.
+    bool scan() {
+        TraceCursor cursor;
+        bool frameOpen = false;
+        while (cursor.word < words.size()) {
+            const uint32_t* w = words.data() + cursor.word;
+            uint32_t op = w[0] & 0xff;
+            if (op < TRACE_CLEAR_COLOR || op >= TRACE_OP_COUNT) return fail("bad record");
+            size_t left = words.size() - cursor.word;
+            // The length words of primitives and text come first.
+            if ((op == TRACE_PRIMITIVE && left < 2) || (op == TRACE_TEXT && left < 5))
+                break;
+            if ((op == TRACE_PRIMITIVE && w[1] > (1u << 28)) || (op == TRACE_TEXT && w[4] > (1u << 28)))
+                return fail("bad record");
+            size_t n = traceRecordWords(w);
+            if (n > left) break;
+            const float* f = (const float*)(w + 1);
+            const int32_t* i = (const int32_t*)(w + 1);
+            const char* why = nullptr;
+            switch (op) {
+            case TRACE_CLEAR_COLOR:
+            case TRACE_COLOR: why = checkColor(f[0], f[1], f[2]); break;
+            case TRACE_LINE_WIDTH: why = checkLineWidth(f[0]); break;
+            case TRACE_SCISSOR: why = checkScissor(i[0], i[1], i[2], i[3]); break;
+            case TRACE_PRIMITIVE:
+                why = checkPrimitiveMode(w[0] >> 8);
+                if (!why) why = checkVertices((const Point*)(w + 2), w[1]);
+                break;
+            case TRACE_ELLIPSE:
+                why = checkEllipse(f[0], f[1], f[2], f[3], (w[0] >> 8) & 0xff, f[4]);
+                break;
+            case TRACE_RASTER_POS:
+            case TRACE_TEXT: why = checkPosition(f[0], f[1]); break;
+            case TRACE_DAMAGE:
+                if (w[0] >> 8) why = checkDamage(i[0], i[1], i[2], i[3]);
+                break;
+            }
+            if (why) return fail(why);
+            if (!frameOpen) {
+                frameStarts.push_back(cursor);
+                frameOpen = true;
+            }
+            if (op == TRACE_TEXT) {
+                TextLayout layout;
+                if (const char* bad = layoutRecordedText(layout, (int)w[3], (const int32_t*)(w + 5), w[4]))
+                    return fail(bad);
+                layouts.push_back(layout);
+                cursor.text++;
+            }
+            if (op == TRACE_FRAME) frameOpen = false;
+            cursor.word += n;
+            recordTotal++;
+        }
+        words.resize(cursor.word);
+        return true;
+    }
+
+    bool fail(const char* why) {
+        message = why;
+        return false;
+    }
+
+    std::vector<uint32_t> words;            // the records
+    std::vector<TraceCursor> frameStarts;
+    std::vector<TextLayout> layouts;        // of the TRACE_TEXT records, in order
+    uint64_t recordTotal = 0;
+    const char* message = "";
+};
+
+// The recorder behind --save-trace.
+inline TraceRecorder traceCapture;
+
+// Record everything drawn from now on, through the current backend, to
+// path. The trace is closed by finishTraceCapture or at exit, for GLUT's
+// main loop, which never returns.
+inline bool startTraceCapture(const char* path) {
+    if (!traceCapture.open(path, gfx.backend)) {
+        fprintf(stderr, "could not write %s\n", path);
+        return false;
+    }
+    gfxUseBackend(&traceCapture);
+    static bool registered = false;
+    if (!registered) atexit([]() { traceCapture.close(); });
+    registered = true;
+    return true;
+}
+
+// End of a displayed frame; nothing when no trace is being captured.
+inline void endTraceFrame() {
+    if (traceCapture.isOpen()) traceCapture.endFrame();
+}
+
+// Close the trace and draw straight to its backend again.
+inline bool finishTraceCapture() {
+    if (!traceCapture.isOpen()) return true;
+    if (gfx.backend == &traceCapture) gfxUseBackend(traceCapture.forwardTarget());
+    return traceCapture.close();
+}
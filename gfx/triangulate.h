@@ -0,0 +1,420 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Triangulation of simple polygons, convex or not, in O(n log n).
+// A sweep from top to bottom adds the diagonals that split the polygon
+// into y-monotone pieces (de Berg et al., ch. 3); each piece is then cut
+// into triangles in linear time with a stack. The sweep's edge tree is a
+// std::pmr::multiset on a pool owned by the Triangulator, and every other
+// buffer is a member too, so triangulating every frame stops allocating
+// once the largest polygon has been seen.
+// Input is a simple polygon in either winding; repeated and collinear
+// vertices are dropped first. Output triangles are counterclockwise,
+// as indices into the input or as vertices ready for GL_TRIANGLES.
+// ---------------------------------------------------------------------
+#include "geom.h"
+#include <algorithm>
+#include <cmath>
+#include <memory_resource>
+#include <set>
+#include <utility>
+#include <vector>
+
+// True if poly[0..n) is convex and simple: every turn goes the same way
+// and the edges' x direction reverses at most twice, so it winds once.
+// Repeated and collinear vertices are allowed.
+inline bool isConvexPolygon(const Point* poly, int n) {
+    int turns = 0, reversals = 0;
+    float lastDx = 0;
+    for (int i = 0; i < n; i++) {
+        Point a = poly[i], b = poly[(i + 1) % n], c = poly[(i + 2) % n];
+        double turn = ((double)b.x - a.x) * ((double)c.y - b.y) - ((double)b.y - a.y) * ((double)c.x - b.x);
+        int sign = (turn > 0) - (turn < 0);
+        if (sign != 0) {
+            if (turns != 0 && sign != turns) return false;
+            turns = sign;
+        }
+        float dx = b.x - a.x;
+        if (dx != 0) {
+            if (lastDx != 0 && (dx > 0) != (lastDx > 0)) reversals++;
+            lastDx = dx;
+        }
+    }
+    // The reversal across the seam was not counted yet.
+    for (int i = 0; i < n && lastDx != 0; i++) {
+        float dx = poly[(i + 1) % n].x - poly[i].x;
+        if (dx != 0) {
+            if ((dx > 0) != (lastDx > 0)) reversals++;
+            break;
+        }
+    }
+    return reversals <= 2;
+}
+
+class Triangulator {
+public:
+    Triangulator() : status(EdgeOrder{ this }, &pool) {}
+    Triangulator(const Triangulator&) = delete;
+    Triangulator& operator=(const Triangulator&) = delete;
+
+    // Triangulate poly[0..n). Returns the number of triangles; indices()
+    // then holds three input indices per triangle.
+    int triangulate(const Point* poly, int n) {
+        pts = poly;
+        tris.clear();
+        prepare(n);
+        int m = (int)verts.size();
+        if (m < 3) return 0;
+        if (m == 3) {
+            emit(0, 1, 2);
+            return 1;
+        }
+        sweep();
+        triangulatePieces();
+        return (int)tris.size() / 3;
+    }
+
+    const std::vector<int>& indices() const { return tris; }
+
+    // Triangulate and append the triangles' vertices to out.
+    int appendTriangles(const Point* poly, int n, std::vector<Point>& out) {
+        int count = triangulate(poly, n);
+        for (int i : tris)
+            out.push_back(poly[i]);
+        return count;
+    }
+
+private:
+    // Orders the edges crossing the sweep line from left to right. Edge k
+    // runs from vertex k to vertex k + 1; the sweep is at (sweepX, sweepY).
+    struct EdgeOrder {
+        const Triangulator* t;
+        typedef void is_transparent;
+
+        bool operator()(int a, int b) const { return t->edgeX(a) < t->edgeX(b); }
+        bool operator()(int a, double x) const { return t->edgeX(a) < x; }
+        bool operator()(double x, int b) const { return x < t->edgeX(b); }
+    };
+    typedef std::pmr::multiset<int, EdgeOrder> EdgeTree;
+
+    Point at(int k) const { return pts[verts[k]]; }
+    int prevOf(int k) const { return k == 0 ? (int)verts.size() - 1 : k - 1; }
+    int nextOf(int k) const { return k + 1 == (int)verts.size() ? 0 : k + 1; }
+
+    static double cross(Point a, Point b, Point c) {
+        return ((double)b.x - a.x) * ((double)c.y - b.y) - ((double)b.y - a.y) * ((double)c.x - b.x);
+    }
+
+    // Sweep order: higher first, and left first on the same height.
+    bool above(int a, int b) const {
+        Point p = at(a), q = at(b);
+        return p.y > q.y || (p.y == q.y && p.x < q.x);
+    }
+
+    double edgeX(int e) const {
+        Point a = at(e), b = at(nextOf(e));
+        // A horizontal edge is only compared while it is inserted, at its
+        // left end: no other vertex of a simple polygon lies on it.
+        if (a.y == b.y) return std::min(a.x, b.x);
+        return a.x + (sweepY - a.y) * ((double)b.x - a.x) / ((double)b.y - a.y);
+    }
+
+    // Counterclockwise vertex list without repeated or collinear vertices.
+    void prepare(int n) {
+        verts.clear();
+        for (int i = 0; i < n; i++) {
+            if (!verts.empty() && pts[verts.back()].x == pts[i].x && pts[verts.back()].y == pts[i].y)
+                continue;
+            verts.push_back(i);
+            while (verts.size() >= 3 && cross(pts[verts[verts.size() - 3]], pts[verts[verts.size() - 2]],
+                pts[verts.back()]) == 0)
+                verts.erase(verts.end() - 2);
+        }
+        // The same across the seam between the last and the first vertex.
+        size_t first = 0;
+        bool changed = true;
+        while (changed && verts.size() - first >= 3) {
+            changed = false;
+            Point a = pts[verts[verts.size() - 2]], b = pts[verts.back()], c = pts[verts[first]];
+            if ((b.x == c.x && b.y == c.y) || cross(a, b, c) == 0) {
+                verts.pop_back();
+                changed = true;
+                continue;
+            }
+            Point d = pts[verts[first + 1]];
+            if (cross(b, c, d) == 0) {
+                first++;
+                changed = true;
+            }
+        }
+        verts.erase(verts.begin(), verts.begin() + first);
+        if (verts.size() < 3) {
+            verts.clear();
+            return;
+        }
+        double area = 0;
+        for (size_t k = 0; k < verts.size(); k++) {
+            Point a = pts[verts[k]], b = pts[verts[(k + 1) % verts.size()]];
+            area += (double)a.x * b.y - (double)b.x * a.y;
+        }
+        if (area < 0)
+            std::reverse(verts.begin(), verts.end());
+    }
+
+    // Monotone partition: record the diagonals that remove every split
+    // and merge vertex.
+    void sweep() {
+        int m = (int)verts.size();
+        order.resize(m);
+        for (int k = 0; k < m; k++) order[k] = k;
+        std::sort(order.begin(), order.end(), [this](int a, int b) { return above(a, b); });
+        helper.assign(m, -1);
+        merge.assign(m, 0);
+        edgeIt.resize(m);
+        diagonals.clear();
+        status.clear();
+
+        for (int v : order) {
+            Point p = at(v);
+            sweepX = p.x;
+            sweepY = p.y;
+            int prev = prevOf(v), next = nextOf(v);
+            bool prevBelow = above(v, prev), nextBelow = above(v, next);
+            bool convex = cross(at(prev), p, at(next)) > 0;
+            if (prevBelow && nextBelow) {
+                if (!convex) {
+                    // Split: connect to the helper of the edge on the left.
+                    int left = edgeLeftOfSweep();
+                    if (left >= 0) {
+                        addDiagonal(v, helper[left]);
+                        helper[left] = v;
+                    }
+                }
+                insertEdge(v, v);
+            }
+            else if (!prevBelow && !nextBelow) {
+                fixUp(v, prev);
+                eraseEdge(prev);
+                if (!convex) {
+                    // Merge: the diagonal comes from a vertex further down.
+                    merge[v] = 1;
+                    int left = edgeLeftOfSweep();
+                    if (left >= 0) {
+                        fixUp(v, left);
+                        helper[left] = v;
+                    }
+                }
+            }
+            else if (!prevBelow) {
+                // Regular on a left chain: the interior is to the right.
+                fixUp(v, prev);
+                eraseEdge(prev);
+                insertEdge(v, v);
+            }
+            else {
+                int left = edgeLeftOfSweep();
+                if (left >= 0) {
+                    fixUp(v, left);
+                    helper[left] = v;
+                }
+            }
+        }
+    }
+
+    void insertEdge(int e, int help) {
+        edgeIt[e] = status.insert(e);
+        helper[e] = help;
+    }
+    void eraseEdge(int e) {
+        if (helper[e] >= 0) status.erase(edgeIt[e]);
+        helper[e] = -1;
+    }
+    // Edge of the status directly left of the sweep point, or -1.
+    int edgeLeftOfSweep() const {
+        EdgeTree::const_iterator it = status.lower_bound(sweepX);
+        if (it == status.begin()) return -1;
+        return *--it;
+    }
+    // If edge e's helper is a merge vertex, connect it to v.
+    void fixUp(int v, int e) {
+        if (e >= 0 && helper[e] >= 0 && merge[helper[e]])
+            addDiagonal(v, helper[e]);
+    }
+    void addDiagonal(int a, int b) { diagonals.push_back({ a, b }); }
+
+    // Split the polygon along the diagonals by walking the faces of the
+    // planar graph, and triangulate each monotone face.
+    void triangulatePieces() {
+        int m = (int)verts.size();
+        adjStart.assign(m + 1, 0);
+        for (int k = 0; k < m; k++) adjStart[k + 1] = 2;
+        for (const std::pair<int, int>& d : diagonals) {
+            adjStart[d.first + 1]++;
+            adjStart[d.second + 1]++;
+        }
+        for (int k = 0; k < m; k++) adjStart[k + 1] += adjStart[k];
+        adj.resize(adjStart[m]);
+        adjAngle.resize(adjStart[m]);
+        used.assign(adjStart[m], 0);
+        fill.assign(adjStart.begin(), adjStart.end() - 1);
+        for (int k = 0; k < m; k++) {
+            adj[fill[k]++] = prevOf(k);
+            adj[fill[k]++] = nextOf(k);
+        }
+        for (const std::pair<int, int>& d : diagonals) {
+            adj[fill[d.first]++] = d.second;
+            adj[fill[d.second]++] = d.first;
+        }
+        // Neighbors of each vertex in counterclockwise order.
+        for (int k = 0; k < m; k++) {
+            Point p = at(k);
+            for (int h = adjStart[k]; h < adjStart[k + 1]; h++) {
+                Point q = at(adj[h]);
+                adjAngle[h] = std::atan2((double)q.y - p.y, (double)q.x - p.x);
+            }
+            sortNeighbors(adjStart[k], adjStart[k + 1]);
+        }
+        // Faces inside the polygon run along its edges forwards and along
+        // diagonals either way; the reversed polygon edges bound the outside.
+        for (int k = 0; k < m; k++)
+            for (int h = adjStart[k]; h < adjStart[k + 1]; h++) {
+                if (used[h] || adj[h] == prevOf(k)) continue;
+                piece.clear();
+                int u = k, e = h;
+                while (!used[e]) {
+                    used[e] = 1;
+                    piece.push_back(u);
+                    int w = adj[e];
+                    // At w, the next edge is the one just clockwise of w -> u.
+                    int back = findNeighbor(w, u);
+                    e = back == adjStart[w] ? adjStart[w + 1] - 1 : back - 1;
+                    u = w;
+                }
+                triangulateMonotone();
+            }
+    }
+
+    void sortNeighbors(int begin, int end) {
+        // Insertion sort: most vertices have two or three neighbors.
+        for (int i = begin + 1; i < end; i++) {
+            double a = adjAngle[i];
+            int v = adj[i];
+            int j = i;
+            for (; j > begin && adjAngle[j - 1] > a; j--) {
+                adjAngle[j] = adjAngle[j - 1];
+                adj[j] = adj[j - 1];
+            }
+            adjAngle[j] = a;
+            adj[j] = v;
+        }
+    }
+
+    int findNeighbor(int w, int u) const {
+        int begin = adjStart[w], end = adjStart[w + 1];
+        if (end - begin <= 8) {
+            for (int h = begin; h < end; h++)
+                if (adj[h] == u) return h;
+        }
+        Point p = at(w), q = at(u);
+        double a = std::atan2((double)q.y - p.y, (double)q.x - p.x);
+        int h = (int)(std::lower_bound(adjAngle.begin() + begin, adjAngle.begin() + end, a) -
+            adjAngle.begin());
+        for (; h < end; h++)
+            if (adj[h] == u) return h;
+        for (h = begin; h < end; h++)
+            if (adj[h] == u) return h;
+        return begin;
+    }
+
+    // Triangulate the y-monotone counterclockwise face in piece.
+    void triangulateMonotone() {
+        int s = (int)piece.size();
+        if (s < 3) return;
+        if (s == 3) {
+            emit(piece[0], piece[1], piece[2]);
+            return;
+        }
+        int top = 0, bottom = 0;
+        for (int i = 1; i < s; i++) {
+            if (above(piece[i], piece[top])) top = i;
+            if (above(piece[bottom], piece[i])) bottom = i;
+        }
+        // Counterclockwise from the top runs down the left chain; merge
+        // the two chains into sweep order. The bottom vertex comes last.
+        sorted.clear();
+        onLeft.clear();
+        sorted.push_back(piece[top]);
+        onLeft.push_back(1);
+        int l = (top + 1) % s, r = (top + s - 1) % s;
+        while (l != bottom || r != bottom) {
+            if (r == bottom || (l != bottom && above(piece[l], piece[r]))) {
+                sorted.push_back(piece[l]);
+                onLeft.push_back(1);
+                l = (l + 1) % s;
+            }
+            else {
+                sorted.push_back(piece[r]);
+                onLeft.push_back(0);
+                r = (r + s - 1) % s;
+            }
+        }
+        sorted.push_back(piece[bottom]);
+        onLeft.push_back(0);
+
+        stack.clear();
+        stack.push_back(0);
+        stack.push_back(1);
+        for (int j = 2; j < s - 1; j++) {
+            if (onLeft[j] != onLeft[stack.back()]) {
+                // Opposite chain: fan to everything on the stack.
+                for (size_t i = 1; i < stack.size(); i++)
+                    emit(sorted[j], sorted[stack[i - 1]], sorted[stack[i]]);
+                stack.clear();
+                stack.push_back(j - 1);
+                stack.push_back(j);
+            }
+            else {
+                // Same chain: cut off triangles while the diagonal is inside.
+                int last = stack.back();
+                stack.pop_back();
+                while (!stack.empty()) {
+                    Point a = at(sorted[stack.back()]), b = at(sorted[last]), c = at(sorted[j]);
+                    double turn = onLeft[j] ? cross(a, b, c) : -cross(a, b, c);
+                    if (turn <= 0) break;
+                    emit(sorted[j], sorted[last], sorted[stack.back()]);
+                    last = stack.back();
+                    stack.pop_back();
+                }
+                stack.push_back(last);
+                stack.push_back(j);
+            }
+        }
+        for (size_t i = 1; i < stack.size(); i++)
+            emit(sorted[s - 1], sorted[stack[i - 1]], sorted[stack[i]]);
+    }
+
+    // Append a triangle of cleaned vertices, counterclockwise.
+    void emit(int a, int b, int c) {
+        if (cross(at(a), at(b), at(c)) < 0) std::swap(b, c);
+        tris.push_back(verts[a]);
+        tris.push_back(verts[b]);
+        tris.push_back(verts[c]);
+    }
+
+    const Point* pts = nullptr;
+    std::vector<int> verts;         // input index of each cleaned vertex
+    std::vector<int> tris;          // output, input indices
+    // Sweep
+    std::vector<int> order, helper;
+    std::vector<char> merge;
+    std::vector<EdgeTree::iterator> edgeIt;
+    std::vector<std::pair<int, int> > diagonals;
+    double sweepX = 0, sweepY = 0;
+    std::pmr::unsynchronized_pool_resource pool;
+    EdgeTree status;
+    // Faces
+    std::vector<int> adjStart, adj, fill;
+    std::vector<double> adjAngle;
+    std::vector<char> used;
+    std::vector<int> piece, sorted, stack;
+    std::vector<char> onLeft;
+};
@@ -0,0 +1,112 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Checks on draw calls read back from files (scene files and traces),
+// which may be truncated, corrupt or crafted. The backends trust their
+// arguments, so every value that selects a code path or sizes memory or
+// work is checked once, when the file is opened: primitive and ellipse
+// modes, vertex and position coordinates, colors, scissor boxes, ellipse
+// radii and ring thickness, line widths, and the glyphs of laid-out
+// text. Each check returns null when the call is fine, else what is
+// wrong with it.
+// ---------------------------------------------------------------------
+#include <GL/gl.h>
+#include "geom.h"
+#include "midpoint.h"
+#include "text.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Largest radius, ring thickness or line width a file may hold, in world
+// units: far beyond any window, yet small enough that the span buffers
+// they size stay small.
+const float MAX_RECORDED_EXTENT = 65536.0f;
+// Largest vertex or position coordinate, in world units, and glyph
+// offset in a laid-out string, in pixels; both stay far from int
+// overflow once scaled to the window.
+const float MAX_RECORDED_COORDINATE = 16777216.0f;
+const int MAX_RECORDED_GLYPH_OFFSET = 1 << 24;
+
+inline bool recordedExtentOk(float v) {
+    return std::isfinite(v) && std::fabs(v) <= MAX_RECORDED_EXTENT;
+}
+
+inline bool recordedCoordinateOk(float v) {
+    return std::isfinite(v) && std::fabs(v) <= MAX_RECORDED_COORDINATE;
+}
+
+// A raster or text position.
+inline const char* checkPosition(float x, float y) {
+    return recordedCoordinateOk(x) && recordedCoordinateOk(y) ? nullptr : "bad position";
+}
+
+// A comparison with NaN is false, so one compare per coordinate rejects
+// NaN, infinities and large values alike, and the loop vectorizes.
+inline const char* checkVertices(const Point* vertices, size_t count) {
+    const float* c = &vertices[0].x;
+    bool ok = true;
+    for (size_t i = 0; i < 2 * count; i++)
+        ok &= std::fabs(c[i]) <= MAX_RECORDED_COORDINATE;
+    return ok ? nullptr : "bad vertex";
+}
+
+// Out-of-range channels are clamped when drawn; only NaN cannot be.
+inline const char* checkColor(float r, float g, float b) {
+    return std::isfinite(r) && std::isfinite(g) && std::isfinite(b) ? nullptr : "bad color";
+}
+
+// The box's far corner must not overflow an int.
+inline const char* checkScissor(int32_t x, int32_t y, int32_t width, int32_t height) {
+    if (width < 0 || height < 0 || (int64_t)x + width > INT32_MAX || (int64_t)y + height > INT32_MAX)
+        return "bad scissor box";
+    return nullptr;
+}
+
+// GL_POINTS through GL_POLYGON, the modes every backend draws.
+inline const char* checkPrimitiveMode(uint32_t mode) {
+    return mode <= GL_POLYGON ? nullptr : "bad primitive mode";
+}
+
+// A redraw rectangle, corners x0 <= x1 and y0 <= y1.
+inline const char* checkDamage(int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+    return x0 <= x1 && y0 <= y1 ? nullptr : "bad damage rectangle";
+}
+
+inline const char* checkEllipse(float cx, float cy, float rx, float ry, uint32_t mode,
+    float thickness) {
+    if (mode > ELLIPSE_RING) return "bad ellipse mode";
+    if (!recordedCoordinateOk(cx) || !recordedCoordinateOk(cy)) return "bad ellipse center";
+    if (!recordedExtentOk(rx) || !recordedExtentOk(ry) || !recordedExtentOk(thickness))
+        return "bad ellipse size";
+    return nullptr;
+}
+
+inline const char* checkLineWidth(float width) {
+    return recordedExtentOk(width) ? nullptr : "bad line width";
+}
+
+// Lay out count glyphs of Helvetica 18 given as (dx, character) pairs,
+// the form both file formats store them in.
+inline const char* layoutRecordedText(TextLayout& layout, int advance, const int32_t* placed,
+    uint32_t count) {
+    const GlyphAtlas& atlas = helvetica18Atlas();
+    layout.atlas = &atlas;
+    layout.advance = advance;
+    layout.glyphs.clear();
+    layout.glyphs.reserve(count);
+    for (uint32_t k = 0; k < count; k++) {
+        int dx = placed[2 * k];
+        const Glyph* glyph = atlas.find(placed[2 * k + 1]);
+        if (!glyph) return "bad glyph";
+        if (dx < -MAX_RECORDED_GLYPH_OFFSET || dx > MAX_RECORDED_GLYPH_OFFSET)
+            return "bad glyph offset";
+        PixelRect box = glyphBounds(*glyph, dx, 0);
+        if (layout.glyphs.empty()) layout.ink = box;
+        layout.ink.x0 = std::min(layout.ink.x0, box.x0);
+        layout.ink.y0 = std::min(layout.ink.y0, box.y0);
+        layout.ink.x1 = std::max(layout.ink.x1, box.x1);
+        layout.ink.y1 = std::max(layout.ink.y1, box.y1);
+        layout.glyphs.push_back({ dx, glyph });
+    }
+    return nullptr;
+}
@@ -0,0 +1,112 @@
+#include <GL/glut.h>
+#include "gfx/gl_backend.h"
+#include "gfx/glut_loop.h"
+#include "gfx/headless.h"
+#include "gfx/profiler.h"
+#include "gfx/dirty.h"
+#include "gfx/scene.h"
+
+// -----------------------------
+// Olympic rings
+// -----------------------------
+// Five rings drawn with the midpoint ellipse rasterizer, each filled with
+// a different pattern and edged with a solid outline.
+struct Ring {
+    float cx, cy;
+    float r, g, b;
+    const FillPattern* pattern;
+};
+
+const float ringRadius = 60, ringWidth = 12;
+
+const Ring rings[] = {
+    { 110, 290, 0.0f, 0.5f, 0.85f, &PATTERN_SOLID },       // blue
+    { 250, 290, 0.0f, 0.0f, 0.0f, &PATTERN_CROSSHATCH },   // black
+    { 390, 290, 0.9f, 0.1f, 0.2f, &PATTERN_DIAGONAL },     // red
+    { 180, 230, 1.0f, 0.75f, 0.0f, &PATTERN_DOTS },        // yellow
+    { 320, 230, 0.0f, 0.6f, 0.3f, &PATTERN_CHECKER },      // green
+};
+
+void drawRing(const Ring& ring) {
+    GFX_PROFILE_FUNCTION();
+    gfxColor3f(ring.r, ring.g, ring.b);
+    gfxEllipse(ring.cx, ring.cy, ringRadius, ringRadius, ELLIPSE_RING, ringWidth, ring.pattern);
+    // Solid edges keep the sparse patterns readable as rings
+    gfxEllipse(ring.cx, ring.cy, ringRadius, ringRadius, ELLIPSE_OUTLINE);
+    gfxEllipse(ring.cx, ring.cy, ringRadius - ringWidth, ringRadius - ringWidth, ELLIPSE_OUTLINE);
+}
+
+// The scene is static: it is recorded once at startup and display()
+// replays it (--immediate redraws it every frame).
+Scene scene;
+bool immediateMode = false;
+// --incremental: nothing changes after the first frame, so nothing is redrawn.
+bool incrementalMode = false;
+IncrementalRedraw redraw;
+// Nothing moves: the loop only paces frames and measures the frame rate.
+FrameLoop frameLoop;
+const char* windowTitle = "Olympic Rings with Pattern Fills";
+
+void drawOlympics() {
+    GFX_PROFILE_FUNCTION();
+    for (const Ring& ring : rings)
+        drawRing(ring);
+}
+
+void display() {
+    ProfileFrame frame;
+    if (incrementalMode) {
+        redraw.draw();
+    }
+    else {
+        gfxClear(GL_COLOR_BUFFER_BIT);
+        if (immediateMode)
+            drawOlympics();
+        else
+            drawScene(scene);
+    }
+    drawProfileOverlay();
+    GFX_PROFILE("flush");
+    gfxFlush();
+}
+
+int main(int argc, char** argv) {
+    AppOptions options = parseAppOptions(argc, argv);
+    immediateMode = options.immediate;
+    incrementalMode = options.incremental;
+    profiler.enabled = options.profile;
+    recordScene(scene, drawOlympics);
+    redraw.addScene(&scene);
+    if (options.saveScene)
+        return runSaveScene(options, display, 1.0f, 1.0f, 1.0f);
+    if (options.headless) {
+        // Render on the CPU (white background) and write out an image
+        return runHeadless(options, display, 1.0f, 1.0f, 1.0f, &frameLoop);
+    }
+
+    configureSwapInterval(options.uncapped);
+    glutInit(&argc, argv);
+    // Double buffering and RGB color mode
+    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);
+    glutInitWindowSize(500, 500);
+    glutInitWindowPosition(100, 100);
+    glutCreateWindow(windowTitle);
+    GlBackend glBackend;
+    gfxUseBackend(&glBackend);
+    if (options.saveTrace)
+        startTraceCapture(options.saveTrace);
+
+    // White background
+    gfxClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+    // 2D orthogonal projection
+    glMatrixMode(GL_PROJECTION);
+    gluOrtho2D(0, 500, 0, 500);
+
+    runGlutFrameLoop(frameLoop, display, windowTitle, options.uncapped, options.frameRate);
+    if (options.profile) {
+        profiler.overlay = true;
+        finishProfileAtExit(options.profileOut);
+    }
+    glutMainLoop();
+    return 0;
+}
@@ -1,139 +1,25 @@
 #include <GL/glut.h>
 #include <cmath>
 #include <vector>
+#include "gfx/geom.h"
+#include "gfx/circle.h"
+#include "gfx/frame_loop.h"
+#include "gfx/gl_backend.h"
+#include "gfx/glut_loop.h"
+#include "gfx/headless.h"
+#include "gfx/polyclip.h"
+#include "gfx/profiler.h"
+#include "gfx/dirty.h"
+#include "gfx/scene.h"
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-// Define a simple 2D point structure
-struct Point {
-    float x, y;
-};
-
 // Global variables for our play area (clipping rectangle)
 float winXmin = 150, winXmax = 350, winYmin = 150, winYmax = 350;
 
-// ---------------------------------------------------------------------
-// Sutherland–Hodgman Polygon Clipping Functions (clip against 4 edges)
-// ---------------------------------------------------------------------
-
-// Clip against left boundary: x >= xMin
-std::vector<Point> clipLeft(const std::vector<Point>& poly, float xMin) {
-    std::vector<Point> result;
-    int n = poly.size();
-    for (int i = 0; i < n; i++) {
-        Point curr = poly[i];
-        Point prev = poly[(i + n - 1) % n];
-        bool currInside = (curr.x >= xMin);
-        bool prevInside = (prev.x >= xMin);
-        if (prevInside && currInside) {
-            result.push_back(curr);
-        }
-        else if (prevInside && !currInside) {
-            float t = (xMin - prev.x) / (curr.x - prev.x);
-            Point inter = { xMin, prev.y + t * (curr.y - prev.y) };
-            result.push_back(inter);
-        }
-        else if (!prevInside && currInside) {
-            float t = (xMin - prev.x) / (curr.x - prev.x);
-            Point inter = { xMin, prev.y + t * (curr.y - prev.y) };
-            result.push_back(inter);
-            result.push_back(curr);
-        }
-    }
-    return result;
-}
-
-// Clip against right boundary: x <= xMax
-std::vector<Point> clipRight(const std::vector<Point>& poly, float xMax) {
-    std::vector<Point> result;
-    int n = poly.size();
-    for (int i = 0; i < n; i++) {
-        Point curr = poly[i];
-        Point prev = poly[(i + n - 1) % n];
-        bool currInside = (curr.x <= xMax);
-        bool prevInside = (prev.x <= xMax);
-        if (prevInside && currInside) {
-            result.push_back(curr);
-        }
-        else if (prevInside && !currInside) {
-            float t = (xMax - prev.x) / (curr.x - prev.x);
-            Point inter = { xMax, prev.y + t * (curr.y - prev.y) };
-            result.push_back(inter);
-        }
-        else if (!prevInside && currInside) {
-            float t = (xMax - prev.x) / (curr.x - prev.x);
-            Point inter = { xMax, prev.y + t * (curr.y - prev.y) };
-            result.push_back(inter);
-            result.push_back(curr);
-        }
-    }
-    return result;
-}
-
-// Clip against bottom boundary: y >= yMin
-std::vector<Point> clipBottom(const std::vector<Point>& poly, float yMin) {
-    std::vector<Point> result;
-    int n = poly.size();
-    for (int i = 0; i < n; i++) {
-        Point curr = poly[i];
-        Point prev = poly[(i + n - 1) % n];
-        bool currInside = (curr.y >= yMin);
-        bool prevInside = (prev.y >= yMin);
-        if (prevInside && currInside) {
-            result.push_back(curr);
-        }
-        else if (prevInside && !currInside) {
-            float t = (yMin - prev.y) / (curr.y - prev.y);
-            Point inter = { prev.x + t * (curr.x - prev.x), yMin };
-            result.push_back(inter);
-        }
-        else if (!prevInside && currInside) {
-            float t = (yMin - prev.y) / (curr.y - prev.y);
-            Point inter = { prev.x + t * (curr.x - prev.x), yMin };
-            result.push_back(inter);
-            result.push_back(curr);
-        }
-    }
-    return result;
-}
-
-// Clip against top boundary: y <= yMax
-std::vector<Point> clipTop(const std::vector<Point>& poly, float yMax) {
-    std::vector<Point> result;
-    int n = poly.size();
-    for (int i = 0; i < n; i++) {
-        Point curr = poly[i];
-        Point prev = poly[(i + n - 1) % n];
-        bool currInside = (curr.y <= yMax);
-        bool prevInside = (prev.y <= yMax);
-        if (prevInside && currInside) {
-            result.push_back(curr);
-        }
-        else if (prevInside && !currInside) {
-            float t = (yMax - prev.y) / (curr.y - prev.y);
-            Point inter = { prev.x + t * (curr.x - prev.x), yMax };
-            result.push_back(inter);
-        }
-        else if (!prevInside && currInside) {
-            float t = (yMax - prev.y) / (curr.y - prev.y);
-            Point inter = { prev.x + t * (curr.x - prev.x), yMax };
-            result.push_back(inter);
-            result.push_back(curr);
-        }
-    }
-    return result;
-}
-
-// Sutherland–Hodgman clipping: clips polygon 'poly' against a rectangular region.
-std::vector<Point> sutherlandHodgmanClip(const std::vector<Point>& poly,
-    float xMin, float xMax, float yMin, float yMax) {
-    std::vector<Point> output = clipLeft(poly, xMin);
-    output = clipRight(output, xMax);
-    output = clipBottom(output, yMin);
-    output = clipTop(output, yMax);
-    return output;
-}
+// Pieces of the ball outside the play area, reused every frame
+PolygonSet ballOutside;
 
 // --------------------------
 // Drawing Functions for Scene
@@ -141,238 +27,334 @@ std::vector<Point> sutherlandHodgmanClip(const std::vector<Point>& poly,
 
 // Draw background: sky (upper) and grass (lower)
 void drawBackground() {
+    GFX_PROFILE_FUNCTION();
     // Sky
-    glColor3f(0.53f, 0.81f, 0.98f); // light blue
-    glBegin(GL_POLYGON);
-    glVertex2f(0, 250);
-    glVertex2f(500, 250);
-    glVertex2f(500, 500);
-    glVertex2f(0, 500);
-    glEnd();
+    gfxColor3f(0.53f, 0.81f, 0.98f); // light blue
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(0, 250);
+    gfxVertex2f(500, 250);
+    gfxVertex2f(500, 500);
+    gfxVertex2f(0, 500);
+    gfxEnd();
     // Grass
-    glColor3f(0.0f, 0.8f, 0.0f); // green
-    glBegin(GL_POLYGON);
-    glVertex2f(0, 0);
-    glVertex2f(500, 0);
-    glVertex2f(500, 250);
-    glVertex2f(0, 250);
-    glEnd();
+    gfxColor3f(0.0f, 0.8f, 0.0f); // green
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(0, 0);
+    gfxVertex2f(500, 0);
+    gfxVertex2f(500, 250);
+    gfxVertex2f(0, 250);
+    gfxEnd();
 }
 
 // Draw the play area as a light-gray rectangle (this is our clipping window)
 void drawPlayArea() {
-    glColor3f(0.9f, 0.9f, 0.9f); // light gray fill
-    glBegin(GL_POLYGON);
-    glVertex2f(winXmin, winYmin);
-    glVertex2f(winXmax, winYmin);
-    glVertex2f(winXmax, winYmax);
-    glVertex2f(winXmin, winYmax);
-    glEnd();
-    glColor3f(0.0f, 0.0f, 0.0f); // black border
-    glLineWidth(3.0f);
-    glBegin(GL_LINE_LOOP);
-    glVertex2f(winXmin, winYmin);
-    glVertex2f(winXmax, winYmin);
-    glVertex2f(winXmax, winYmax);
-    glVertex2f(winXmin, winYmax);
-    glEnd();
+    GFX_PROFILE_FUNCTION();
+    gfxColor3f(0.9f, 0.9f, 0.9f); // light gray fill
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(winXmin, winYmin);
+    gfxVertex2f(winXmax, winYmin);
+    gfxVertex2f(winXmax, winYmax);
+    gfxVertex2f(winXmin, winYmax);
+    gfxEnd();
+    gfxColor3f(0.0f, 0.0f, 0.0f); // black border
+    gfxLineWidth(3.0f);
+    gfxBegin(GL_LINE_LOOP);
+    gfxVertex2f(winXmin, winYmin);
+    gfxVertex2f(winXmax, winYmin);
+    gfxVertex2f(winXmax, winYmax);
+    gfxVertex2f(winXmin, winYmax);
+    gfxEnd();
 }
 
 // Draw a slide at the lower left
 void drawSlide() {
+    GFX_PROFILE_FUNCTION();
     // Platform
-    glColor3f(0.6f, 0.3f, 0.0f); // brown
-    glBegin(GL_POLYGON);
-    glVertex2f(50, 100);
-    glVertex2f(100, 100);
-    glVertex2f(100, 130);
-    glVertex2f(50, 130);
-    glEnd();
+    gfxColor3f(0.6f, 0.3f, 0.0f); // brown
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(50, 100);
+    gfxVertex2f(100, 100);
+    gfxVertex2f(100, 130);
+    gfxVertex2f(50, 130);
+    gfxEnd();
     // Slanted slide surface
-    glColor3f(0.8f, 0.8f, 0.8f); // light gray
-    glBegin(GL_POLYGON);
-    glVertex2f(100, 130);
-    glVertex2f(150, 80);
-    glVertex2f(140, 70);
-    glVertex2f(90, 120);
-    glEnd();
+    gfxColor3f(0.8f, 0.8f, 0.8f); // light gray
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(100, 130);
+    gfxVertex2f(150, 80);
+    gfxVertex2f(140, 70);
+    gfxVertex2f(90, 120);
+    gfxEnd();
+}
+
+// --------------------------
+// Animation
+// --------------------------
+// Advanced by the frame loop in fixed steps. At time 0 the swing hangs
+// straight down and the merry-go-round is in its original position.
+double animationTime = 0;
+
+void updatePlayground(double dt) {
+    animationTime += dt;
+}
+
+FrameLoop frameLoop(updatePlayground);
+
+// Swing angle from the vertical in radians, with a 2.4 s period
+double swingAngle() {
+    return 0.35 * std::sin(2.0 * M_PI * animationTime / 2.4);
+}
+
+// Merry-go-round rotation in radians, 0.9 rad/s counter-clockwise
+double merryGoRoundAngle() {
+    return 0.9 * animationTime;
 }
 
 // Draw a swing set with two posts, a top bar, ropes, and a seat
 void drawSwing() {
+    GFX_PROFILE_FUNCTION();
     // Left post
-    glColor3f(0.5f, 0.25f, 0.0f);
-    glBegin(GL_POLYGON);
-    glVertex2f(200, 200);
-    glVertex2f(210, 200);
-    glVertex2f(210, 300);
-    glVertex2f(200, 300);
-    glEnd();
+    gfxColor3f(0.5f, 0.25f, 0.0f);
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(200, 200);
+    gfxVertex2f(210, 200);
+    gfxVertex2f(210, 300);
+    gfxVertex2f(200, 300);
+    gfxEnd();
     // Right post
-    glBegin(GL_POLYGON);
-    glVertex2f(240, 200);
-    glVertex2f(250, 200);
-    glVertex2f(250, 300);
-    glVertex2f(240, 300);
-    glEnd();
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(240, 200);
+    gfxVertex2f(250, 200);
+    gfxVertex2f(250, 300);
+    gfxVertex2f(240, 300);
+    gfxEnd();
     // Top bar
-    glBegin(GL_POLYGON);
-    glVertex2f(200, 300);
-    glVertex2f(250, 300);
-    glVertex2f(250, 310);
-    glVertex2f(200, 310);
-    glEnd();
-    // Ropes
-    glColor3f(0.0f, 0.0f, 0.0f);
-    glBegin(GL_LINES);
-    glVertex2f(210, 300);
-    glVertex2f(210, 270);
-    glVertex2f(240, 300);
-    glVertex2f(240, 270);
-    glEnd();
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(200, 300);
+    gfxVertex2f(250, 300);
+    gfxVertex2f(250, 310);
+    gfxVertex2f(200, 310);
+    gfxEnd();
+    // Ropes, 30 long, swing about the bar; the seat moves with their ends
+    double angle = swingAngle();
+    float dx = (float)(30.0 * std::sin(angle)), dy = (float)(30.0 - 30.0 * std::cos(angle));
+    gfxColor3f(0.0f, 0.0f, 0.0f);
+    gfxBegin(GL_LINES);
+    gfxVertex2f(210, 300);
+    gfxVertex2f(210 + dx, 270 + dy);
+    gfxVertex2f(240, 300);
+    gfxVertex2f(240 + dx, 270 + dy);
+    gfxEnd();
     // Seat (red)
-    glColor3f(0.8f, 0.0f, 0.0f);
-    glBegin(GL_POLYGON);
-    glVertex2f(205, 260);
-    glVertex2f(245, 260);
-    glVertex2f(245, 265);
-    glVertex2f(205, 265);
-    glEnd();
+    gfxColor3f(0.8f, 0.0f, 0.0f);
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(205 + dx, 260 + dy);
+    gfxVertex2f(245 + dx, 260 + dy);
+    gfxVertex2f(245 + dx, 265 + dy);
+    gfxVertex2f(205 + dx, 265 + dy);
+    gfxEnd();
 }
 
 // Draw a merry-go-round: a circle with spokes
 void drawMerryGoRound() {
-    glColor3f(0.0f, 0.5f, 0.5f);
+    GFX_PROFILE_FUNCTION();
+    gfxColor3f(0.0f, 0.5f, 0.5f);
     const int segments = 40;
     float cx = 400, cy = 400, r = 40;
-    glBegin(GL_POLYGON);
-    for (int i = 0; i < segments; i++) {
-        float theta = 2.0f * M_PI * i / segments;
-        glVertex2f(cx + r * cos(theta), cy + r * sin(theta));
-    }
-    glEnd();
-    glColor3f(0.0f, 0.0f, 0.0f);
-    glBegin(GL_LINES);
+    Point circle[segments];
+    tessellateCircle(cx, cy, r, segments, circle);
+    gfxBegin(GL_POLYGON);
+    for (int i = 0; i < segments; i++)
+        gfxVertex2f(circle[i].x, circle[i].y);
+    gfxEnd();
+    // Spokes, turned about the center (exactly the rim points at angle 0)
+    double c = std::cos(merryGoRoundAngle()), s = std::sin(merryGoRoundAngle());
+    gfxColor3f(0.0f, 0.0f, 0.0f);
+    gfxBegin(GL_LINES);
     for (int i = 0; i < segments; i += 8) {
-        float theta = 2.0f * M_PI * i / segments;
-        glVertex2f(cx, cy);
-        glVertex2f(cx + r * cos(theta), cy + r * sin(theta));
+        double dx = (double)circle[i].x - cx, dy = (double)circle[i].y - cy;
+        gfxVertex2f(cx, cy);
+        gfxVertex2f((float)(cx + dx * c - dy * s), (float)(cy + dx * s + dy * c));
     }
-    glEnd();
+    gfxEnd();
 }
 
 // Draw a tree: trunk and circular foliage
 void drawTree() {
+    GFX_PROFILE_FUNCTION();
     // Trunk
-    glColor3f(0.55f, 0.27f, 0.07f);
-    glBegin(GL_POLYGON);
-    glVertex2f(80, 180);
-    glVertex2f(90, 180);
-    glVertex2f(90, 250);
-    glVertex2f(80, 250);
-    glEnd();
+    gfxColor3f(0.55f, 0.27f, 0.07f);
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(80, 180);
+    gfxVertex2f(90, 180);
+    gfxVertex2f(90, 250);
+    gfxVertex2f(80, 250);
+    gfxEnd();
     // Foliage
-    glColor3f(0.0f, 0.8f, 0.0f);
+    gfxColor3f(0.0f, 0.8f, 0.0f);
     const int segments = 30;
     float cx = 85, cy = 270, r = 30;
-    glBegin(GL_POLYGON);
-    for (int i = 0; i < segments; i++) {
-        float theta = 2.0f * M_PI * i / segments;
-        glVertex2f(cx + r * cos(theta), cy + r * sin(theta));
-    }
-    glEnd();
+    Point circle[segments];
+    tessellateCircle(cx, cy, r, segments, circle);
+    gfxBegin(GL_POLYGON);
+    for (int i = 0; i < segments; i++)
+        gfxVertex2f(circle[i].x, circle[i].y);
+    gfxEnd();
 }
 
 // Draw a bench
 void drawBench() {
+    GFX_PROFILE_FUNCTION();
     // Seat
-    glColor3f(0.6f, 0.3f, 0.0f);
-    glBegin(GL_POLYGON);
-    glVertex2f(300, 50);
-    glVertex2f(400, 50);
-    glVertex2f(400, 70);
-    glVertex2f(300, 70);
-    glEnd();
+    gfxColor3f(0.6f, 0.3f, 0.0f);
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(300, 50);
+    gfxVertex2f(400, 50);
+    gfxVertex2f(400, 70);
+    gfxVertex2f(300, 70);
+    gfxEnd();
     // Backrest
-    glBegin(GL_POLYGON);
-    glVertex2f(300, 70);
-    glVertex2f(400, 70);
-    glVertex2f(400, 90);
-    glVertex2f(300, 90);
-    glEnd();
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(300, 70);
+    gfxVertex2f(400, 70);
+    gfxVertex2f(400, 90);
+    gfxVertex2f(300, 90);
+    gfxEnd();
 }
 
 // Draw a soccer ball (approximated as a circle) and clip the part inside the play area
 void drawBall() {
-    std::vector<Point> ballPoly;
+    GFX_PROFILE_FUNCTION();
     const int segments = 50;
+    Point ballPoly[segments];
     float cx = 300, cy = 300, r = 60;
     // Create polygon for ball
-    for (int i = 0; i < segments; i++) {
-        float theta = 2.0f * M_PI * i / segments;
-        float x = cx + r * cos(theta);
-        float y = cy + r * sin(theta);
-        ballPoly.push_back({ x, y });
+    tessellateCircle(cx, cy, r, segments, ballPoly);
+    // Cut away the part inside the play area (polygon difference)
+    {
+        GFX_PROFILE_CLIP("polygon clipping");
+        clipPolygonOutside(ballPoly, segments, winXmin, winXmax, winYmin, winYmax, ballOutside);
     }
-    // Draw full ball (red)
-    glColor3f(1.0f, 0.0f, 0.0f);
-    glBegin(GL_POLYGON);
-    for (auto p : ballPoly)
-        glVertex2f(p.x, p.y);
-    glEnd();
-    // Clip the ball polygon against the play area
-    std::vector<Point> insidePoly = sutherlandHodgmanClip(ballPoly, winXmin, winXmax, winYmin, winYmax);
-    // "Erase" the inside portion by filling it with the play area color (light gray)
-    glColor3f(0.9f, 0.9f, 0.9f);
-    if (!insidePoly.empty()) {
-        glBegin(GL_POLYGON);
-        for (auto p : insidePoly)
-            glVertex2f(p.x, p.y);
-        glEnd();
+    // Draw only what is left of the ball (red)
+    gfxColor3f(1.0f, 0.0f, 0.0f);
+    for (int i = 0; i < ballOutside.size(); i++) {
+        const Point* piece = ballOutside.polygon(i);
+        gfxBegin(GL_POLYGON);
+        for (int k = 0; k < ballOutside.count(i); k++)
+            gfxVertex2f(piece[k].x, piece[k].y);
+        gfxEnd();
     }
 }
 
 // --------------------------
 // Display Callback
 // --------------------------
-void display() {
-    glClear(GL_COLOR_BUFFER_BIT);
+// The static parts are recorded once at startup and display() replays
+// their vertex arrays (--immediate redraws everything every frame). The
+// swing and merry-go-round move, so they are drawn every frame between
+// the two recorded layers, keeping the original drawing order.
+Scene backScene, frontScene;
+bool immediateMode = false;
+// --incremental: the swing and the merry-go-round are tracked as objects
+// and only the rectangles they cover, before and after moving, are redrawn.
+bool incrementalMode = false;
+IncrementalRedraw redraw;
+const char* windowTitle = "Realistic Playground with Polygon Clipping";
 
+void drawBackLayer() {
+    GFX_PROFILE_FUNCTION();
     // Draw background (sky and grass)
     drawBackground();
     // Draw the designated play area (clipping window)
     drawPlayArea();
-
-    // Draw playground objects
     drawSlide();
-    drawSwing();
-    drawMerryGoRound();
+}
+
+void drawFrontLayer() {
+    GFX_PROFILE_FUNCTION();
     drawTree();
     drawBench();
     // Draw the soccer ball with clipping applied so only the portion outside the play area shows
     drawBall();
+}
+
+void drawAnimated() {
+    drawSwing();
+    drawMerryGoRound();
+}
 
-    glFlush();
+void drawPlayground() {
+    GFX_PROFILE_FUNCTION();
+    drawBackLayer();
+    drawAnimated();
+    drawFrontLayer();
+}
+
+void display() {
+    ProfileFrame frame;
+    if (incrementalMode) {
+        redraw.draw();
+    }
+    else {
+        gfxClear(GL_COLOR_BUFFER_BIT);
+        if (immediateMode) {
+            drawPlayground();
+        }
+        else {
+            drawScene(backScene);
+            drawAnimated();
+            drawScene(frontScene);
+        }
+    }
+    drawProfileOverlay();
+    GFX_PROFILE("flush");
+    gfxFlush();
 }
 
 // --------------------------
 // Main Function
 // --------------------------
 int main(int argc, char** argv) {
+    AppOptions options = parseAppOptions(argc, argv);
+    immediateMode = options.immediate;
+    incrementalMode = options.incremental;
+    profiler.enabled = options.profile;
+    recordScene(backScene, drawBackLayer);
+    recordScene(frontScene, drawFrontLayer);
+    redraw.addScene(&backScene);
+    redraw.addObject(drawSwing);
+    redraw.addObject(drawMerryGoRound);
+    redraw.addScene(&frontScene);
+    if (options.saveScene)
+        return runSaveScene(options, display, 1.0f, 1.0f, 1.0f);
+    if (options.headless) {
+        // Render on the CPU (white background) and write out an image
+        return runHeadless(options, display, 1.0f, 1.0f, 1.0f, &frameLoop);
+    }
+
+    configureSwapInterval(options.uncapped);
     glutInit(&argc, argv);
-    // Single buffering and RGB mode
-    glutInitDisplayMode(GLUT_SINGLE | GLUT_RGB);
+    // Double buffering and RGB mode
+    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);
     glutInitWindowSize(500, 500);
     glutInitWindowPosition(100, 100);
-    glutCreateWindow("Realistic Playground with Polygon Clipping");
+    glutCreateWindow(windowTitle);
+    GlBackend glBackend;
+    gfxUseBackend(&glBackend);
+    if (options.saveTrace)
+        startTraceCapture(options.saveTrace);
 
     // Set background clear color (won't be seen because we draw our background)
-    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+    gfxClearColor(1.0f, 1.0f, 1.0f, 1.0f);
     // Set up a 2D orthographic projection
     glMatrixMode(GL_PROJECTION);
     gluOrtho2D(0, 500, 0, 500);
 
-    glutDisplayFunc(display);
+    runGlutFrameLoop(frameLoop, display, windowTitle, options.uncapped, options.frameRate);
+    if (options.profile) {
+        profiler.overlay = true;
+        finishProfileAtExit(options.profileOut);
+    }
     glutMainLoop();
     return 0;
 }
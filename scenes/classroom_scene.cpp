@@ -0,0 +1,299 @@
+// Classroom scene elements shared by classroom.CPP and textclip.cpp.
+#include "classroom_scene.h"
+#include "../gfx/circle.h"
+#include "../gfx/clip.h"
+#include "../gfx/profiler.h"
+#include "../gfx/render.h"
+#include "../gfx/spatial.h"
+#include <cmath>
+#include <vector>
+
+bool useLiangBarsky = false;
+
+// The clock's segments indexed by bounding box, built on first use, and
+// the query results, reused every frame.
+BoxTree clockSegments;
+std::vector<int> clockInside, clockCrossing;
+
+// ---------------------
+// Object Drawing Functions
+// ---------------------
+
+// Draw the black board (which serves as the clipping region for the clock)
+void drawBlackBoard() {
+    GFX_PROFILE_FUNCTION();
+    gfxColor3f(0.0f, 0.5f, 0.0f);  // dark green board
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(boardXmin, boardYmin);
+    gfxVertex2f(boardXmax, boardYmin);
+    gfxVertex2f(boardXmax, boardYmax);
+    gfxVertex2f(boardXmin, boardYmax);
+    gfxEnd();
+
+    // Draw board frame
+    gfxColor3f(0.0f, 0.0f, 0.0f);
+    gfxLineWidth(2.0f);
+    gfxBegin(GL_LINE_LOOP);
+    gfxVertex2f(boardXmin, boardYmin);
+    gfxVertex2f(boardXmax, boardYmin);
+    gfxVertex2f(boardXmax, boardYmax);
+    gfxVertex2f(boardXmin, boardYmax);
+    gfxEnd();
+}
+
+// Draw the clock with its circular boundary (approximated by line segments)
+// and clip each segment so that only portions inside the board are drawn.
+// Segments wholly inside or outside the board are sorted out by the index
+// and skip the clipper; only those crossing the board edge are clipped.
+void drawClippedClock() {
+    GFX_PROFILE_FUNCTION();
+    // Clock parameters: placed so that it is partially outside the board.
+    float cx = 80, cy = 400; // center of clock
+    float r = 50;           // radius of clock
+    const int segments = 50;
+    Point circle[segments];
+    tessellateCircle(cx, cy, r, segments, circle);
+    gfxColor3f(1.0f, 0.0f, 0.0f);  // red clock outline
+
+    if (clockSegments.size() == 0) {
+        ClipWindow boxes[segments];
+        for (int i = 0; i < segments; i++)
+            boxes[i] = segmentBounds(circle[i], circle[(i + 1) % segments]);
+        clockSegments.build(boxes, segments);
+    }
+    clockSegments.query({ boardXmin, boardXmax, boardYmin, boardYmax }, clockInside, clockCrossing);
+
+    gfxBegin(GL_LINES);
+    for (int i : clockInside) {
+        gfxVertex2f(circle[i].x, circle[i].y);
+        gfxVertex2f(circle[(i + 1) % segments].x, circle[(i + 1) % segments].y);
+    }
+    for (int i : clockCrossing) {
+        Point p0 = circle[i];
+        Point p1 = circle[(i + 1) % segments];
+
+        // Copy endpoints for clipping
+        float clipX0 = p0.x, clipY0 = p0.y;
+        float clipX1 = p1.x, clipY1 = p1.y;
+
+        bool visible;
+        {
+            GFX_PROFILE_CLIP("line clipping");
+            visible = useLiangBarsky
+                ? liangBarskyClip(clipX0, clipY0, clipX1, clipY1, boardXmin, boardXmax, boardYmin, boardYmax)
+                : cohenSutherlandClip(clipX0, clipY0, clipX1, clipY1, boardXmin, boardXmax, boardYmin, boardYmax);
+        }
+        if (visible)
+        {
+            gfxVertex2f(clipX0, clipY0);
+            gfxVertex2f(clipX1, clipY1);
+        }
+    }
+    gfxEnd();
+}
+
+// Draw a fan on the ceiling.
+void drawFan() {
+    GFX_PROFILE_FUNCTION();
+    // Fan body (circle) at (450,480) with radius 20.
+    float cx = 450, cy = 480, r = 20;
+    gfxColor3f(0.7f, 0.7f, 0.7f);
+    const int segments = 20;
+    Point circle[segments];
+    tessellateCircle(cx, cy, r, segments, circle);
+    gfxBegin(GL_POLYGON);
+    for (int i = 0; i < segments; i++)
+        gfxVertex2f(circle[i].x, circle[i].y);
+    gfxEnd();
+
+    // Fan blades (simple lines)
+    gfxColor3f(0.0f, 0.0f, 0.0f);
+    gfxBegin(GL_LINES);
+    gfxVertex2f(cx, cy);
+    gfxVertex2f(cx, cy + r + 10);
+
+    gfxVertex2f(cx, cy);
+    gfxVertex2f(cx + r + 10, cy);
+
+    gfxVertex2f(cx, cy);
+    gfxVertex2f(cx, cy - r - 10);
+
+    gfxVertex2f(cx, cy);
+    gfxVertex2f(cx - r - 10, cy);
+    gfxEnd();
+}
+
+// Draw a window on the left wall.
+void drawWindow() {
+    GFX_PROFILE_FUNCTION();
+    gfxColor3f(0.5f, 0.8f, 1.0f);  // light blue glass
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(10, 350);
+    gfxVertex2f(60, 350);
+    gfxVertex2f(60, 400);
+    gfxVertex2f(10, 400);
+    gfxEnd();
+
+    // Window frame
+    gfxColor3f(0.0f, 0.0f, 0.0f);
+    gfxLineWidth(1.0f);
+    gfxBegin(GL_LINE_LOOP);
+    gfxVertex2f(10, 350);
+    gfxVertex2f(60, 350);
+    gfxVertex2f(60, 400);
+    gfxVertex2f(10, 400);
+    gfxEnd();
+}
+
+// Draw benches for the students.
+void drawBenches() {
+    GFX_PROFILE_FUNCTION();
+    gfxColor3f(0.6f, 0.3f, 0.0f);  // brown bench
+    // First bench
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(120, 50);
+    gfxVertex2f(250, 50);
+    gfxVertex2f(250, 90);
+    gfxVertex2f(120, 90);
+    gfxEnd();
+    // Second bench
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(260, 50);
+    gfxVertex2f(390, 50);
+    gfxVertex2f(390, 90);
+    gfxVertex2f(260, 90);
+    gfxEnd();
+}
+
+// Draw the teacher’s table.
+void drawTeacherTable() {
+    GFX_PROFILE_FUNCTION();
+    gfxColor3f(0.8f, 0.5f, 0.2f);  // table color
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(200, 120);
+    gfxVertex2f(300, 120);
+    gfxVertex2f(300, 170);
+    gfxVertex2f(200, 170);
+    gfxEnd();
+
+    // Table outline
+    gfxColor3f(0.0f, 0.0f, 0.0f);
+    gfxBegin(GL_LINE_LOOP);
+    gfxVertex2f(200, 120);
+    gfxVertex2f(300, 120);
+    gfxVertex2f(300, 170);
+    gfxVertex2f(200, 170);
+    gfxEnd();
+}
+
+// Draw a stickman representing the teacher.
+void drawTeacherStickman() {
+    GFX_PROFILE_FUNCTION();
+    // Head: circle centered at (250,190) with radius 10.
+    float cx = 250, cy = 190, r = 10;
+    gfxColor3f(0.0f, 0.0f, 0.0f);
+    const int segments = 20;
+    Point circle[segments];
+    tessellateCircle(cx, cy, r, segments, circle);
+    gfxBegin(GL_LINE_LOOP);
+    for (int i = 0; i < segments; i++)
+        gfxVertex2f(circle[i].x, circle[i].y);
+    gfxEnd();
+    // Body
+    gfxBegin(GL_LINES);
+    gfxVertex2f(cx, cy - r);
+    gfxVertex2f(cx, cy - r - 20);
+    gfxEnd();
+    // Arms
+    gfxBegin(GL_LINES);
+    gfxVertex2f(cx, cy - r - 5);
+    gfxVertex2f(cx - 10, cy - r - 15);
+    gfxVertex2f(cx, cy - r - 5);
+    gfxVertex2f(cx + 10, cy - r - 15);
+    gfxEnd();
+    // Legs
+    gfxBegin(GL_LINES);
+    gfxVertex2f(cx, cy - r - 20);
+    gfxVertex2f(cx - 10, cy - r - 30);
+    gfxVertex2f(cx, cy - r - 20);
+    gfxVertex2f(cx + 10, cy - r - 30);
+    gfxEnd();
+}
+
+// Draw a stickman representing a student.
+void drawStudentStickman() {
+    GFX_PROFILE_FUNCTION();
+    // Head: circle centered at (180,100) with radius 8.
+    float cx = 180, cy = 100, r = 8;
+    gfxColor3f(0.0f, 0.0f, 0.0f);
+    const int segments = 20;
+    Point circle[segments];
+    tessellateCircle(cx, cy, r, segments, circle);
+    gfxBegin(GL_LINE_LOOP);
+    for (int i = 0; i < segments; i++)
+        gfxVertex2f(circle[i].x, circle[i].y);
+    gfxEnd();
+    // Body
+    gfxBegin(GL_LINES);
+    gfxVertex2f(cx, cy - r);
+    gfxVertex2f(cx, cy - r - 15);
+    gfxEnd();
+    // Arms
+    gfxBegin(GL_LINES);
+    gfxVertex2f(cx, cy - r - 3);
+    gfxVertex2f(cx - 8, cy - r - 8);
+    gfxVertex2f(cx, cy - r - 3);
+    gfxVertex2f(cx + 8, cy - r - 8);
+    gfxEnd();
+    // Legs
+    gfxBegin(GL_LINES);
+    gfxVertex2f(cx, cy - r - 15);
+    gfxVertex2f(cx - 8, cy - r - 25);
+    gfxVertex2f(cx, cy - r - 15);
+    gfxVertex2f(cx + 8, cy - r - 25);
+    gfxEnd();
+}
+
+// Draw a small plant in a pot.
+void drawPlant() {
+    GFX_PROFILE_FUNCTION();
+    // Pot
+    gfxColor3f(0.8f, 0.4f, 0.0f);
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(420, 150);
+    gfxVertex2f(440, 150);
+    gfxVertex2f(440, 170);
+    gfxVertex2f(420, 170);
+    gfxEnd();
+    // Plant (a small green circle)
+    float cx = 430, cy = 180, r = 10;
+    gfxColor3f(0.0f, 0.8f, 0.0f);
+    const int segments = 20;
+    Point circle[segments];
+    tessellateCircle(cx, cy, r, segments, circle);
+    gfxBegin(GL_POLYGON);
+    for (int i = 0; i < segments; i++)
+        gfxVertex2f(circle[i].x, circle[i].y);
+    gfxEnd();
+}
+
+// Draw a door on the right side of the classroom.
+void drawDoor() {
+    GFX_PROFILE_FUNCTION();
+    gfxColor3f(0.5f, 0.35f, 0.05f);
+    gfxBegin(GL_POLYGON);
+    gfxVertex2f(450, 50);
+    gfxVertex2f(490, 50);
+    gfxVertex2f(490, 150);
+    gfxVertex2f(450, 150);
+    gfxEnd();
+
+    // Door frame
+    gfxColor3f(0.0f, 0.0f, 0.0f);
+    gfxBegin(GL_LINE_LOOP);
+    gfxVertex2f(450, 50);
+    gfxVertex2f(490, 50);
+    gfxVertex2f(490, 150);
+    gfxVertex2f(450, 150);
+    gfxEnd();
+}
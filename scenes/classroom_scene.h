@@ -0,0 +1,25 @@
+#pragma once
+// ---------------------------------------------------------------------
+// Classroom scene shared by classroom.CPP and textclip.cpp: the black
+// board, the clock clipped to it and the furniture. Each function draws
+// one element through the gfx* calls.
+// ---------------------------------------------------------------------
+
+// Board (clipping region) boundaries
+const float boardXmin = 100, boardXmax = 400;
+const float boardYmin = 300, boardYmax = 450;
+
+// Clipper for the clock: Cohen–Sutherland, or Liang–Barsky when set
+// (--liang-barsky, or press 'l' to switch)
+extern bool useLiangBarsky;
+
+void drawBlackBoard();
+void drawClippedClock();
+void drawFan();
+void drawWindow();
+void drawBenches();
+void drawTeacherTable();
+void drawTeacherStickman();
+void drawStudentStickman();
+void drawPlant();
+void drawDoor();
@@ -0,0 +1,77 @@
+#include <GL/glut.h>
+#include "gfx/gl_backend.h"
+#include "gfx/glut_loop.h"
+#include "gfx/headless.h"
+#include "gfx/profiler.h"
+#include "gfx/scene_file.h"
+#include <chrono>
+
+// -----------------------------
+// Scene file viewer
+// -----------------------------
+// Draws a binary scene file written by another demo's --save-scene, or
+// generated elsewhere, without any drawing code of its own:
+//
+//   ./playground --save-scene playground.gfxs
+//   ./sceneview --scene playground.gfxs [--headless out.ppm ...]
+//
+// The file is mapped, not read, and replayed in place every frame.
+MappedScene file;
+FrameLoop frameLoop;
+const char* windowTitle = "Scene File Viewer";
+
+void display() {
+    ProfileFrame frame;
+    {
+        GFX_PROFILE("scene file");
+        drawSceneFile(file);
+    }
+    drawProfileOverlay();
+    GFX_PROFILE("flush");
+    gfxFlush();
+}
+
+int main(int argc, char** argv) {
+    AppOptions options = parseAppOptions(argc, argv);
+    profiler.enabled = options.profile;
+    if (!options.scene) {
+        fprintf(stderr, "usage: %s --scene file.gfxs [options]\n", options.program);
+        return 1;
+    }
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    if (!file.open(options.scene)) {
+        fprintf(stderr, "%s: %s\n", options.scene, file.error());
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    printf("%s: %zu nodes, %zu vertices, %.1f MB mapped in %.3f ms\n", options.scene,
+        file.nodeCount(), file.vertexCount(), file.bytes() / 1048576.0, seconds * 1000.0);
+    if (options.headless) {
+        // Render on the CPU (white background) and write out an image
+        return runHeadless(options, display, 1.0f, 1.0f, 1.0f, &frameLoop);
+    }
+
+    configureSwapInterval(options.uncapped);
+    glutInit(&argc, argv);
+    // Double buffering and RGB color mode
+    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);
+    glutInitWindowSize(500, 500);
+    glutInitWindowPosition(100, 100);
+    glutCreateWindow(windowTitle);
+    GlBackend glBackend;
+    gfxUseBackend(&glBackend);
+
+    // White background, unless the file sets its own
+    gfxClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+    // 2D orthogonal projection
+    glMatrixMode(GL_PROJECTION);
+    gluOrtho2D(0, 500, 0, 500);
+
+    runGlutFrameLoop(frameLoop, display, windowTitle, options.uncapped, options.frameRate);
+    if (options.profile) {
+        profiler.overlay = true;
+        finishProfileAtExit(options.profileOut);
+    }
+    glutMainLoop();
+    return 0;
+}
@@ -0,0 +1,17 @@
+# Run PROGRAM with ARGS, appending to the perf log LOG, and fail unless
+# the row it logged counts some clip operations.
+#
+#   cmake -DPROGRAM=... -DARGS="..." -DLOG=... -P check_clip_ops.cmake
+file(REMOVE ${LOG})
+separate_arguments(args UNIX_COMMAND "${ARGS}")
+execute_process(COMMAND ${PROGRAM} ${args} --perf-log ${LOG} RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${PROGRAM} failed: ${result}")
+endif()
+file(STRINGS ${LOG} rows)
+list(GET rows -1 row)
+string(REGEX MATCH "[^,]+$" clip_ops "${row}")
+if(NOT clip_ops GREATER 0)
+    message(FATAL_ERROR "no clip operations logged: ${row}")
+endif()
+message(STATUS "${clip_ops} clip operations/s")
@@ -0,0 +1,171 @@
+#include "gfx/scene_file.h"
+#include "gfx/trace.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// -----------------------------
+// File corrupter for the tests
+// -----------------------------
+// Copies a scene file or trace with one field of its first matching call
+// set to value, so the tests can check that loading it fails with a
+// message:
+//
+//   ./corrupt_file in.gfxs out.gfxs ellipse-radius 1e9
+//   ./corrupt_file in.gfxt out.gfxt primitive-mode 99
+//
+// Fields: primitive-mode, primitive-vertex (x of its first vertex),
+// line-width, color (red), ellipse-mode, ellipse-radius and
+// ellipse-thickness. Values are numbers, nan or inf.
+//
+// No demo uses the scissor, so for scissor boxes it writes a file of its
+// own instead, one quad drawn with the scissor test on, as a scene file
+// or, given a .gfxt name, a trace:
+//
+//   ./corrupt_file --scissor out.gfxs x y width height
+std::vector<char> bytes;
+
+bool readFile(const char* path) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    fseek(f, 0, SEEK_END);
+    bytes.resize((size_t)ftell(f));
+    fseek(f, 0, SEEK_SET);
+    bool ok = fread(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    fclose(f);
+    return ok;
+}
+
+bool writeFile(const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    return fclose(f) == 0 && ok;
+}
+
+// The node the field belongs to, or null.
+SceneFileNode* findSceneNode(const char* field) {
+    if (bytes.size() < sizeof(SceneFileHeader)) return nullptr;
+    const SceneFileHeader* h = (const SceneFileHeader*)bytes.data();
+    if (h->nodes.offset + h->nodes.count * sizeof(SceneFileNode) > bytes.size()) return nullptr;
+    SceneFileNode* nodes = (SceneFileNode*)(bytes.data() + h->nodes.offset);
+    for (uint64_t i = 0; i < h->nodes.count; i++) {
+        uint8_t op = nodes[i].op;
+        if (strcmp(field, "line-width") == 0 || strcmp(field, "color") == 0 ||
+            (strncmp(field, "primitive", 9) == 0 && op == SCENE_PRIMITIVE) ||
+            (strncmp(field, "ellipse", 7) == 0 && op == SCENE_ELLIPSE))
+            return &nodes[i];
+    }
+    return nullptr;
+}
+
+bool corruptScene(const char* field, double value) {
+    SceneFileNode* n = findSceneNode(field);
+    if (!n) return false;
+    if (strcmp(field, "primitive-mode") == 0) n->mode = (uint32_t)value;
+    else if (strcmp(field, "primitive-vertex") == 0) {
+        const SceneFileHeader* h = (const SceneFileHeader*)bytes.data();
+        if (h->vertices.offset + (n->first + 1) * sizeof(Point) > bytes.size()) return false;
+        ((Point*)(bytes.data() + h->vertices.offset))[n->first].x = (float)value;
+    }
+    else if (strcmp(field, "line-width") == 0) n->lineWidth = (float)value;
+    else if (strcmp(field, "color") == 0) n->color[0] = (float)value;
+    else if (strcmp(field, "ellipse-mode") == 0) n->ellipseMode = (uint8_t)value;
+    else if (strcmp(field, "ellipse-radius") == 0) n->radii[0] = (float)value;
+    else if (strcmp(field, "ellipse-thickness") == 0) n->thickness = (float)value;
+    else return false;
+    return true;
+}
+
+// The payload of the first trace record the field belongs to, or null.
+uint32_t* findTraceRecord(const char* field) {
+    uint32_t op = strcmp(field, "line-width") == 0 ? TRACE_LINE_WIDTH :
+        strcmp(field, "color") == 0 ? TRACE_COLOR :
+        strncmp(field, "primitive", 9) == 0 ? TRACE_PRIMITIVE : TRACE_ELLIPSE;
+    uint32_t* w = (uint32_t*)(bytes.data() + sizeof(TraceFileHeader));
+    uint32_t* end = (uint32_t*)(bytes.data() + bytes.size());
+    while (w < end) {
+        if ((w[0] & 0xff) == op) return w;
+        w += traceRecordWords(w);
+    }
+    return nullptr;
+}
+
+bool corruptTrace(const char* field, double value) {
+    if (bytes.size() < sizeof(TraceFileHeader)) return false;
+    uint32_t* w = findTraceRecord(field);
+    if (!w) return false;
+    float* f = (float*)(w + 1);
+    if (strcmp(field, "primitive-mode") == 0) w[0] = (w[0] & 0xff) | (uint32_t)value << 8;
+    else if (strcmp(field, "primitive-vertex") == 0 && w[1] > 0) f[1] = (float)value;
+    else if (strcmp(field, "line-width") == 0 || strcmp(field, "color") == 0) f[0] = (float)value;
+    else if (strcmp(field, "ellipse-mode") == 0) w[0] = (w[0] & ~0xff00u) | ((uint32_t)value & 0xff) << 8;
+    else if (strcmp(field, "ellipse-radius") == 0) f[2] = (float)value;
+    else if (strcmp(field, "ellipse-thickness") == 0) f[4] = (float)value;
+    else return false;
+    return true;
+}
+
+int scissorBox[4];
+
+void drawScissoredQuad() {
+    gfxEnable(GL_SCISSOR_TEST);
+    gfxScissor(scissorBox[0], scissorBox[1], scissorBox[2], scissorBox[3]);
+    gfxBegin(GL_QUADS);
+    gfxVertex2f(100, 100);
+    gfxVertex2f(400, 100);
+    gfxVertex2f(400, 400);
+    gfxVertex2f(100, 400);
+    gfxEnd();
+}
+
+bool writeScissored(const char* path) {
+    const char* dot = strrchr(path, '.');
+    if (dot && strcmp(dot, ".gfxt") == 0) {
+        TraceRecorder trace;
+        if (!trace.open(path, nullptr)) return false;
+        RenderBackend* previous = gfx.backend;
+        gfxUseBackend(&trace);
+        drawScissoredQuad();
+        gfxUseBackend(previous);
+        return trace.close();
+    }
+    Scene scene;
+    recordScene(scene, drawScissoredQuad);
+    return writeSceneFile(scene, path);
+}
+
+int main(int argc, char** argv) {
+    if (argc == 7 && strcmp(argv[1], "--scissor") == 0) {
+        for (int i = 0; i < 4; i++)
+            scissorBox[i] = (int)strtol(argv[3 + i], nullptr, 10);
+        if (!writeScissored(argv[2])) {
+            fprintf(stderr, "could not write %s\n", argv[2]);
+            return 1;
+        }
+        return 0;
+    }
+    if (argc != 5) {
+        fprintf(stderr, "usage: %s in out field value\n       %s --scissor out x y width height\n",
+            argv[0], argv[0]);
+        return 1;
+    }
+    if (!readFile(argv[1])) {
+        fprintf(stderr, "cannot read %s\n", argv[1]);
+        return 1;
+    }
+    double value = strtod(argv[4], nullptr);
+    bool scene = bytes.size() >= 4 && memcmp(bytes.data(), "GFXS", 4) == 0;
+    bool trace = bytes.size() >= 4 && memcmp(bytes.data(), "GFXT", 4) == 0;
+    if (!(scene && corruptScene(argv[3], value)) && !(trace && corruptTrace(argv[3], value))) {
+        fprintf(stderr, "%s: no %s to corrupt\n", argv[1], argv[3]);
+        return 1;
+    }
+    if (!writeFile(argv[2])) {
+        fprintf(stderr, "could not write %s\n", argv[2]);
+        return 1;
+    }
+    return 0;
+}
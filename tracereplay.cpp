@@ -0,0 +1,221 @@
+#include <GL/glut.h>
+#include "gfx/gl_backend.h"
+#include "gfx/glut_loop.h"
+#include "gfx/headless.h"
+#include "gfx/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+// -----------------------------
+// Trace replayer
+// -----------------------------
+// Replays a draw-call trace written by another program's --save-trace,
+// or sent in from elsewhere, as fast as the backend allows, and reports
+// the time of every frame and of every kind of call:
+//
+//   ./playground --headless out.ppm --repeat 120 --save-trace playground.gfxt
+//   ./tracereplay --trace playground.gfxt --headless replay.ppm [--repeat N]
+//   ./tracereplay --trace playground.gfxt          (in a window, on GL)
+//
+// Headless, the trace is replayed on the CPU backend the options select
+// and the last frame is written out, so --compare checks it against the
+// original program's image. --repeat N replays the whole trace N times.
+// The tiled backend and GL defer the pixel work to the flush, so their
+// per-call times are submission costs; use --untiled to see each call's
+// raster cost.
+typedef std::chrono::steady_clock Clock;
+
+TraceFile trace;
+AppOptions options;
+
+// Time of each call kind: the GL mode for primitives, the op otherwise.
+struct CallStats {
+    long calls = 0;
+    long items = 0;         // vertices or glyphs
+    double seconds = 0;
+};
+
+struct SlowCall {
+    double seconds;
+    int frame;
+    long record;
+    TraceCall call;
+};
+
+std::vector<double> frameSeconds;
+CallStats opStats[TRACE_OP_COUNT];
+CallStats modeStats[GL_POLYGON + 1];
+CallStats frameEndStats;
+std::vector<SlowCall> slowest;
+const int SLOWEST = 8;
+
+const char* opName(TraceOp op) {
+    static const char* names[TRACE_OP_COUNT] = { "", "clear color", "clear", "color",
+        "line width", "scissor on/off", "scissor", "primitive", "ellipse", "raster pos",
+        "bitmap char", "text", "flush", "damage", "frame end" };
+    return op > 0 && op < TRACE_OP_COUNT ? names[op] : "?";
+}
+
+const char* modeName(GLenum mode) {
+    static const char* names[GL_POLYGON + 1] = { "GL_POINTS", "GL_LINES", "GL_LINE_LOOP",
+        "GL_LINE_STRIP", "GL_TRIANGLES", "GL_TRIANGLE_STRIP", "GL_TRIANGLE_FAN", "GL_QUADS",
+        "GL_QUAD_STRIP", "GL_POLYGON" };
+    return mode <= GL_POLYGON ? names[mode] : "?";
+}
+
+std::string callName(const TraceCall& call) {
+    if (call.op == TRACE_PRIMITIVE) return modeName(call.mode);
+    return opName(call.op);
+}
+
+// Replay frame f on the current backend, timing each call. frameEnd
+// finishes the frame: flushes deferred work, or waits for GL.
+void replayFrame(int f, void (*frameEnd)()) {
+    Clock::time_point start = Clock::now(), t0 = start;
+    TraceCursor cursor = trace.frameStart(f);
+    size_t end = trace.frameEnd(f);
+    long record = 0;
+    while (cursor.word < end) {
+        TraceCall call = trace.play(cursor);
+        Clock::time_point t1 = Clock::now();
+        double s = std::chrono::duration<double>(t1 - t0).count();
+        t0 = t1;
+        if (call.op == TRACE_FRAME) continue;
+        CallStats& stats = call.op == TRACE_PRIMITIVE && call.mode <= GL_POLYGON ?
+            modeStats[call.mode] : opStats[call.op];
+        stats.calls++;
+        stats.items += call.count;
+        stats.seconds += s;
+        if ((int)slowest.size() < SLOWEST || s > slowest.back().seconds) {
+            SlowCall slow = { s, f, record, call };
+            slowest.insert(std::upper_bound(slowest.begin(), slowest.end(), slow,
+                [](const SlowCall& a, const SlowCall& b) { return a.seconds > b.seconds; }), slow);
+            if ((int)slowest.size() > SLOWEST) slowest.pop_back();
+        }
+        record++;
+    }
+    frameEnd();
+    Clock::time_point t1 = Clock::now();
+    frameEndStats.calls++;
+    frameEndStats.seconds += std::chrono::duration<double>(t1 - t0).count();
+    frameSeconds.push_back(std::chrono::duration<double>(t1 - start).count());
+}
+
+void printReport(const char* backendKind) {
+    std::vector<double> sorted = frameSeconds;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0;
+    for (double s : frameSeconds) total += s;
+    auto percentile = [&sorted](double p) { return sorted[(size_t)(p * (sorted.size() - 1))] * 1e3; };
+    int worst = (int)(std::max_element(frameSeconds.begin(), frameSeconds.end()) - frameSeconds.begin());
+    printf("%s: %zu frames replayed on %s, %.3f ms (%.1f fps)\n", options.trace, sorted.size(),
+        backendKind, total * 1e3, sorted.size() / total);
+    printf("  frame ms: mean %.3f  p50 %.3f  p99 %.3f  max %.3f (frame %d)\n",
+        total * 1e3 / sorted.size(), percentile(0.5), percentile(0.99), sorted.back() * 1e3,
+        worst % trace.frameCount());
+
+    printf("  %-16s %9s %11s %11s %10s %7s\n", "call", "calls", "items", "total ms", "mean us", "share");
+    auto row = [total](const char* name, const CallStats& s) {
+        if (s.calls == 0) return;
+        printf("  %-16s %9ld %11ld %11.3f %10.3f %6.1f%%\n", name, s.calls, s.items,
+            s.seconds * 1e3, s.seconds * 1e6 / s.calls, 100.0 * s.seconds / total);
+    };
+    for (int m = 0; m <= GL_POLYGON; m++)
+        row(modeName(m), modeStats[m]);
+    for (int op = TRACE_CLEAR_COLOR; op < TRACE_OP_COUNT; op++)
+        if (op != TRACE_PRIMITIVE && op != TRACE_FRAME)
+            row(opName((TraceOp)op), opStats[op]);
+    row("frame end", frameEndStats);
+
+    printf("  slowest calls:\n");
+    for (const SlowCall& s : slowest)
+        printf("    %9.3f us  frame %d, call %ld: %s (%d)\n", s.seconds * 1e6,
+            s.frame, s.record, callName(s.call).c_str(), s.call.count);
+}
+
+// -----------------------------
+// Windowed replay on GL
+// -----------------------------
+int glFrame = 0;
+
+void glFrameEnd() { glFinish(); }
+
+void display() {
+    int passes = trace.frameCount() * options.repeat;
+    replayFrame(glFrame % trace.frameCount(), glFrameEnd);
+    if (++glFrame == passes) {
+        printReport("GL");
+        exit(0);
+    }
+}
+
+RenderBackend* headlessBackend = nullptr;
+
+void headlessFrameEnd() { headlessBackend->flush(); }
+
+int main(int argc, char** argv) {
+    options = parseAppOptions(argc, argv);
+    if (!options.trace) {
+        fprintf(stderr, "usage: %s --trace file.gfxt [options]\n", options.program);
+        return 1;
+    }
+    Clock::time_point t0 = Clock::now();
+    if (!trace.open(options.trace)) {
+        fprintf(stderr, "%s: %s\n", options.trace, trace.error());
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+    printf("%s: %d frames, %llu calls, %.1f MB read in %.3f ms\n", options.trace,
+        trace.frameCount(), (unsigned long long)trace.recordCount(), trace.bytes() / 1048576.0,
+        seconds * 1000.0);
+    if (trace.frameCount() == 0)
+        return 0;
+
+    if (options.headless) {
+        char kind[32];
+        int threads;
+        std::unique_ptr<SoftwareBackend> backend(createHeadlessBackend(options, kind, &threads));
+        headlessBackend = backend.get();
+        gfxUseBackend(backend.get());
+        for (int pass = 0; pass < options.repeat; pass++)
+            for (int f = 0; f < trace.frameCount(); f++)
+                replayFrame(f, headlessFrameEnd);
+        printReport(kind);
+        if (options.perfLog) {
+            // Logged under the trace's name, with every replayed frame.
+            AppOptions logged = options;
+            const char* slash = strrchr(options.trace, '/');
+            logged.program = slash ? slash + 1 : options.trace;
+            logged.repeat = (int)frameSeconds.size();
+            double total = 0;
+            for (double s : frameSeconds) total += s;
+            if (!appendPerfLog(logged, kind, threads, total, 0))
+                fprintf(stderr, "could not write %s\n", options.perfLog);
+        }
+        bool ok = backend->writeImage(options.output);
+        gfxUseBackend(nullptr);
+        if (!ok)
+            fprintf(stderr, "could not write %s\n", options.output);
+        if (ok && options.compare)
+            ok = matchesReference(backend->framebuffer(), options);
+        return ok ? 0 : 1;
+    }
+
+    configureSwapInterval(true);
+    glutInit(&argc, argv);
+    glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB);
+    glutInitWindowSize(500, 500);
+    glutInitWindowPosition(100, 100);
+    glutCreateWindow("Trace Replay");
+    GlBackend glBackend;
+    gfxUseBackend(&glBackend);
+    glMatrixMode(GL_PROJECTION);
+    gluOrtho2D(0, 500, 0, 500);
+    glutDisplayFunc(display);
+    glutIdleFunc(glutPostRedisplay);
+    glutMainLoop();
+    return 0;
+}